@@ -0,0 +1,199 @@
+/**
+ * @file cc_check.c
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Checks the contract of libcaesarcrack that a corpus run through cc_host does not reach:
+ *        in every mode, with and without CC_KEEP_LAYOUT, a message decrypted in place matches
+ *        the same message decrypted into its own buffer; a plaintext or key buffer one byte
+ *        short fails with CC_ERROR_BUFFER_TOO_SMALL, reports the size needed and leaves the
+ *        buffers alone; and bad arguments are refused. Prints each failed check and exits 1 if
+ *        there were any.
+ *
+ *        Usage: cc_check
+ *
+ * @see caesarcrack.h
+ *
+ */
+
+#include "caesarcrack.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Bytes of the buffers each check works in; more than any result of SAMPLE_CIPHERTEXT */
+#define CHECK_BUFFER_SIZE 1024
+
+/* Byte the buffers are filled with, to see whether a failed call wrote to them */
+#define GUARD_BYTE '#'
+
+/* A Vigenere ciphertext in mixed case with punctuation, long enough for every mode to crack */
+static const char SAMPLE_CIPHERTEXT[] =
+    "Dhvo hyl eewscvpv xoj ht cbgk wlrdsu pn yjg yhnut vv kiu ock vpvo wk ht foqv. Oe tbfipeu "
+    "jh yvmv jb koe zogzke gpqblt fg vzz cfbh, tsojf hf oij dvvzt, ror jlt zu ce ahv lwkjhvo "
+    "hrilv xvzse yf arke r qck vf kfo.";
+
+/* Number of checks run and failed */
+static unsigned int checks = 0;
+static unsigned int failures = 0;
+
+
+/**
+ * @fn expect
+ *
+ * @param ok: Whether the check passed.
+ * @param mode: Mode the check ran in.
+ * @param flags: Engine flags the check ran with.
+ * @param what: What was checked.
+ *
+ */
+static void expect (int ok, int mode, unsigned int flags, const char* what)
+{
+    checks++;
+    if (!ok)
+    {
+        failures++;
+        fprintf (stderr, "Mode %d, flags %u: %s\n", mode, flags, what);
+    }
+}
+
+/**
+ * @fn untouched
+ *
+ * @param buffer: Buffer filled with GUARD_BYTE before the call.
+ * @param size: Number of bytes to look at.
+ * @return 1 if none of them was written.
+ *
+ */
+static int untouched (const char* buffer, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (buffer[i] != GUARD_BYTE)
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @fn check_mode
+ *
+ * @param mode: One of the CC_MODE constants.
+ * @param flags: CC_KEEP_LAYOUT or 0.
+ *
+ * @brief Cracks SAMPLE_CIPHERTEXT into its own buffer first, then checks every other path
+ *        against that result.
+ *
+ */
+static void check_mode (int mode, unsigned int flags)
+{
+    cc_engine* engine = cc_engine_create (mode, flags, 2);
+    expect (engine != NULL, mode, flags, "engine could not be created");
+    if (engine == NULL)
+        return;
+
+    size_t length = sizeof (SAMPLE_CIPHERTEXT) - 1;
+    char plaintext[CHECK_BUFFER_SIZE], key[CHECK_BUFFER_SIZE];
+    char buffer[CHECK_BUFFER_SIZE], key_buffer[CHECK_BUFFER_SIZE];
+
+    cc_message message = { SAMPLE_CIPHERTEXT, length, plaintext, length, key, sizeof (key),
+                           0, 0, 0, 0 };
+    int status = cc_crack (engine, &message);
+    expect ((status == CC_OK) && (message.status == CC_OK), mode, flags, "crack failed");
+    size_t plaintext_length = (size_t)message.plaintext_length;
+    size_t key_length = (size_t)message.key_length;
+    expect ((key_length > 0) && (key[key_length] == '\0'), mode, flags, "key not terminated");
+
+    /* In place: the plaintext overwrites the ciphertext it is decrypted from */
+    memcpy (buffer, SAMPLE_CIPHERTEXT, length);
+    cc_message in_place = { buffer, length, buffer, length, key_buffer, sizeof (key_buffer),
+                            0, 0, 0, 0 };
+    status = cc_crack (engine, &in_place);
+    expect ((status == CC_OK) && (in_place.plaintext_length == plaintext_length) &&
+            (memcmp (buffer, plaintext, plaintext_length) == 0), mode, flags,
+            "in-place plaintext differs");
+    expect ((in_place.key_length == key_length) && (memcmp (key_buffer, key, key_length) == 0),
+            mode, flags, "in-place key differs");
+
+    /* A plaintext buffer one byte short is refused before anything is written to it */
+    memset (buffer, GUARD_BYTE, sizeof (buffer));
+    memset (key_buffer, GUARD_BYTE, sizeof (key_buffer));
+    cc_message short_plaintext = { SAMPLE_CIPHERTEXT, length, buffer, plaintext_length - 1,
+                                   key_buffer, sizeof (key_buffer), 0, 0, 0, 0 };
+    status = cc_crack (engine, &short_plaintext);
+    expect ((status == CC_ERROR_BUFFER_TOO_SMALL) &&
+            (short_plaintext.plaintext_length == plaintext_length), mode, flags,
+            "short plaintext buffer not reported");
+    expect (untouched (buffer, sizeof (buffer)), mode, flags, "short plaintext buffer written");
+
+    /* So is a key buffer one byte short, and the plaintext is left alone with it */
+    memset (key_buffer, GUARD_BYTE, sizeof (key_buffer));
+    cc_message short_key = { SAMPLE_CIPHERTEXT, length, buffer, length, key_buffer,
+                             key_length - 1, 0, 0, 0, 0 };
+    status = cc_crack (engine, &short_key);
+    expect ((status == CC_ERROR_BUFFER_TOO_SMALL) && (short_key.key_length == key_length),
+            mode, flags, "short key buffer not reported");
+    expect (untouched (buffer, sizeof (buffer)) && untouched (key_buffer, sizeof (key_buffer)),
+            mode, flags, "short key buffer written");
+
+    /* Buffers of exactly the sizes reported suffice, the key then without its NUL */
+    cc_message exact = { SAMPLE_CIPHERTEXT, length, buffer, plaintext_length, key_buffer,
+                         key_length, 0, 0, 0, 0 };
+    status = cc_crack (engine, &exact);
+    expect ((status == CC_OK) && (memcmp (buffer, plaintext, plaintext_length) == 0) &&
+            (buffer[plaintext_length] == GUARD_BYTE) && (key_buffer[key_length] == GUARD_BYTE),
+            mode, flags, "exact buffers not filled exactly");
+
+    /*
+     * In a batch, the failed message is counted and the others are cracked all the same. The
+     * messages are cracked at once, so no two of them share a key buffer
+     */
+    cc_message batch[3] = { message, short_plaintext, message };
+    batch[1].key = key_buffer + CHECK_BUFFER_SIZE / 2;
+    batch[1].key_capacity = CHECK_BUFFER_SIZE / 2;
+    batch[2].plaintext = buffer;
+    batch[2].key = key_buffer;
+    batch[2].key_capacity = CHECK_BUFFER_SIZE / 2;
+    size_t failed = cc_crack_batch (engine, batch, 3);
+    expect ((failed == 1) && (batch[0].status == CC_OK) &&
+            (batch[1].status == CC_ERROR_BUFFER_TOO_SMALL) && (batch[2].status == CC_OK) &&
+            (memcmp (buffer, plaintext, plaintext_length) == 0), mode, flags,
+            "batch statuses wrong");
+
+    /* A message with no buffer behind a nonzero length is refused */
+    cc_message missing = { NULL, length, buffer, length, key_buffer, sizeof (key_buffer),
+                           0, 0, 0, 0 };
+    expect (cc_crack (engine, &missing) == CC_ERROR_ARGUMENT, mode, flags,
+            "missing ciphertext accepted");
+
+    cc_engine_destroy (engine);
+}
+
+
+int main (int argc, char** argv)
+{
+    (void)argv;
+    if (argc > 1)
+    {
+        fprintf (stderr, "Usage: cc_check\n");
+        return 1;
+    }
+
+    expect ((cc_api_version() == CC_API_VERSION) && (cc_message_size() == sizeof (cc_message)),
+            -1, 0, "library built from another header");
+    expect (cc_engine_create (CC_MODE_SUBSTITUTION + 1, 0, 1) == NULL, -1, 0,
+            "unknown mode accepted");
+    expect (cc_engine_create (CC_MODE_CAESAR, ~CC_KEEP_LAYOUT, 1) == NULL, -1, 0,
+            "unknown flag accepted");
+    expect (cc_crack (NULL, NULL) == CC_ERROR_ARGUMENT, -1, 0, "missing engine accepted");
+
+    for (int mode = CC_MODE_CAESAR; mode <= CC_MODE_SUBSTITUTION; mode++)
+    {
+        check_mode (mode, 0);
+        check_mode (mode, CC_KEEP_LAYOUT);
+    }
+
+    printf ("Checks: %u, %u failed\n", checks, failures);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file cc_host.c
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief An example host of libcaesarcrack in plain C. It reads a corpus with one ciphertext per
+ *        line, cracks every line in one batch call and prints "<key>\t<plaintext>" lines, as
+ *        `decrypt batch` does. The corpus is read into one buffer and the plaintext written into
+ *        another of the same size, or with --in-place back into the corpus; the library copies
+ *        neither.
+ *
+ *        Usage: cc_host <caesar|vigenere|substitution> [corpus|-] [--keep-layout] [--in-place]
+ *                       [--threads N]
+ *
+ * @see caesarcrack.h
+ *
+ */
+
+#include "caesarcrack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bytes of key buffer per message; enough for a substitution key and its NUL */
+#define HOST_KEY_CAPACITY 64
+
+
+/**
+ * @fn read_all
+ *
+ * @param in: Stream to be read to its end.
+ * @param size: Receives the number of bytes read.
+ * @return The bytes read, or NULL if memory ran out.
+ *
+ */
+static char* read_all (FILE* in, size_t* size)
+{
+    size_t capacity = 1 << 16;
+    char* data = malloc (capacity);
+    *size = 0;
+
+    while (data != NULL)
+    {
+        *size += fread (data + *size, 1, capacity - *size, in);
+        if (*size < capacity)
+            break;
+
+        char* grown = realloc (data, capacity * 2);
+        if (grown == NULL)
+            free (data);
+        data = grown;
+        capacity *= 2;
+    }
+    return data;
+}
+
+/**
+ * @fn parse_mode
+ *
+ * @param name: Mode named on the command line.
+ * @return Its CC_MODE constant, or -1 for an unknown name.
+ *
+ */
+static int parse_mode (const char* name)
+{
+    if (strcmp (name, "caesar") == 0)
+        return CC_MODE_CAESAR;
+    if (strcmp (name, "vigenere") == 0)
+        return CC_MODE_VIGENERE;
+    if (strcmp (name, "substitution") == 0)
+        return CC_MODE_SUBSTITUTION;
+    return -1;
+}
+
+int main (int argc, char** argv)
+{
+    /* A library built from another header would read these structs wrongly; refuse to run */
+    if ((cc_api_version() != CC_API_VERSION) || (cc_message_size() != sizeof (cc_message)))
+    {
+        fprintf (stderr, "libcaesarcrack has interface %d, %zu-byte messages; expected %d, %zu\n",
+                 cc_api_version(), cc_message_size(), CC_API_VERSION, sizeof (cc_message));
+        return 1;
+    }
+
+    int mode = (argc > 1) ? parse_mode (argv[1]) : -1;
+    const char* path = "-";
+    unsigned int flags = 0;
+    unsigned int threads = 0;
+    int in_place = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp (argv[i], "--keep-layout") == 0)
+            flags |= CC_KEEP_LAYOUT;
+        else if (strcmp (argv[i], "--in-place") == 0)
+            in_place = 1;
+        else if ((strcmp (argv[i], "--threads") == 0) && (i + 1 < argc))
+            threads = (unsigned int)strtoul (argv[++i], NULL, 10);
+        else
+            path = argv[i];
+    }
+    if (mode < 0)
+    {
+        fprintf (stderr, "Usage: %s <caesar|vigenere|substitution> [corpus|-] [--keep-layout] "
+                 "[--in-place] [--threads N]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = (strcmp (path, "-") == 0) ? stdin : fopen (path, "rb");
+    if (in == NULL)
+    {
+        fprintf (stderr, "Could not open %s\n", path);
+        return 1;
+    }
+    size_t size = 0;
+    char* corpus = read_all (in, &size);
+    if (in != stdin)
+        fclose (in);
+
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++)
+        count += (corpus[i] == '\n');
+    if ((size > 0) && (corpus[size - 1] != '\n'))
+        count++;
+
+    char* plaintext = malloc (size + 1);
+    char* keys = malloc (count * HOST_KEY_CAPACITY + 1);
+    cc_message* messages = calloc (count + 1, sizeof (cc_message));
+    cc_engine* engine = cc_engine_create (mode, flags, threads);
+    if ((corpus == NULL) || (plaintext == NULL) || (keys == NULL) || (messages == NULL) ||
+        (engine == NULL))
+    {
+        fprintf (stderr, "Could not set up the engine\n");
+        return 1;
+    }
+
+    /*
+     * Every message points into the corpus, and its plaintext into the same span of the output,
+     * or of the corpus itself. A CR before the line break is not part of the message
+     */
+    char* output = in_place ? corpus : plaintext;
+    size_t start = 0;
+    for (size_t m = 0; m < count; m++)
+    {
+        size_t end = start, next = 0;
+        while ((end < size) && (corpus[end] != '\n'))
+            end++;
+        next = end + 1;
+        if ((end > start) && (corpus[end - 1] == '\r'))
+            end--;
+
+        messages[m].ciphertext = corpus + start;
+        messages[m].ciphertext_length = end - start;
+        messages[m].plaintext = output + start;
+        messages[m].plaintext_capacity = end - start;
+        messages[m].key = keys + m * HOST_KEY_CAPACITY;
+        messages[m].key_capacity = HOST_KEY_CAPACITY;
+        start = next;
+    }
+
+    /* Empty lines are echoed as they are, as decrypt batch does */
+    size_t failed = cc_crack_batch (engine, messages, count);
+    for (size_t m = 0; m < count; m++)
+    {
+        if (messages[m].ciphertext_length == 0)
+        {
+            putchar ('\n');
+            continue;
+        }
+
+        if (messages[m].status == CC_OK)
+            fwrite (messages[m].key, 1, messages[m].key_length, stdout);
+        putchar ('\t');
+        if (messages[m].status == CC_OK)
+            fwrite (messages[m].plaintext, 1, messages[m].plaintext_length, stdout);
+        putchar ('\n');
+    }
+    fprintf (stderr, "Messages: %zu, %zu failed\n", count, failed);
+
+    cc_engine_destroy (engine);
+    free (messages);
+    free (keys);
+    free (plaintext);
+    free (corpus);
+    return (failed == 0) ? 0 : 1;
+}
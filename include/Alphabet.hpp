@@ -0,0 +1,457 @@
+/**
+ * @file Alphabet.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains the alphabet policies StringAnalysis and DecryptEngine are templated over, and
+ *        the compile-time tables behind them.
+ *
+ *        A policy names the symbols a shift cipher rotates and the reference frequencies of the
+ *        plaintext, and provides the kernels that depend on them. Every table is built by
+ *        constexpr functions, so each alphabet gets kernels whose sizes are constants and whose
+ *        per-byte work is a single table lookup or subtraction; bytes that are not symbols of the
+ *        alphabet map to themselves and pass through untouched.
+ *
+ *        To add an alphabet, define its policy (CustomAlphabet does most of the work) and add it
+ *        to FOR_EACH_EXTRA_ALPHABET so the engine is compiled for it.
+ *
+ */
+
+#ifndef ALPHABET_HPP
+#define ALPHABET_HPP
+
+#include "DecryptKernels.hpp"
+#include "Histogram.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+// Frequencies of each letter of the alphabet (ignoring case)
+constexpr double ALPHABET_FREQUENCIES[26] = { 0.080, 0.015, 0.030, 0.040, 0.130, 0.020, 0.015, 0.060,
+                                        0.065, 0.005, 0.005, 0.035, 0.030, 0.070, 0.080, 0.020,
+                                        0.002, 0.065, 0.060, 0.090, 0.030, 0.010, 0.015, 0.005,
+                                        0.020, 0.002};
+
+/*
+ * Shares of English prose taken by spaces, lowercase letters, uppercase letters and the two
+ * commonest punctuation marks; used to spread the letter frequencies over whole bytes
+ */
+const double PROSE_SPACE_SHARE = 0.17;
+const double PROSE_LOWER_SHARE = 0.77;
+const double PROSE_UPPER_SHARE = 0.04;
+const double PROSE_PUNCTUATION_SHARE = 0.01;
+
+
+/**
+ * @struct AlphabetTable
+ *
+ * @brief The compile-time tables of an alphabet of N symbols.
+ *          bins: the symbol number of each byte, or N if the byte is not a symbol; doubles as
+ *          the bin the byte is counted in, with bin N collecting everything else.
+ *          symbols: the byte standing for each symbol in keys, i.e. the first block.
+ *
+ */
+template <std::size_t N>
+struct AlphabetTable {
+    std::array <std::uint16_t, BYTE_BINS> bins;
+    std::array <unsigned char, N> symbols;
+};
+
+/*
+ * shifts[k][b] is byte b decrypted under shift k. A symbol moves back k places within its own
+ * block, so case is kept; any other byte maps to itself
+ */
+template <std::size_t N>
+using ShiftTable = std::array <std::array <unsigned char, BYTE_BINS>, N>;
+
+
+/**
+ * @fn symbol_block
+ *
+ * @param symbols: String literal holding the N symbols of a block in order.
+ * @return The block as an array of bytes.
+ *
+ */
+template <std::size_t L>
+constexpr std::array <unsigned char, L - 1> symbol_block (const char (&symbols)[L])
+{
+    std::array <unsigned char, L - 1> block {};
+    for (std::size_t i = 0; i + 1 < L; i++)
+        block[i] = (unsigned char)symbols[i];
+
+    return block;
+}
+
+/**
+ * @fn build_alphabet_table
+ *
+ * @param blocks: B blocks of N symbols each. Symbol i of every block is the same symbol, e.g.
+ *                'A' and 'a'; a byte may appear in only one block.
+ * @return The bins and symbols of the alphabet; usable at compile time.
+ *
+ */
+template <std::size_t N, std::size_t B>
+constexpr AlphabetTable <N> build_alphabet_table (
+    const std::array <std::array <unsigned char, N>, B>& blocks)
+{
+    AlphabetTable <N> table {};
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+        table.bins[b] = N;
+
+    for (std::size_t k = 0; k < B; k++)
+    {
+        for (unsigned int i = 0; i < N; i++)
+            table.bins[blocks[k][i]] = i;
+    }
+    table.symbols = blocks[0];
+
+    return table;
+}
+
+/**
+ * @fn build_shift_table
+ *
+ * @param blocks: The blocks passed to build_alphabet_table.
+ * @return The ShiftTable of the alphabet; usable at compile time.
+ *
+ */
+template <std::size_t N, std::size_t B>
+constexpr ShiftTable <N> build_shift_table (
+    const std::array <std::array <unsigned char, N>, B>& blocks)
+{
+    ShiftTable <N> shifts {};
+    for (unsigned int shift = 0; shift < N; shift++)
+    {
+        for (unsigned int b = 0; b < BYTE_BINS; b++)
+            shifts[shift][b] = (unsigned char)b;
+
+        for (std::size_t k = 0; k < B; k++)
+        {
+            for (unsigned int i = 0; i < N; i++)
+                shifts[shift][blocks[k][i]] = blocks[k][(i + N - shift) % N];
+        }
+    }
+
+    return shifts;
+}
+
+/**
+ * @fn decrypt_with_table
+ *
+ * @param shifts: Shift table of the alphabet.
+ * @param in: Ciphertext bytes.
+ * @param out: Receives len bytes; may be the same buffer as in.
+ * @param len: Number of bytes in in.
+ * @param shift: The shift being undone, less than N.
+ *
+ * @brief The generic shift kernel: one lookup per byte, with no branches.
+ *
+ */
+template <std::size_t N>
+inline void decrypt_with_table (const ShiftTable <N>& shifts, const char* in, char* out,
+                                std::size_t len, unsigned int shift)
+{
+    const unsigned char* row = shifts[shift].data();
+    for (std::size_t i = 0; i < len; i++)
+        out[i] = (char)row[(unsigned char)in[i]];
+}
+
+/**
+ * @fn fold_symbol_counts
+ *
+ * @param table: Tables of the alphabet.
+ * @param histogram: Byte counts of some text.
+ * @param counts: Array of N + 1 receiving the count of each symbol; the last bin receives the
+ *                bytes that are not symbols.
+ *
+ */
+template <std::size_t N>
+inline void fold_symbol_counts (const AlphabetTable <N>& table, const Histogram& histogram,
+                                std::uint64_t* counts)
+{
+    for (unsigned int i = 0; i <= N; i++)
+        counts[i] = 0;
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+        counts[table.bins[b]] += histogram.get_byte_counts()[b];
+}
+
+/**
+ * @fn correlate_shifts
+ *
+ * @param reference: Reference frequency of each of the N symbols.
+ * @param counts: Count of each symbol in the ciphertext.
+ * @param scale: Factor applied to every correlation, e.g. 1 / text length.
+ * @param correlations: Array of N receiving the correlation frequency of each shift.
+ * @return The shift with the highest correlation frequency.
+ *
+ * @brief The generic form of DecryptEngine::calc_column_correlations: PHI(k) = SIGMA(e) f(e)
+ *        * ref(e - k). Each ciphertext symbol adds a contiguous run of a doubled copy of the
+ *        reference, so the inner loop has no modulo and vectorizes.
+ *
+ */
+template <std::size_t N>
+inline unsigned int correlate_shifts (const std::array <double, N>& reference,
+                                      const std::uint64_t* counts, double scale,
+                                      double* correlations)
+{
+    // reversed[j] = ref(-j mod N), repeated twice so ref(e - k) = reversed[N - e + k]
+    std::array <double, 2 * N> reversed {};
+    for (unsigned int j = 0; j < 2 * N; j++)
+        reversed[j] = reference[(2 * N - j) % N];
+
+    std::array <double, N> sums {};
+    for (unsigned int e = 0; e < N; e++)
+    {
+        double count = (double)counts[e];
+        const double* row = &reversed[N - e];
+        for (unsigned int k = 0; k < N; k++)
+            sums[k] += count * row[k];
+    }
+
+    unsigned int best = 0;
+    for (unsigned int k = 0; k < N; k++)
+    {
+        correlations[k] = sums[k] * scale;
+        if (correlations[k] > correlations[best])
+            best = k;
+    }
+
+    return best;
+}
+
+
+// === Alphabet Policies ==========================================================================
+
+/**
+ * @struct UpperLatinAlphabet
+ *
+ * @brief The letters A-Z. The default alphabet: every other byte, lowercase included, passes
+ *        through untouched. Its kernels are the vector Caesar kernel and the letter counts the
+ *        histogram already keeps, so it costs nothing over the hand-written A-Z path.
+ *
+ */
+struct UpperLatinAlphabet {
+    static constexpr unsigned int SIZE = LETTER_BINS;
+
+    /*
+     * The symbols are the letters A-Z, so shifts are scored against ALPHABET_FREQUENCIES or a
+     * language model through the A-Z reference matrix; other alphabets carry FREQUENCIES
+     */
+    static constexpr bool LATIN = true;
+
+    static constexpr std::array <std::array <unsigned char, SIZE>, 1> BLOCKS =
+        { symbol_block ("ABCDEFGHIJKLMNOPQRSTUVWXYZ") };
+    static constexpr AlphabetTable <SIZE> TABLE = build_alphabet_table (BLOCKS);
+    static constexpr ShiftTable <SIZE> SHIFTS = build_shift_table (BLOCKS);
+
+    static const std::uint64_t* count_symbols (const Histogram& histogram, std::uint64_t*)
+        { return histogram.get_letter_counts().data(); }
+    static char decrypt_symbol (char c, unsigned int shift)
+        { return (char)SHIFTS[shift][(unsigned char)c]; }
+    static void decrypt (const char* in, char* out, std::size_t len, unsigned int shift)
+        { decrypt_caesar_span (in, out, len, shift); }
+};
+
+/**
+ * @struct MixedLatinAlphabet
+ *
+ * @brief The letters A-Z in either case. Uppercase and lowercase forms count as the same letter
+ *        and each keeps its case when decrypted; digits, spaces and punctuation pass through.
+ *
+ */
+struct MixedLatinAlphabet {
+    static constexpr unsigned int SIZE = LETTER_BINS;
+    static constexpr bool LATIN = true;
+
+    static constexpr std::array <std::array <unsigned char, SIZE>, 2> BLOCKS =
+        { symbol_block ("ABCDEFGHIJKLMNOPQRSTUVWXYZ"),
+          symbol_block ("abcdefghijklmnopqrstuvwxyz") };
+    static constexpr AlphabetTable <SIZE> TABLE = build_alphabet_table (BLOCKS);
+    static constexpr ShiftTable <SIZE> SHIFTS = build_shift_table (BLOCKS);
+
+    static const std::uint64_t* count_symbols (const Histogram& histogram,
+                                               std::uint64_t* counts)
+        { fold_symbol_counts (TABLE, histogram, counts); return counts; }
+    static char decrypt_symbol (char c, unsigned int shift)
+        { return (char)SHIFTS[shift][(unsigned char)c]; }
+    static void decrypt (const char* in, char* out, std::size_t len, unsigned int shift)
+        { decrypt_with_table (SHIFTS, in, out, len, shift); }
+};
+
+/**
+ * @fn build_custom_frequencies
+ *
+ * @param frequencies: Reference frequency of each symbol, in any units.
+ * @return The frequencies scaled to sum to 1.
+ *
+ */
+template <std::size_t N>
+constexpr std::array <double, N> build_custom_frequencies (const double (&frequencies)[N])
+{
+    std::array <double, N> scaled {};
+    double sum = 0.0;
+    for (std::size_t i = 0; i < N; i++)
+        sum += frequencies[i];
+    for (std::size_t i = 0; i < N; i++)
+        scaled[i] = (sum > 0.0) ? frequencies[i] / sum : 1.0 / (double)N;
+
+    return scaled;
+}
+
+/**
+ * @fn build_custom_frequencies
+ *
+ * @param frequencies: Reference frequency of each symbol, in any units.
+ * @return The frequencies scaled to sum to 1.
+ *
+ */
+template <std::size_t N>
+constexpr std::array <double, N> build_custom_frequencies (
+    const std::array <double, N>& frequencies)
+{
+    double raw[N] = {};
+    for (std::size_t i = 0; i < N; i++)
+        raw[i] = frequencies[i];
+
+    return build_custom_frequencies (raw);
+}
+
+/**
+ * @struct CustomAlphabet
+ *
+ * @brief An alphabet defined by the caller. Definition is a struct with two constexpr static
+ *        members: SYMBOLS, a string literal of the symbols in order, and FREQUENCIES, an array
+ *        (or std::array) of the reference frequency of each symbol in the expected plaintext,
+ *        e.g.
+ *
+ *            struct DigitSymbols {
+ *                static constexpr char SYMBOLS[] = "0123456789";
+ *                static constexpr double FREQUENCIES[10] = { ... };
+ *            };
+ *            typedef CustomAlphabet <DigitSymbols> DigitAlphabet;
+ *
+ */
+template <class Definition>
+struct CustomAlphabet {
+    static constexpr unsigned int SIZE = sizeof (Definition::SYMBOLS) - 1;
+    static constexpr bool LATIN = false;
+
+    static_assert (sizeof (Definition::FREQUENCIES) == SIZE * sizeof (double),
+                   "an alphabet needs one reference frequency per symbol");
+
+    static constexpr std::array <std::array <unsigned char, SIZE>, 1> BLOCKS =
+        { symbol_block (Definition::SYMBOLS) };
+    static constexpr AlphabetTable <SIZE> TABLE = build_alphabet_table (BLOCKS);
+    static constexpr ShiftTable <SIZE> SHIFTS = build_shift_table (BLOCKS);
+    static constexpr std::array <double, SIZE> FREQUENCIES =
+        build_custom_frequencies (Definition::FREQUENCIES);
+
+    static const std::uint64_t* count_symbols (const Histogram& histogram,
+                                               std::uint64_t* counts)
+        { fold_symbol_counts (TABLE, histogram, counts); return counts; }
+    static char decrypt_symbol (char c, unsigned int shift)
+        { return (char)SHIFTS[shift][(unsigned char)c]; }
+    static void decrypt (const char* in, char* out, std::size_t len, unsigned int shift)
+        { decrypt_with_table (SHIFTS, in, out, len, shift); }
+};
+
+/**
+ * @fn build_prose_frequencies
+ *
+ * @param first: Byte of the first symbol of the alphabet.
+ * @return The reference frequency of each of the N bytes from first on in English prose, built
+ *         from ALPHABET_FREQUENCIES and the PROSE_* shares.
+ *
+ */
+template <std::size_t N>
+constexpr std::array <double, N> build_prose_frequencies (unsigned int first)
+{
+    double raw[N] = {};
+    for (unsigned int i = 0; i < N; i++)
+    {
+        unsigned int b = first + i;
+        if ((b >= 'a') && (b <= 'z'))
+            raw[i] = PROSE_LOWER_SHARE * ALPHABET_FREQUENCIES[b - 'a'];
+        else if ((b >= 'A') && (b <= 'Z'))
+            raw[i] = PROSE_UPPER_SHARE * ALPHABET_FREQUENCIES[b - 'A'];
+        else if (b == ' ')
+            raw[i] = PROSE_SPACE_SHARE;
+        else if ((b == '.') || (b == ','))
+            raw[i] = PROSE_PUNCTUATION_SHARE;
+    }
+
+    return build_custom_frequencies (raw);
+}
+
+/**
+ * @fn byte_block
+ *
+ * @return Every byte value in order, as the single block of ByteAlphabet.
+ *
+ */
+constexpr std::array <unsigned char, BYTE_BINS> byte_block ()
+{
+    std::array <unsigned char, BYTE_BINS> block {};
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+        block[b] = (unsigned char)b;
+
+    return block;
+}
+
+/**
+ * @struct ByteAlphabet
+ *
+ * @brief All 256 byte values, for ciphers that add the key to whole bytes mod 256. The plaintext
+ *        is assumed to be English prose in ASCII. Its kernel is plain byte subtraction, which
+ *        the compiler vectorizes.
+ *
+ */
+struct ByteAlphabet {
+    static constexpr unsigned int SIZE = BYTE_BINS;
+    static constexpr bool LATIN = false;
+
+    static constexpr std::array <std::array <unsigned char, SIZE>, 1> BLOCKS = { byte_block() };
+    static constexpr AlphabetTable <SIZE> TABLE = build_alphabet_table (BLOCKS);
+    static constexpr std::array <double, SIZE> FREQUENCIES = build_prose_frequencies <SIZE> (0);
+
+    static const std::uint64_t* count_symbols (const Histogram& histogram, std::uint64_t*)
+        { return histogram.get_byte_counts().data(); }
+    static char decrypt_symbol (char c, unsigned int shift)
+        { return (char)((unsigned char)c - shift); }
+    static void decrypt (const char* in, char* out, std::size_t len, unsigned int shift)
+    {
+        // Every byte is a symbol and wraps mod 256 by itself, so no table is needed
+        for (std::size_t i = 0; i < len; i++)
+            out[i] = (char)((unsigned char)in[i] - shift);
+    }
+};
+
+/**
+ * @struct PrintableSymbols
+ *
+ * @brief The 94 printable ASCII characters other than space, as rotated by ROT47.
+ *
+ */
+struct PrintableSymbols {
+    static constexpr char SYMBOLS[] = "!\"#$%&'()*+,-./0123456789:;<=>?@"
+                                      "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+                                      "abcdefghijklmnopqrstuvwxyz{|}~";
+    static constexpr std::array <double, 94> FREQUENCIES = build_prose_frequencies <94> ('!');
+};
+
+typedef CustomAlphabet <PrintableSymbols> PrintableAlphabet;
+
+
+/*
+ * Alphabets other than A-Z that StringAnalysis and DecryptEngine are compiled for; X is applied
+ * to each policy in turn to instantiate the templates
+ */
+#define FOR_EACH_EXTRA_ALPHABET(X) \
+    X (MixedLatinAlphabet)         \
+    X (ByteAlphabet)               \
+    X (PrintableAlphabet)
+
+#endif
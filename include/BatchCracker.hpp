@@ -0,0 +1,83 @@
+/**
+ * @file BatchCracker.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the BatchCracker class, which cracks a corpus of
+ *        line-delimited ciphertexts on a thread pool.
+ *
+ * @see BatchCracker.cpp
+ *
+ */
+
+#ifndef BATCHCRACKER_HPP
+#define BATCHCRACKER_HPP
+
+#include "EngineStats.hpp"
+#include "ResultCache.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+// Number of ciphertext lines handed to a worker as a single task
+const std::size_t BATCH_LINES = 256;
+
+// Number of batches allowed to be read but not yet written, per worker thread
+const std::size_t BATCHES_IN_FLIGHT_PER_THREAD = 4;
+
+
+enum CipherMode { CAESAR_MODE, VIGENERE_MODE, SUBSTITUTION_MODE };
+
+
+class BatchCracker {
+public:
+
+    // Ctors
+    BatchCracker (CipherMode, unsigned int threads = 0);
+
+    // Processing Functions
+    void run (std::istream&, std::ostream&);
+    void crack_line (std::string&);
+
+    // Mutators
+    void set_result_cache (ResultCache* cache) { result_cache = cache; }
+    void enable_stats (bool enable) { stats_enabled = enable; }
+
+    // Accessors
+    const EngineStats& get_stats () const { return stats; }
+
+private:
+
+    /**
+     * @struct Batch
+     *
+     * @brief A block of consecutive lines from the corpus and, once cracked, their results.
+     *
+     */
+    struct Batch {
+        std::size_t sequence;
+        std::vector <std::string> lines;
+    };
+
+    void crack_batch (Batch&);
+
+    CipherMode mode;
+    ThreadPool pool;
+
+    // Optional cache shared by every worker, so repeated lines are cracked once; not owned
+    ResultCache* result_cache;
+
+    // Stage stats of every worker's engine, merged after each batch when enabled
+    bool stats_enabled;
+    std::mutex stats_mutex;
+    EngineStats stats;
+};
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file BoundedQueue.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains the BoundedQueue class template, a blocking FIFO with a fixed capacity used to
+ *        hand work between the stages of a pipeline.
+ *
+ */
+
+#ifndef BOUNDEDQUEUE_HPP
+#define BOUNDEDQUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+
+template <typename T>
+class BoundedQueue {
+public:
+
+    // Ctors
+    BoundedQueue (std::size_t cap) : capacity (cap), closed (false) {}
+
+    /**
+     * @fn BoundedQueue::push
+     *
+     * @param item: The item to be added to the back of the queue.
+     * @return false if the queue was closed and the item was dropped, true otherwise.
+     *
+     * @brief Adds an item to the queue, blocking while the queue is full.
+     *
+     */
+    bool push (T item)
+    {
+        std::unique_lock <std::mutex> lock (queue_mutex);
+        not_full.wait (lock, [this] { return closed || (items.size() < capacity); });
+        if (closed)
+            return false;
+
+        items.push_back (std::move (item));
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @fn BoundedQueue::pop
+     *
+     * @param item: Receives the item at the front of the queue.
+     * @return false once the queue is closed and drained, true otherwise.
+     *
+     * @brief Removes the item at the front of the queue, blocking while the queue is empty.
+     *
+     */
+    bool pop (T& item)
+    {
+        std::unique_lock <std::mutex> lock (queue_mutex);
+        not_empty.wait (lock, [this] { return closed || !items.empty(); });
+        if (items.empty())
+            return false;
+
+        item = std::move (items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    /**
+     * @fn BoundedQueue::close
+     *
+     * @brief Marks the end of input. Items already queued can still be popped; further pushes
+     *        fail.
+     *
+     */
+    void close ()
+    {
+        std::lock_guard <std::mutex> lock (queue_mutex);
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+private:
+
+    std::deque <T> items;
+    std::size_t capacity;
+    bool closed;
+
+    std::mutex queue_mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+};
+
+#endif
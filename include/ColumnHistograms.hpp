@@ -0,0 +1,64 @@
+/**
+ * @file ColumnHistograms.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the ColumnHistograms class, which keeps separate letter
+ *        counts for every column of a text split at a fixed period.
+ *
+ * @see ColumnHistograms.cpp
+ *
+ */
+
+#ifndef COLUMNHISTOGRAMS_HPP
+#define COLUMNHISTOGRAMS_HPP
+
+#include "Histogram.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+class ColumnHistograms {
+public:
+
+    // Ctors
+    ColumnHistograms ();
+
+    // Counting Functions
+    void reset (unsigned int);
+    void reserve (unsigned int);
+    void count (const std::uint8_t*, std::size_t);
+    void merge (const std::uint64_t*, std::uint64_t);
+
+    // Accessors
+    unsigned int get_period () const { return period; }
+    const std::uint64_t* get_column (unsigned int c) const { return &counts[c * LETTER_BINS]; }
+    std::uint64_t get_column_total (unsigned int c) const { return totals[c]; }
+
+private:
+
+    /**
+     * @var std::vector <std::uint64_t> counts
+     *
+     * @brief Flat table of letter counts; column c occupies the LETTER_BINS entries starting at
+     *        c * LETTER_BINS.
+     *
+     */
+    std::vector <std::uint64_t> counts;
+
+    /**
+     * @var std::vector <std::uint64_t> totals
+     *
+     * @brief Number of letters that have fallen into each column.
+     *
+     */
+    std::vector <std::uint64_t> totals;
+
+    unsigned int period;
+    unsigned int next_column;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file Coordinator.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the Coordinator class, which splits a corpus or one huge
+ *        Vigenere file into shards and cracks them in forked worker processes, so a crash in one
+ *        worker only costs the shard it was working on.
+ *
+ * @see Coordinator.cpp
+ * @see CrackProtocol.hpp
+ *
+ */
+
+#ifndef COORDINATOR_HPP
+#define COORDINATOR_HPP
+
+#include "BatchCracker.hpp"
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+
+// Most lines, and most bytes of corpus, handed to a worker as one shard
+const std::size_t COORDINATOR_SHARD_LINES = 1024;
+const std::size_t COORDINATOR_SHARD_BYTES = std::size_t (1) << 22;
+
+/*
+ * Number of byte ranges per worker a huge file is split into, so a restarted worker only redoes
+ * a small part of the file; ranges are never shorter than FILE_CHUNK_SIZE
+ */
+const unsigned int COORDINATOR_RANGES_PER_WORKER = 4;
+
+/*
+ * Number of times a shard is handed out before it is given up on. A shard of many lines that
+ * kills its worker is split into single lines first, so only the line to blame is lost
+ */
+const unsigned int COORDINATOR_MAX_ATTEMPTS = 3;
+
+// Kinds of task sent to a worker, carried in the kind byte of the frame
+const std::uint8_t TASK_LINES = 'L';
+const std::uint8_t TASK_PERIODS = 'P';
+const std::uint8_t TASK_COLUMNS = 'K';
+
+
+class Coordinator {
+public:
+
+    // Ctors
+    Coordinator (CipherMode, unsigned int workers = 0);
+    ~Coordinator ();
+
+    Coordinator (const Coordinator&) = delete;
+    Coordinator& operator= (const Coordinator&) = delete;
+
+    // Processing Functions
+    bool run (std::istream&, std::ostream&);
+    bool crack_file (const std::string&, std::ostream&);
+
+    // Mutators
+    void set_cache_path (const std::string& path) { cache_path = path; }
+
+    // Accessors
+    unsigned int get_worker_count () const { return worker_count; }
+    std::uint64_t get_restarts () const { return restarts; }
+    std::uint64_t get_failed_lines () const { return failed_lines; }
+    const std::string& get_key () const { return key; }
+
+private:
+
+    /**
+     * @struct Shard
+     *
+     * @brief One task: for TASK_LINES, lines first to first + count - 1 of the corpus, each
+     *        ending in a newline; for the file tasks, range number first of the file, as two
+     *        offsets and, for TASK_COLUMNS, the period.
+     *
+     */
+    struct Shard {
+        std::uint64_t first;
+        std::uint32_t count;
+        std::uint8_t kind;
+        unsigned int attempts;
+        std::string payload;
+    };
+
+    /**
+     * @struct Worker
+     *
+     * @brief A forked worker: its pid, the pipe ends its tasks are written to and its results
+     *        read from, and the shard it is working on while busy.
+     *
+     */
+    struct Worker {
+        pid_t pid;
+        int task_fd;
+        int result_fd;
+        bool busy;
+        Shard shard;
+    };
+
+    typedef std::function <bool (Shard&)> ShardSource;
+    typedef std::function <void (const Shard&, std::string&, bool)> ShardSink;
+
+    bool dispatch (const ShardSource&, const ShardSink&);
+    bool assign (Worker&, Shard&);
+    void fail (Worker&, std::deque <Shard>&, const ShardSink&);
+    bool start_worker (Worker&);
+    void stop_worker (Worker&, bool);
+    void start_workers ();
+    void stop_workers ();
+
+    // Worker Functions
+    void serve_worker (int, int);
+    void count_periods (std::uint64_t, std::uint64_t, std::string&);
+    void count_columns (std::uint64_t, std::uint64_t, unsigned int, std::string&);
+
+    CipherMode mode;
+    unsigned int worker_count;
+    std::vector <Worker> workers;
+
+    // Path of a disk result cache every worker opens; empty for none
+    std::string cache_path;
+
+    /**
+     * @var MappedFile file
+     *
+     * @brief The huge file being cracked, mapped before the workers are forked so every worker
+     *        reads it through the same mapping.
+     *
+     */
+    MappedFile file;
+    std::string key;
+
+    std::uint64_t restarts;
+    std::uint64_t failed_lines;
+};
+
+#endif
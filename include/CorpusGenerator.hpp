@@ -0,0 +1,63 @@
+/**
+ * @file CorpusGenerator.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the CorpusGenerator class, which produces seeded,
+ *        English-like plaintexts and encrypts them with random Caesar and Vigenere keys.
+ *
+ * @see CorpusGenerator.cpp
+ *
+ */
+
+#ifndef CORPUSGENERATOR_HPP
+#define CORPUSGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Range of key lengths drawn for random Vigenere keys
+const unsigned int MIN_RANDOM_KEY_LENGTH = 3;
+const unsigned int MAX_RANDOM_KEY_LENGTH = 16;
+
+
+class CorpusGenerator {
+public:
+
+    // Ctors
+    CorpusGenerator (std::uint64_t seed = 1);
+
+    // Generation Functions
+    void gen_plaintext (std::string&, std::size_t);
+    char gen_caesar_key ();
+    std::string gen_vigenere_key ();
+
+    // Encryption Functions
+    static void encrypt_caesar (std::string&, char);
+    static void encrypt_vigenere (std::string&, const std::string&);
+
+private:
+
+    /**
+     * @var std::mt19937_64 rng
+     *
+     * @brief Source of every random choice, so a given seed always yields the same corpus.
+     *
+     */
+    std::mt19937_64 rng;
+
+    /**
+     * @var std::discrete_distribution <unsigned int> word_choice
+     *
+     * @brief Picks words from the built-in word list with a Zipf-like (1 / rank) weighting.
+     *
+     */
+    std::discrete_distribution <unsigned int> word_choice;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file CrackProtocol.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains the wire format spoken between CrackServer and its clients, and helpers for
+ *        reading and writing it on a file descriptor.
+ *
+ *        Every message is a FrameHeader followed by length bytes of payload. Requests carry a
+ *        ciphertext; responses carry "<key>\t<plaintext>" or, on error, a message. Integers are
+ *        little-endian. Each request has an id chosen by the client, which the response echoes;
+ *        requests on one connection are cracked concurrently, so responses may come back in any
+ *        order.
+ *
+ */
+
+#ifndef CRACKPROTOCOL_HPP
+#define CRACKPROTOCOL_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+// Size of the header in front of every request and response
+const std::size_t FRAME_HEADER_SIZE = 12;
+
+// Longest payload accepted in a request; longer ones are answered with FRAME_TOO_LONG
+const std::uint32_t MAX_FRAME_PAYLOAD = std::uint32_t (1) << 24;
+
+// Cipher requested, carried in the kind byte of a request
+const std::uint8_t FRAME_CAESAR = 'C';
+const std::uint8_t FRAME_VIGENERE = 'V';
+
+// Outcome of a request, carried in the kind byte of a response
+const std::uint8_t FRAME_OK = 0;
+const std::uint8_t FRAME_BAD_MODE = 1;
+const std::uint8_t FRAME_TOO_LONG = 2;
+
+
+/**
+ * @struct FrameHeader
+ *
+ * @brief The decoded form of the FRAME_HEADER_SIZE bytes in front of each payload: payload
+ *        length (4 bytes), request id (4 bytes), kind (1 byte) and 3 bytes of zero padding.
+ *
+ */
+struct FrameHeader {
+    std::uint32_t length;
+    std::uint32_t id;
+    std::uint8_t kind;
+};
+
+
+/**
+ * @fn encode_frame_header
+ *
+ * @param header: Header to be encoded.
+ * @param bytes: Receives FRAME_HEADER_SIZE bytes.
+ *
+ */
+inline void encode_frame_header (const FrameHeader& header, unsigned char* bytes)
+{
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        bytes[i] = (unsigned char)(header.length >> (8 * i));
+        bytes[4 + i] = (unsigned char)(header.id >> (8 * i));
+    }
+    bytes[8] = header.kind;
+    bytes[9] = bytes[10] = bytes[11] = 0;
+}
+
+/**
+ * @fn decode_frame_header
+ *
+ * @param bytes: FRAME_HEADER_SIZE bytes read from the wire.
+ * @return The decoded header.
+ *
+ */
+inline FrameHeader decode_frame_header (const unsigned char* bytes)
+{
+    FrameHeader header = { 0, 0, bytes[8] };
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        header.length |= (std::uint32_t)bytes[i] << (8 * i);
+        header.id |= (std::uint32_t)bytes[4 + i] << (8 * i);
+    }
+    return header;
+}
+
+/**
+ * @fn read_full
+ *
+ * @param fd: Descriptor to read from.
+ * @param buf: Receives len bytes.
+ * @param len: Number of bytes wanted.
+ * @return true if all len bytes were read, false on end of file or error.
+ *
+ */
+inline bool read_full (int fd, void* buf, std::size_t len)
+{
+    char* out = (char*)buf;
+    while (len > 0)
+    {
+        ssize_t got = ::read (fd, out, len);
+        if ((got < 0) && (errno == EINTR))
+            continue;
+        if (got <= 0)
+            return false;
+        out += got;
+        len -= (std::size_t)got;
+    }
+    return true;
+}
+
+/**
+ * @fn write_full
+ *
+ * @param fd: Descriptor to write to; a socket or a pipe.
+ * @param buf: Bytes to be written.
+ * @param len: Number of bytes in buf.
+ * @return true if all len bytes were written, false if the other end has gone.
+ *
+ * @brief Writes a whole buffer. Sockets are written with MSG_NOSIGNAL so a client that hangs up
+ *        does not kill the process with SIGPIPE; pipes fall back to write.
+ *
+ */
+inline bool write_full (int fd, const void* buf, std::size_t len)
+{
+    const char* in = (const char*)buf;
+    bool socket = true;
+    while (len > 0)
+    {
+        ssize_t put = socket ? ::send (fd, in, len, MSG_NOSIGNAL) : ::write (fd, in, len);
+        if ((put < 0) && socket && (errno == ENOTSOCK))
+        {
+            socket = false;
+            continue;
+        }
+        if ((put < 0) && (errno == EINTR))
+            continue;
+        if (put <= 0)
+            return false;
+        in += put;
+        len -= (std::size_t)put;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file CrackServer.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the CrackServer class, a long-running server that
+ *        answers cracking requests over a Unix domain socket or a pipe with warm engines.
+ *
+ * @see CrackServer.cpp
+ * @see CrackProtocol.hpp
+ *
+ */
+
+#ifndef CRACKSERVER_HPP
+#define CRACKSERVER_HPP
+
+#include "EngineStats.hpp"
+#include "LanguageModel.hpp"
+#include "ResultCache.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+/*
+ * Number of requests a connection may have queued, being cracked or waiting to be written at
+ * once; the connection stops being read until a response is written, which bounds the memory a
+ * fast client, or one that stops reading, can tie up
+ */
+const std::size_t MAX_PENDING_REQUESTS = 64;
+
+// Number of connections the kernel queues while the server is busy accepting
+const int SERVER_BACKLOG = 64;
+
+
+class CrackServer {
+public:
+
+    // Ctors
+    CrackServer (unsigned int threads = 0);
+    ~CrackServer ();
+
+    CrackServer (const CrackServer&) = delete;
+    CrackServer& operator= (const CrackServer&) = delete;
+
+    // Server Functions
+    bool listen (const std::string&);
+    void run ();
+    void serve (int, int);
+    void stop ();
+
+    // Mutators
+    void set_language_model (const LanguageModel* model) { language_model = model; }
+    void set_result_cache (ResultCache* cache) { result_cache = cache; }
+    void enable_stats (bool enable) { stats_enabled = enable; }
+
+    // Accessors
+    std::uint64_t get_requests_served () const { return requests_served; }
+    const EngineStats& get_stats () const { return stats; }
+
+private:
+
+    /**
+     * @struct Connection
+     *
+     * @brief One client: the descriptors its requests are read from and its responses written
+     *        to, the requests it has in flight, and the encoded responses waiting for its writer
+     *        thread. Shared by the reading thread, the writer thread and every pool task working
+     *        on one of its requests. pending counts requests whose response is not yet written.
+     *
+     */
+    struct Connection {
+        int in_fd;
+        int out_fd;
+        std::mutex pending_mutex;
+        std::condition_variable pending_done;
+        std::condition_variable outbox_ready;
+        std::deque <std::string> outbox;
+        std::size_t pending = 0;
+        bool closing = false;
+        bool broken = false;
+    };
+
+    void crack_request (const std::shared_ptr <Connection>&, std::uint32_t, std::uint8_t,
+                        std::string&);
+    bool respond (Connection&, std::uint32_t, std::uint8_t, const std::string&);
+    void write_responses (Connection&);
+
+    ThreadPool pool;
+    const LanguageModel* language_model;
+
+    // Optional cache shared by every pool thread and connection; not owned
+    ResultCache* result_cache;
+    std::atomic <std::uint64_t> requests_served;
+
+    // Stage stats of every pool thread's engine, merged after each request when enabled
+    bool stats_enabled;
+    std::mutex stats_mutex;
+    EngineStats stats;
+
+    /**
+     * @var int listen_fd
+     *
+     * @brief The listening socket, or -1. stop shuts it down, which wakes run from accept.
+     *
+     */
+    int listen_fd;
+    std::string socket_path;
+    std::atomic <bool> stopping;
+
+    // Open client sockets, so run can wake their readers when the server stops
+    std::mutex connections_mutex;
+    std::condition_variable connections_done;
+    std::vector <int> connection_fds;
+};
+
+#endif
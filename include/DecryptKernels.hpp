@@ -0,0 +1,39 @@
+/**
+ * @file DecryptKernels.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains declarations for the buffer-based Caesar and Vigenere decryption kernels. Each
+ *        kernel has scalar, SSE2, AVX2 and AVX-512 versions; the fastest one the CPU supports is
+ *        picked at runtime.
+ *
+ * @see DecryptKernels.cpp
+ *
+ */
+
+#ifndef DECRYPTKERNELS_HPP
+#define DECRYPTKERNELS_HPP
+
+#include <cstddef>
+
+
+// Longest key the vector Vigenere kernels handle; longer keys use the scalar kernel
+const unsigned int MAX_VECTOR_KEY_LENGTH = 256;
+
+
+enum DecryptKernelLevel { KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2, KERNEL_AVX512 };
+
+
+// Kernels; in and out may be the same buffer, and bytes outside A-Z are copied unchanged
+void decrypt_caesar_span (const char*, char*, std::size_t, unsigned int);
+void decrypt_vigenere_span (const char*, char*, std::size_t, const char*, unsigned int,
+                            unsigned int);
+
+// Dispatch Functions
+DecryptKernelLevel get_supported_kernel_level ();
+DecryptKernelLevel get_decrypt_kernel_level ();
+void set_decrypt_kernel_level (DecryptKernelLevel);
+const char* get_decrypt_kernel_name ();
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @file EngineStats.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for EngineStats and StageTimer, which record how much time,
+ *        input and memory each stage of a DecryptEngine run uses, and how its latency spreads
+ *        over messages of different sizes.
+ *
+ * @see EngineStats.cpp
+ *
+ */
+
+#ifndef ENGINESTATS_HPP
+#define ENGINESTATS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+enum EngineStage { STAGE_ANALYZE, STAGE_KEY_LENGTH, STAGE_SPLIT, STAGE_COLUMNS, STAGE_REFINE,
+                   STAGE_DECRYPT, STAGE_COUNT };
+
+/*
+ * Rows of a latency histogram, by the bit width of the message size in bytes: row 0 holds empty
+ * messages and row b sizes from 2^(b-1) to 2^b - 1. The last row also holds anything larger
+ */
+const unsigned int LATENCY_SIZE_BUCKETS = 32;
+
+// Columns of a latency histogram, by the bit width of the wall time in nanoseconds, likewise
+const unsigned int LATENCY_TIME_BUCKETS = 40;
+
+
+/**
+ * @struct StageStats
+ *
+ * @brief Totals for one stage across every run recorded since the last reset, and the number of
+ *        runs in each cell of a histogram of message size by wall time.
+ *
+ */
+struct StageStats {
+    std::uint64_t calls;
+    std::uint64_t bytes;
+    std::uint64_t wall_ns;
+    std::uint64_t max_wall_ns;
+    std::uint64_t allocations;
+    std::uint64_t latency[LATENCY_SIZE_BUCKETS][LATENCY_TIME_BUCKETS];
+};
+
+
+// Heap allocations made by the calling thread so far; stays 0 unless AllocationCounter is linked
+std::uint64_t get_thread_allocations ();
+
+
+class EngineStats {
+public:
+
+    // Ctors
+    EngineStats ();
+
+    // Recording Functions
+    void reset ();
+    void record (EngineStage, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t);
+    void merge (const EngineStats&);
+
+    // Mutators
+    void set_message_size (std::uint64_t bytes) { message_size = bytes; }
+
+    // Output Functions
+    std::string to_json () const;
+
+    // Accessors
+    const StageStats& get_stage (EngineStage stage) const { return stages[stage]; }
+    std::uint64_t get_message_size () const { return message_size; }
+    static const char* get_stage_name (EngineStage);
+
+private:
+
+    static unsigned int bucket_of (std::uint64_t, unsigned int);
+    static std::uint64_t bucket_floor (unsigned int);
+
+    StageStats stages[STAGE_COUNT];
+
+    // Size of the message being cracked, which picks the histogram row its runs are counted in
+    std::uint64_t message_size;
+};
+
+
+class StageTimer {
+public:
+
+    /**
+     * @fn StageTimer::StageTimer
+     *
+     * @param s: Stats to record into, or nullptr when instrumentation is off.
+     * @param st: The stage being timed.
+     * @param b: Number of input bytes the stage works on.
+     * @param c: Number of calls the stage stands for, e.g. the number of columns solved.
+     *
+     * @brief Starts timing a stage; the stage is recorded when the timer goes out of scope. When
+     *        s is nullptr nothing is read or recorded.
+     *
+     */
+    StageTimer (EngineStats* s, EngineStage st, std::uint64_t b, std::uint64_t c = 1)
+        : stats (s), stage (st), bytes (b), calls (c)
+    {
+        if (stats != nullptr)
+        {
+            start_allocations = get_thread_allocations();
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~StageTimer ()
+    {
+        if (stats != nullptr)
+        {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+            stats->record (stage, calls, bytes, elapsed.count(),
+                           get_thread_allocations() - start_allocations);
+        }
+    }
+
+    StageTimer (const StageTimer&) = delete;
+    StageTimer& operator= (const StageTimer&) = delete;
+
+private:
+
+    EngineStats* stats;
+    EngineStage stage;
+    std::uint64_t bytes;
+    std::uint64_t calls;
+    std::uint64_t start_allocations;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif
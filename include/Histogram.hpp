@@ -0,0 +1,89 @@
+/**
+ * @file Histogram.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the Histogram class, which keeps flat, fixed-size counts
+ *        of the bytes and letters found in a buffer.
+ *
+ * @see Histogram.cpp
+ *
+ */
+
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+// Number of bins in each of the flat count tables
+const unsigned int BYTE_BINS = 256;
+const unsigned int LETTER_BINS = 26;
+
+/*
+ * Number of interleaved sub-histograms used by the counting kernel; consecutive bytes land in
+ * different tables so repeated characters do not stall on the same counter
+ */
+const unsigned int HISTOGRAM_LANES = 4;
+
+
+class Histogram {
+public:
+
+    // Ctors
+    Histogram ();
+
+    // Counting Functions
+    void count (const char*, std::size_t);
+    void count_letters (const std::uint8_t*, std::size_t);
+    void add (char c) { add_byte_run ((unsigned char) c, 1); }
+    void merge (const Histogram&);
+    void clear ();
+
+    // Accessors
+    std::uint64_t get_byte_count (char c) const { return byte_counts[(unsigned char) c]; }
+    std::uint64_t get_letter_count (unsigned int i) const { return letter_counts[i]; }
+    std::uint64_t get_total () const { return total; }
+    std::uint64_t get_letter_total () const { return letter_total; }
+    std::uint64_t get_coincidences () const { return coincidences; }
+    const std::array <std::uint64_t, BYTE_BINS>& get_byte_counts () const { return byte_counts; }
+    const std::array <std::uint64_t, LETTER_BINS>& get_letter_counts () const
+        { return letter_counts; }
+
+private:
+
+    void add_byte_run (unsigned char, std::uint64_t);
+
+    /**
+     * @var std::array <std::uint64_t, BYTE_BINS> byte_counts
+     *
+     * @brief Number of times each byte value has been counted.
+     *
+     */
+    std::array <std::uint64_t, BYTE_BINS> byte_counts;
+
+    /**
+     * @var std::array <std::uint64_t, LETTER_BINS> letter_counts
+     *
+     * @brief Number of times each uppercase letter has been counted; [0] = 'A', [25] = 'Z'.
+     *
+     */
+    std::array <std::uint64_t, LETTER_BINS> letter_counts;
+
+    std::uint64_t total;
+    std::uint64_t letter_total;
+
+    /**
+     * @var std::uint64_t coincidences
+     *
+     * @brief SIGMA(n(n-1)) over every byte count n; the summation part of the IC, kept up to date
+     *        as bytes are counted so the IC never needs a pass over the table.
+     *
+     */
+    std::uint64_t coincidences;
+};
+
+#endif
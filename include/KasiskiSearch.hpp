@@ -0,0 +1,142 @@
+/**
+ * @file KasiskiSearch.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the KasiskiSearch class, which finds repeated runs of
+ *        letters in a ciphertext and turns the distances between them into key length evidence.
+ *
+ * @see KasiskiSearch.cpp
+ *
+ */
+
+#ifndef KASISKISEARCH_HPP
+#define KASISKISEARCH_HPP
+
+#include "Histogram.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Number of distinct trigrams; every trigram has its own slot in the exact repeat index
+const unsigned int TRIGRAM_SLOTS = LETTER_BINS * LETTER_BINS * LETTER_BINS;
+
+/*
+ * Length of the longer repeats found through the rolling hash, and their weight as evidence; a
+ * run of LONG_REPEAT_LENGTH letters is rolled as a base-26 code, which fits in 32 bits
+ */
+const unsigned int LONG_REPEAT_LENGTH = 6;
+const std::uint32_t LONG_REPEAT_CODES = TRIGRAM_SLOTS * TRIGRAM_SLOTS;
+const unsigned int LONG_REPEAT_WEIGHT = 4;
+
+/*
+ * Number of slots in the rolling hash table, a power of two; when two runs share a slot the
+ * newer one wins, so memory stays fixed at the cost of missing a few long repeats
+ */
+const unsigned int LONG_REPEAT_SLOT_BITS = 14;
+const unsigned int LONG_REPEAT_SLOTS = 1u << LONG_REPEAT_SLOT_BITS;
+
+// Longest distance between repeats that is recorded; closer repeats are the reliable ones
+const unsigned int MAX_REPEAT_DISTANCE = 1u << 16;
+
+/*
+ * Number of bytes after which a text stops being scanned; repeats at the key length are so
+ * common in long texts that the evidence has settled well before this
+ */
+const std::uint64_t MAX_KASISKI_SAMPLE = std::uint64_t (1) << 22;
+
+/*
+ * Number of weighted repeats at which the evidence is trusted half as much as a long text's;
+ * short texts have few repeats and many of them are chance
+ */
+const double KASISKI_HALF_CONFIDENCE = 8.0;
+
+/*
+ * Share of the evidence that a period loses for the GCDs of successive long repeat distances it
+ * does not divide; chance factors mostly cancel out of a GCD, so the key length divides nearly
+ * all of them and its multiples only a few
+ */
+const double KASISKI_GCD_SHARE = 0.25;
+
+
+class KasiskiSearch {
+public:
+
+    // Ctors
+    KasiskiSearch ();
+
+    // Search Functions
+    void reset (unsigned int);
+    void count (const std::uint8_t*, std::size_t);
+    void tally ();
+
+    // Accessors
+    std::uint64_t get_repeat_total () const { return repeat_total; }
+    std::uint64_t get_factor_count (unsigned int p) const { return factor_counts[p]; }
+    std::uint64_t get_gcd_count (unsigned int p) const { return gcd_counts[p]; }
+    double get_evidence (unsigned int) const;
+    unsigned int get_max_period () const { return max_period; }
+
+private:
+
+    void add_distance (std::uint64_t, unsigned int);
+
+    /**
+     * @var std::vector <std::uint64_t> last_trigram
+     *
+     * @brief Position of the latest occurrence of every trigram. Entries from earlier texts lie
+     *        before origin and are ignored, so a reset never has to clear the index.
+     *
+     */
+    std::vector <std::uint64_t> last_trigram;
+
+    /**
+     * @var std::vector <std::uint32_t> long_codes
+     *
+     * @brief Code of the run of LONG_REPEAT_LENGTH letters held in each hash slot, with the
+     *        run's position in long_positions; like last_trigram, slots older than origin are
+     *        empty.
+     *
+     */
+    std::vector <std::uint32_t> long_codes;
+    std::vector <std::uint64_t> long_positions;
+
+    /**
+     * @var std::vector <std::uint64_t> distances
+     *
+     * @brief Weighted number of repeats found at each distance up to MAX_REPEAT_DISTANCE.
+     *
+     */
+    std::vector <std::uint64_t> distances;
+
+    // Weighted number of distances each period divides, and of long repeat GCDs equal to it
+    std::vector <std::uint64_t> factor_counts;
+    std::vector <std::uint64_t> gcd_counts;
+
+    std::uint64_t repeat_total;
+    std::uint64_t gcd_total;
+    std::uint64_t last_long_distance;
+    std::uint64_t longest_distance;
+    unsigned int max_period;
+
+    /**
+     * @var std::uint64_t position
+     *
+     * @brief Position of the next byte scanned. Keeps counting across resets, which only move
+     *        origin up to it.
+     *
+     */
+    std::uint64_t position;
+    std::uint64_t origin;
+
+    // Scan state carried between calls to count
+
+    unsigned int trigram;
+    unsigned int run_length;
+    std::uint32_t rolling_code;
+};
+
+#endif
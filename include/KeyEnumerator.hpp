@@ -0,0 +1,94 @@
+/**
+ * @file KeyEnumerator.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the KeyEnumerator class, which lists the best Vigenere
+ *        keys in order of combined column score, for when the single most likely key is wrong.
+ *
+ * @see KeyEnumerator.cpp
+ *
+ */
+
+#ifndef KEYENUMERATOR_HPP
+#define KEYENUMERATOR_HPP
+
+#include "NgramScorer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+ * @struct KeyCandidate
+ *
+ * @brief A full key and the sum of its columns' scores; higher is more likely. fitness is the
+ *        log10 quadgram likelihood per letter of the text decrypted with the key, or 0 if the
+ *        candidate has not been rescored.
+ *
+ */
+struct KeyCandidate {
+    std::string key;
+    double score;
+    double fitness;
+};
+
+
+class KeyEnumerator {
+public:
+
+    // Ctors
+    KeyEnumerator ();
+
+    // Enumeration Functions
+    void enumerate (const double*, unsigned int, unsigned int);
+    void rescore (const std::uint8_t*, std::size_t, const NgramScorer&, unsigned int);
+
+    // Accessors
+    const std::vector <KeyCandidate>& get_candidates () const { return candidates; }
+
+private:
+
+    /**
+     * @struct Node
+     *
+     * @brief A key waiting in the queue, stored as the change that makes it from the popped key
+     *        parent: op is one of the ENUMERATE_* steps, applied at position.
+     *
+     */
+    struct Node {
+        double score;
+        unsigned int parent;
+        unsigned int position;
+        unsigned int op;
+    };
+
+    // Per column, the shifts from best to worst and their scores, in score order of the columns
+    std::vector <unsigned char> sorted_shifts;
+    std::vector <double> sorted_scores;
+
+    /**
+     * @var std::vector <unsigned int> order
+     *
+     * @brief Columns in order of the score lost by taking their second best shift, least first.
+     *        Search positions index this order; taking the columns in it is what keeps every
+     *        step of the search from raising the score.
+     *
+     */
+    std::vector <unsigned int> order;
+
+    // Max-heap of queued keys, and the rank of every position's shift for each popped key
+    std::vector <Node> queue;
+    std::vector <unsigned char> ranks;
+
+    std::vector <KeyCandidate> candidates;
+    unsigned int candidate_count;
+
+    // Scratch space for rescore: the sampled text decrypted with one candidate
+    std::vector <unsigned char> plain;
+};
+
+#endif
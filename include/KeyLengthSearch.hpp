@@ -0,0 +1,171 @@
+/**
+ * @file KeyLengthSearch.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the KeyLengthSearch class, which ranks every candidate
+ *        Vigenere key length by the average index of coincidence of its columns and the
+ *        Kasiski evidence for it.
+ *
+ * @see KeyLengthSearch.cpp
+ *
+ */
+
+#ifndef KEYLENGTHSEARCH_HPP
+#define KEYLENGTHSEARCH_HPP
+
+#include "KasiskiSearch.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Longest key length considered unless another limit is given
+const unsigned int DEFAULT_MAX_PERIOD = 200;
+
+// A period is only considered if each of its columns would hold at least this many letters
+const unsigned int MIN_COLUMN_LETTERS = 12;
+
+// Expected IC of English text and of uniformly random letters
+const double ENGLISH_IC = 0.0660;
+const double RANDOM_IC = 1.0 / 26.0;
+
+/*
+ * Fraction of the way from RANDOM_IC to the best average IC that a period has to reach to be
+ * treated as a likely key length; multiples of the true length reach it as well, so the
+ * shortest such period is ranked first
+ */
+const double KEY_IC_THRESHOLD = 0.75;
+
+/*
+ * Weight of the Kasiski evidence against the IC evidence when a period is scored; both run from
+ * about 0 for random text up to about 1 for the key length
+ */
+const double KASISKI_WEIGHT = 0.25;
+
+/*
+ * Number of letters per column after which a period stops counting; the column ICs have settled
+ * well before this, so the cost of a search stops growing with the length of the text
+ */
+const std::uint64_t MAX_COLUMN_SAMPLE = 2048;
+
+// Number of letters each period walks before the sweep moves on to the next block of text
+const std::size_t PERIOD_SWEEP_BLOCK = 4096;
+
+/*
+ * Fewest letters for which a search is split across the thread pool. Handing work to the pool
+ * allocates its tasks, and a shorter text is counted in less time than that takes; batch and
+ * serve mode already keep every thread busy with a message of its own
+ */
+const std::size_t PARALLEL_MIN_LETTERS = 131072;
+
+
+/**
+ * @struct KeyLengthCandidate
+ *
+ * @brief A candidate key length, the average IC of the columns it splits the text into, the
+ *        Kasiski evidence for it and the score the two combine into.
+ *
+ */
+struct KeyLengthCandidate {
+    unsigned int period;
+    double average_IC;
+    double kasiski;
+    double score;
+};
+
+
+class KeyLengthSearch {
+public:
+
+    // Ctors
+    KeyLengthSearch (unsigned int max = DEFAULT_MAX_PERIOD);
+
+    // Search Functions
+    void reset (unsigned int limit = 0);
+    void count (const std::uint8_t*, std::size_t);
+    void rank ();
+    void search (const std::uint8_t*, std::size_t);
+    void merge (const std::uint64_t*, unsigned int, std::uint64_t, std::uint64_t);
+
+    // Mutators
+    void set_max_period (unsigned int);
+    void set_thread_pool (ThreadPool* pool) { thread_pool = pool; }
+    void set_expected_IC (double);
+
+    // Accessors
+    const std::vector <KeyLengthCandidate>& get_candidates () const { return candidates; }
+    unsigned int get_best_period () const
+        { return candidates.empty() ? 1 : candidates[0].period; }
+    unsigned int get_max_period () const { return max_period; }
+    unsigned int get_active_period () const { return active_period; }
+    const std::uint64_t* get_counts () const { return counts.data(); }
+    std::size_t get_table_size () const
+        { return LETTER_BINS * active_period * (active_period + 1) / 2; }
+    std::uint64_t get_letters_counted () const { return letters_counted; }
+    double get_average_IC (unsigned int) const;
+    double get_period_margin () const;
+    const KasiskiSearch& get_repeats () const { return repeats; }
+
+private:
+
+    void count_sample (const std::uint8_t*, std::size_t);
+    void count_periods (const std::uint8_t*, std::size_t, unsigned int, unsigned int);
+
+    /**
+     * @var std::vector <std::uint64_t> counts
+     *
+     * @brief Letter counts of every column of every period, stored back to back; period p starts
+     *        at LETTER_BINS * p * (p - 1) / 2.
+     *
+     */
+    std::vector <std::uint64_t> counts;
+
+    /**
+     * @var std::vector <unsigned int> next_column
+     *
+     * @brief Column the next letter counted falls into, for each period.
+     *
+     */
+    std::vector <unsigned int> next_column;
+
+    /**
+     * @var std::vector <std::uint64_t> letters_sampled
+     *
+     * @brief Number of letters counted so far by each period; capped at MAX_COLUMN_SAMPLE per
+     *        column.
+     *
+     */
+    std::vector <std::uint64_t> letters_sampled;
+
+    std::vector <double> average_IC;
+    std::vector <KeyLengthCandidate> candidates;
+    unsigned int max_period;
+
+    /**
+     * @var unsigned int active_period
+     *
+     * @brief Longest period being counted for the current text; at most max_period, and smaller
+     *        when the text is known in advance to be too short for longer keys.
+     *
+     */
+    unsigned int active_period;
+    std::uint64_t letters_counted;
+
+    // IC of the plaintext language, which a period's columns score 1 for reaching
+    double expected_IC;
+    ThreadPool* thread_pool;
+
+    /**
+     * @var KasiskiSearch repeats
+     *
+     * @brief Distances between repeated runs of letters, counted alongside the columns.
+     *
+     */
+    KasiskiSearch repeats;
+};
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file KeySegmenter.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the KeySegmenter class, which finds where the key of a
+ *        long Caesar or Vigenere capture changes and cracks every stretch between the changes on
+ *        its own, using a PrefixHistogramIndex of the capture.
+ *
+ * @see KeySegmenter.cpp
+ * @see PrefixHistogramIndex.hpp
+ *
+ */
+
+#ifndef KEYSEGMENTER_HPP
+#define KEYSEGMENTER_HPP
+
+#include "Histogram.hpp"
+#include "PrefixHistogramIndex.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * Letters per column in a window the key is read from; enough for the correlation to pick the
+ * right shift of almost every window of English. Windows are rounded up to whole strides of
+ * the index, so reading one never counts text by hand
+ */
+const std::size_t SEGMENT_COLUMN_LETTERS = 200;
+
+/*
+ * Number of windows in a row that must agree on a key before it counts as a segment. A window
+ * that straddles a change, or reads the wrong shift, stands alone and is passed over
+ */
+const unsigned int SEGMENT_MIN_WINDOWS = 2;
+
+
+/**
+ * @struct KeySegment
+ *
+ * @brief A stretch of the capture under one key: bytes begin to end - 1, and the key as if the
+ *        stretch had been encrypted from its own first letter on.
+ *
+ */
+struct KeySegment {
+    std::size_t begin;
+    std::size_t end;
+    std::string key;
+};
+
+
+class KeySegmenter {
+public:
+
+    // Ctors
+    KeySegmenter ();
+
+    // Processing Functions
+    void find_segments (const PrefixHistogramIndex&);
+    void decrypt (std::ostream&) const;
+
+    // Mutators
+    void set_column_letters (std::size_t letters) { column_letters = letters; }
+
+    // Accessors
+    const std::vector <KeySegment>& get_segments () const { return segments; }
+    std::size_t get_window_size () const { return window_size; }
+
+private:
+
+    /**
+     * @struct Run
+     *
+     * @brief Windows first to last, which all read the same shifts; offset is where the shifts
+     *        of the run start in window_shifts.
+     *
+     */
+    struct Run {
+        std::size_t first;
+        std::size_t last;
+        std::size_t offset;
+    };
+
+    void read_shifts (std::size_t, std::size_t, std::uint8_t*);
+    std::size_t find_change (std::size_t, std::size_t, const std::uint8_t*,
+                             const std::uint8_t*) const;
+
+    // Index of the capture being segmented; not owned
+    const PrefixHistogramIndex* index;
+
+    std::size_t column_letters;
+    std::size_t window_size;
+
+    /**
+     * @var std::vector <std::uint8_t> window_shifts
+     *
+     * @brief The shift of every column read from every window, period entries per window. Shifts
+     *        are by column of the whole capture, so equal keys compare equal wherever they start.
+     *
+     */
+    std::vector <std::uint8_t> window_shifts;
+
+    // Shifts of every segment, period entries per segment, by column of the whole capture
+    std::vector <std::uint8_t> segment_shifts;
+    std::vector <KeySegment> segments;
+
+    // Scratch space for the column histograms of a window
+    std::vector <std::uint64_t> counts;
+
+    // Log frequency of every plaintext letter, for placing a change to the letter
+    std::array <double, LETTER_BINS> log_frequencies;
+};
+
+#endif
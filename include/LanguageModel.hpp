@@ -0,0 +1,120 @@
+/**
+ * @file LanguageModel.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the LanguageModel class, which memory-maps a binary
+ *        model file holding the letter frequencies and n-gram tables of one language, and the
+ *        layout of those files.
+ *
+ * @see LanguageModel.cpp
+ *
+ */
+
+#ifndef LANGUAGEMODEL_HPP
+#define LANGUAGEMODEL_HPP
+
+#include "MappedFile.hpp"
+#include "NgramScorer.hpp"
+#include "ReferenceMatrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+// First bytes of every model file, and the version of the layout described by ModelHeader
+const char MODEL_MAGIC[8] = { 'C', 'C', 'M', 'O', 'D', 'E', 'L', '\0' };
+const std::uint32_t MODEL_FORMAT_VERSION = 1;
+
+// Written as a native integer so files from a machine of the other byte order are refused
+const std::uint32_t MODEL_BYTE_ORDER_MARK = 0x01020304;
+
+/*
+ * Every table starts on a multiple of this many bytes, so once the file is mapped (at a page
+ * boundary) the tables can be used in place by vector loads without copying
+ */
+const std::size_t MODEL_ALIGNMENT = 64;
+
+// Bytes reserved for the language name, including the terminating NUL
+const unsigned int MODEL_NAME_LENGTH = 32;
+
+// File name extension used for model files
+const char MODEL_FILE_EXTENSION[] = ".ccm";
+
+
+/**
+ * @struct ModelHeader
+ *
+ * @brief The start of a model file, padded out to MODEL_ALIGNMENT. Offsets are in bytes from
+ *        the start of the file; the tables they point at are:
+ *          frequencies: LETTER_BINS doubles, the share of each letter A-Z.
+ *          reference: a RotatedReference built from the frequencies.
+ *          bigrams, trigrams, quadgrams: BIGRAM_BINS, TRIGRAM_BINS and QUADGRAM_BINS float log10
+ *          probabilities, as built by NgramScorer::train.
+ *
+ */
+struct alignas (64) ModelHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t header_size;
+    std::uint64_t file_size;
+    char name[MODEL_NAME_LENGTH];
+    double expected_IC;
+    std::uint64_t training_letters;
+    std::uint64_t frequencies_offset;
+    std::uint64_t reference_offset;
+    std::uint64_t bigrams_offset;
+    std::uint64_t trigrams_offset;
+    std::uint64_t quadgrams_offset;
+};
+
+static_assert (sizeof (ModelHeader) == MODEL_ALIGNMENT * 2, "ModelHeader layout changed");
+
+
+class LanguageModel {
+public:
+
+    // Ctors
+    LanguageModel ();
+
+    LanguageModel (const LanguageModel&) = delete;
+    LanguageModel& operator= (const LanguageModel&) = delete;
+
+    // File Functions
+    bool open (const std::string&);
+    void close ();
+    static bool build (const std::string&, const std::string&, const char*, std::size_t);
+
+    // Accessors
+    bool is_open () const { return header != nullptr; }
+    const ModelHeader& get_header () const { return *header; }
+    const char* get_name () const { return header->name; }
+    double get_expected_IC () const { return header->expected_IC; }
+    std::uint64_t get_training_letters () const { return header->training_letters; }
+    const double* get_frequencies () const { return frequencies; }
+    const RotatedReference& get_reference () const { return *reference; }
+    const NgramScorer& get_scorer () const { return scorer; }
+
+private:
+
+    MappedFile file;
+
+    /**
+     * @var const ModelHeader* header
+     *
+     * @brief Start of the mapped file; nullptr while no model is open. The table pointers below
+     *        all point into the same mapping.
+     *
+     */
+    const ModelHeader* header;
+    const double* frequencies;
+    const RotatedReference* reference;
+
+    // Views the mapped n-gram tables in place
+    NgramScorer scorer;
+};
+
+#endif
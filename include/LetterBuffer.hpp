@@ -0,0 +1,74 @@
+/**
+ * @file LetterBuffer.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the LetterBuffer class, which normalizes a text into
+ *        the letter indices 0-25 that the Vigenere analysis kernels work on, and remembers
+ *        enough of the original to put its case, spacing and punctuation back afterwards.
+ *
+ * @see LetterBuffer.cpp
+ *
+ */
+
+#ifndef LETTERBUFFER_HPP
+#define LETTERBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class LetterBuffer {
+public:
+
+    // Ctors
+    LetterBuffer ();
+
+    // Normalization Functions
+    void normalize (const char*, std::size_t);
+    void normalize (const std::string& str) { normalize (str.data(), str.size()); }
+    void clear ();
+
+    // Reconstruction Functions
+    void write_letters (char*) const;
+    void restore (const char*, char*) const;
+
+    // Accessors
+    const std::uint8_t* get_letters () const { return letters.data(); }
+    std::size_t get_letter_count () const { return letter_count; }
+    std::size_t get_text_size () const { return text_size; }
+    std::size_t get_gap_count () const { return gap_count; }
+
+private:
+
+    /**
+     * @var std::vector <std::uint8_t> letters
+     *
+     * @brief Every letter of the text in order as its index, 0 for 'A' or 'a' up to 25; holds
+     *        letter_count entries. Storage is kept between texts.
+     *
+     */
+    std::vector <std::uint8_t> letters;
+    std::size_t letter_count;
+    std::size_t text_size;
+
+    // One bit per byte of the text, set where it held a lower case letter
+    std::vector <std::uint64_t> lower_case;
+
+    /**
+     * @var std::vector <std::size_t> gap_positions
+     *
+     * @brief Position map: the offset in the text of every byte that is not a letter, in order,
+     *        with the byte itself at the same index of gap_bytes. Both hold gap_count entries,
+     *        and grow with the number of gaps rather than the length of the text.
+     *
+     */
+    std::vector <std::size_t> gap_positions;
+    std::string gap_bytes;
+    std::size_t gap_count;
+};
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file MappedFile.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the MappedFile class, a read-only memory mapping of a file
+ *        that is meant to be consumed front to back in fixed-size chunks.
+ *
+ * @see MappedFile.cpp
+ *
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+
+// Number of bytes handed out per chunk when walking a mapped file
+const std::size_t FILE_CHUNK_SIZE = std::size_t (1) << 20;
+
+
+class MappedFile {
+public:
+
+    // Ctors
+    MappedFile ();
+    ~MappedFile ();
+
+    MappedFile (const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+
+    // File Functions
+    bool open (const std::string&, bool sequential = true);
+    void close ();
+    void release (std::size_t, std::size_t);
+
+    // Accessors
+    const char* get_data () const { return data; }
+    std::size_t get_size () const { return size; }
+    bool is_open () const { return file_descriptor >= 0; }
+
+private:
+
+    /**
+     * @var int file_descriptor
+     *
+     * @brief Descriptor of the open file; negative when no file is open.
+     *
+     */
+    int file_descriptor;
+
+    /**
+     * @var const char* data
+     *
+     * @brief Start of the mapping; nullptr for closed or empty files.
+     *
+     */
+    const char* data;
+    std::size_t size;
+};
+
+#endif
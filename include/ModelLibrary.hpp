@@ -0,0 +1,56 @@
+/**
+ * @file ModelLibrary.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the ModelLibrary class, which holds every language model
+ *        found in a directory, memory-mapped and ready to use.
+ *
+ * @see ModelLibrary.cpp
+ *
+ */
+
+#ifndef MODELLIBRARY_HPP
+#define MODELLIBRARY_HPP
+
+#include "LanguageModel.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class ModelLibrary {
+public:
+
+    // Ctors
+    ModelLibrary () = default;
+
+    ModelLibrary (const ModelLibrary&) = delete;
+    ModelLibrary& operator= (const ModelLibrary&) = delete;
+
+    // Loading Functions
+    bool load (const std::string&);
+    std::size_t load_directory (const std::string&);
+    void clear () { models.clear(); }
+
+    // Accessors
+    std::size_t get_count () const { return models.size(); }
+    const LanguageModel& get_model (std::size_t i) const { return *models[i]; }
+    const LanguageModel* find (const std::string&) const;
+
+private:
+
+    /**
+     * @var std::vector <std::unique_ptr <LanguageModel>> models
+     *
+     * @brief Every model loaded, in order of name. Held by pointer so engines can keep pointing
+     *        at a model while more are loaded.
+     *
+     */
+    std::vector <std::unique_ptr <LanguageModel>> models;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file MultiModelScorer.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the MultiModelScorer class, which scores every Caesar
+ *        shift of a letter histogram against several language models at once, to find the
+ *        plaintext language and the key together.
+ *
+ * @see MultiModelScorer.cpp
+ *
+ */
+
+#ifndef MULTIMODELSCORER_HPP
+#define MULTIMODELSCORER_HPP
+
+#include "ModelLibrary.hpp"
+#include "ReferenceMatrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/*
+ * Number of models scored together per block; a block's scores (MODEL_BLOCK * SHIFT_LANES
+ * doubles) stay in L1 while each histogram count is multiplied into the block's rows
+ */
+const unsigned int MODEL_BLOCK = 4;
+
+/*
+ * Smallest letter probability used when taking logs; a letter a sample text never contained
+ * would otherwise rule out its language on a single occurrence
+ */
+const double MODEL_PROBABILITY_FLOOR = 1e-5;
+
+
+/**
+ * @struct LanguageScore
+ *
+ * @brief The best key found for one language model and the average log10 likelihood per letter
+ *        of the ciphertext decrypted with it; higher is more likely.
+ *
+ */
+struct LanguageScore {
+    unsigned int model;
+    std::string key;
+    double score;
+};
+
+
+class MultiModelScorer {
+public:
+
+    // Ctors
+    MultiModelScorer () = default;
+
+    // Model Functions
+    void add_model (const std::string&, const double*);
+    void add_library (const ModelLibrary&);
+    void clear ();
+
+    // Scoring Functions
+    void score (const std::uint64_t*, double*) const;
+    void rank (const std::uint64_t*, std::vector <LanguageScore>&, std::vector <double>&) const;
+    static void sort_scores (std::vector <LanguageScore>&);
+
+    // Accessors
+    std::size_t get_model_count () const { return names.size(); }
+    const std::string& get_name (std::size_t m) const { return names[m]; }
+
+private:
+
+    /**
+     * @var std::vector <double> weights
+     *
+     * @brief Rotated log10 letter probabilities of every model, blocked MODEL_BLOCK models at a
+     *        time: block b, ciphertext letter e, model k of the block and shift i live at
+     *        ((b * LETTER_BINS + e) * MODEL_BLOCK + k) * SHIFT_LANES + i. Padding shifts and
+     *        padding models are zero.
+     *
+     */
+    std::vector <double> weights;
+    std::vector <std::string> names;
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file NgramScorer.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the NgramScorer class, which rates how much a run of
+ *        letters looks like a language using flat tables of bigram, trigram and quadgram
+ *        log-probabilities.
+ *
+ * @see NgramScorer.cpp
+ *
+ */
+
+#ifndef NGRAMSCORER_HPP
+#define NGRAMSCORER_HPP
+
+#include "Histogram.hpp"
+
+#include <cstddef>
+#include <vector>
+
+
+// Number of entries in each flat table; an n-gram's index is its letter codes read in base 26
+const unsigned int BIGRAM_BINS = LETTER_BINS * LETTER_BINS;
+const unsigned int TRIGRAM_BINS = BIGRAM_BINS * LETTER_BINS;
+const unsigned int QUADGRAM_BINS = TRIGRAM_BINS * LETTER_BINS;
+
+// Number of letters in the windows a text is scored over
+const unsigned int NGRAM_WINDOW = 4;
+
+/*
+ * log10 penalty applied each time an unseen n-gram falls back to a shorter one; training texts
+ * cannot contain every quadgram, so unseen ones are scored from their parts instead of a floor
+ */
+const float NGRAM_BACKOFF_PENALTY = -1.0f;
+
+
+class NgramScorer {
+public:
+
+    // Ctors
+    NgramScorer ();
+
+    NgramScorer (const NgramScorer&) = delete;
+    NgramScorer& operator= (const NgramScorer&) = delete;
+
+    // Table Functions
+    void train (const char*, std::size_t);
+    void set_tables (const float*, const float*, const float*);
+
+    // Scoring Functions
+    double score (const unsigned char*, std::size_t) const;
+    float score_quadgram (unsigned int index) const { return quadgrams[index]; }
+    static unsigned int pack_quadgram (const unsigned char* codes)
+        { return ((codes[0] * LETTER_BINS + codes[1]) * LETTER_BINS + codes[2]) * LETTER_BINS
+                 + codes[3]; }
+
+    // Accessors
+    bool is_loaded () const { return quadgrams != nullptr; }
+    const float* get_bigrams () const { return bigrams; }
+    const float* get_trigrams () const { return trigrams; }
+    const float* get_quadgrams () const { return quadgrams; }
+    static const NgramScorer& get_english ();
+
+private:
+
+    /**
+     * @var std::vector <float> tables
+     *
+     * @brief Storage for tables built by train; the bigram, trigram and quadgram tables are laid
+     *        out back to back. Empty when the tables are borrowed through set_tables.
+     *
+     */
+    std::vector <float> tables;
+
+    /*
+     * Views of the log10 probability tables; they point into tables or into memory owned by
+     * someone else, e.g. a mapped model file
+     */
+    const float* bigrams;
+    const float* trigrams;
+    const float* quadgrams;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file PrefixHistogramIndex.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the PrefixHistogramIndex class, which records running
+ *        letter counts of a text, split by column for a chosen period, so the histogram, IC and
+ *        best shifts of any part of the text come from two lookups instead of a new count.
+ *
+ * @see PrefixHistogramIndex.cpp
+ *
+ */
+
+#ifndef PREFIXHISTOGRAMINDEX_HPP
+#define PREFIXHISTOGRAMINDEX_HPP
+
+#include "Histogram.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/*
+ * Fewest bytes of text between two checkpoints of the index. A query counts at most two strides
+ * of text by hand, so the stride bounds its cost whatever the length of the part asked about
+ */
+const std::size_t PREFIX_INDEX_MIN_STRIDE = 256;
+
+/*
+ * The stride is raised for long periods until the text is at least this many times the size of
+ * the record saved per stride, so the index of a gigabyte log stays a small fraction of it
+ */
+const std::size_t PREFIX_INDEX_SIZE_RATIO = 8;
+
+/*
+ * Most bytes of text in a block. Checkpoints count from the start of their block, so no count
+ * in them passes this and 16 bits hold it; blocks start with full 64-bit counts. Once a block
+ * could not hold two strides, the checkpoints are left out and every stride starts a block of
+ * its own, whose 64-bit record the stride is then sized for
+ */
+const std::size_t PREFIX_INDEX_MAX_BLOCK = 65535;
+
+/*
+ * Longest period indexed. Past the checkpoints, the stride grows with the period to keep the
+ * size ratio, and so does the text a query counts by hand
+ */
+const unsigned int PREFIX_INDEX_MAX_PERIOD = 256;
+
+
+class PrefixHistogramIndex {
+public:
+
+    // Ctors
+    PrefixHistogramIndex ();
+
+    // Building Functions
+    bool build (const char*, std::size_t, unsigned int period = 1);
+    void clear ();
+
+    // Query Functions
+    void get_histogram (std::size_t, std::size_t, std::uint64_t*) const;
+    std::uint64_t get_letter_offset (std::size_t) const;
+    double get_IC (std::size_t, std::size_t) const;
+    unsigned int get_best_shift (std::size_t, std::size_t, unsigned int column = 0) const;
+    std::string get_key (std::size_t, std::size_t) const;
+
+    // Accessors
+    const char* get_text () const { return data; }
+    unsigned int get_period () const { return period; }
+    std::size_t get_stride () const { return stride; }
+    std::size_t get_text_size () const { return size; }
+    std::uint64_t get_letter_count () const { return get_letter_offset (size); }
+    std::size_t get_index_size () const
+    {
+        return blocks.size() * sizeof (std::uint64_t) +
+               checkpoints.size() * sizeof (std::uint16_t);
+    }
+
+private:
+
+    void add_counts_at (std::size_t, std::uint64_t*, std::uint64_t) const;
+
+    // The indexed text; not owned, and it must outlive the index
+    const char* data;
+    std::size_t size;
+
+    unsigned int period;
+    std::size_t stride;
+    std::size_t strides_per_block;
+
+    /*
+     * Number of entries in a record: the number of letters, then period rows of LETTER_BINS
+     * counts of those letters. Row r counts the letters whose position among the letters of the
+     * whole text is r modulo the period
+     */
+    std::size_t record_size;
+
+    /**
+     * @var std::vector <std::uint64_t> blocks
+     *
+     * @brief One record per block of strides_per_block strides, in order; record k counts the
+     *        letters before the start of block k.
+     *
+     */
+    std::vector <std::uint64_t> blocks;
+
+    /**
+     * @var std::vector <std::uint16_t> checkpoints
+     *
+     * @brief One record per stride, in order; record j counts the letters from the start of its
+     *        block to the start of stride j. A stride at the start of a block has all zeros.
+     *        Empty when strides_per_block is 1, as every record would be.
+     *
+     */
+    std::vector <std::uint16_t> checkpoints;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file ReferenceMatrix.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains the RotatedReference matrix, which holds every rotation of a reference letter
+ *        distribution so all 26 Caesar shifts can be scored with one matrix-vector product.
+ *
+ */
+
+#ifndef REFERENCEMATRIX_HPP
+#define REFERENCEMATRIX_HPP
+
+#include "Histogram.hpp"
+
+#include <cstdint>
+
+
+// Shifts are padded out to a whole number of vectors; the extra lanes always score zero
+const unsigned int SHIFT_LANES = 32;
+
+
+/**
+ * @struct RotatedReference
+ *
+ * @brief weights[e][i] is the reference frequency of the plaintext letter that ciphertext letter
+ *        e decrypts to under shift i, i.e. reference[(e - i) mod 26]. Each row is one rotation
+ *        of the reference distribution, padded with zeros to SHIFT_LANES.
+ *
+ */
+struct alignas (64) RotatedReference {
+    double weights[LETTER_BINS][SHIFT_LANES];
+};
+
+
+/**
+ * @fn build_rotated_reference
+ *
+ * @param reference: Frequencies of the letters A-Z in the expected plaintext language.
+ * @return The matrix of every rotation of reference.
+ *
+ * @brief Builds a RotatedReference; usable at compile time.
+ *
+ */
+constexpr RotatedReference build_rotated_reference (const double (&reference)[LETTER_BINS])
+{
+    RotatedReference matrix {};
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+    {
+        for (unsigned int i = 0; i < LETTER_BINS; i++)
+            matrix.weights[e][i] = reference[(LETTER_BINS + e - i) % LETTER_BINS];
+    }
+
+    return matrix;
+}
+
+/**
+ * @fn score_shifts
+ *
+ * @param matrix: Rotations of the reference distribution.
+ * @param letter_counts: Counts of the letters A-Z in the ciphertext.
+ * @param scale: Factor applied to every score, e.g. 1 / text length to score frequencies.
+ * @param scores: Receives SHIFT_LANES scores; only the first 26 are meaningful.
+ *
+ * @brief Scores every shift at once as scale * (letter_counts x matrix). Each ciphertext letter
+ *        adds a whole 32-wide row, which the compiler turns into straight vector multiply-adds.
+ *
+ */
+inline void score_shifts (const RotatedReference& matrix, const std::uint64_t* letter_counts,
+                          double scale, double* scores)
+{
+    alignas (64) double sums[SHIFT_LANES] = {};
+
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+    {
+        double count = (double)letter_counts[e];
+        const double* row = matrix.weights[e];
+        for (unsigned int i = 0; i < SHIFT_LANES; i++)
+            sums[i] += count * row[i];
+    }
+
+    for (unsigned int i = 0; i < SHIFT_LANES; i++)
+        scores[i] = sums[i] * scale;
+}
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file ResultCache.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the ResultCache class, a thread-safe cache of cracked
+ *        keys addressed by a 128-bit hash of the ciphertext, with an optional memory-mapped
+ *        tier on disk that outlives the process, and the layout of its files.
+ *
+ * @see ResultCache.cpp
+ *
+ */
+
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+/*
+ * Number of independently locked parts of the cache; a key's shard is picked by its hash, so
+ * threads looking up different ciphertexts rarely wait on each other
+ */
+const unsigned int CACHE_SHARDS = 16;
+
+// Number of results the in-memory tier holds by default
+const std::size_t DEFAULT_CACHE_ENTRIES = 65536;
+
+// Number of records a new disk tier is created with by default; 8 MiB of file
+const std::size_t DEFAULT_DISK_CACHE_SLOTS = 65536;
+
+// First bytes of every disk cache file, and the version of the layout described below
+const char DISK_CACHE_MAGIC[8] = { 'C', 'C', 'C', 'A', 'C', 'H', 'E', '\0' };
+const std::uint32_t DISK_CACHE_FORMAT_VERSION = 1;
+
+// Written as a native integer so files from a machine of the other byte order are refused
+const std::uint32_t DISK_CACHE_BYTE_ORDER_MARK = 0x01020304;
+
+// Longest key a disk record can hold; results with longer keys stay in memory only
+const unsigned int DISK_CACHE_KEY_LENGTH = 88;
+
+
+/**
+ * @struct CacheKey
+ *
+ * @brief A 128-bit hash of a ciphertext, the address of its result. The all-zero key marks an
+ *        empty disk record, so hash never returns it.
+ *
+ */
+struct CacheKey {
+    std::uint64_t low;
+    std::uint64_t high;
+
+    bool operator== (const CacheKey& other) const
+        { return (low == other.low) && (high == other.high); }
+};
+
+
+/**
+ * @struct CachedResult
+ *
+ * @brief What a crack found: the key (one symbol for a Caesar cipher), the key length, the IC
+ *        of the ciphertext and the score of the key chosen: its correlation frequency for a
+ *        Caesar cipher, its key length score for a Vigenere cipher.
+ *
+ */
+struct CachedResult {
+    std::string key;
+    unsigned int key_length;
+    double IC;
+    double score;
+};
+
+
+/**
+ * @struct DiskCacheHeader
+ *
+ * @brief The start of a disk cache file, padded to 64 bytes; slot_count DiskCacheRecords
+ *        follow it.
+ *
+ */
+struct alignas (64) DiskCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t header_size;
+    std::uint64_t record_size;
+    std::uint64_t slot_count;
+};
+
+/**
+ * @struct DiskCacheRecord
+ *
+ * @brief One cached result on disk. A record whose hash is all zero is empty. Writers clear the
+ *        hash first and set it last, and readers check it again after copying the record, so a
+ *        record being rewritten, even by another process, is never returned half written.
+ *
+ */
+struct DiskCacheRecord {
+    std::uint64_t hash_low;
+    std::uint64_t hash_high;
+    double IC;
+    double score;
+    std::uint32_t key_length;
+    std::uint32_t key_size;
+    char key[DISK_CACHE_KEY_LENGTH];
+};
+
+static_assert (sizeof (DiskCacheHeader) == 64, "DiskCacheHeader layout changed");
+static_assert (sizeof (DiskCacheRecord) == 128, "DiskCacheRecord layout changed");
+
+
+class ResultCache {
+public:
+
+    // Ctors
+    ResultCache (std::size_t capacity = DEFAULT_CACHE_ENTRIES);
+    ~ResultCache ();
+
+    ResultCache (const ResultCache&) = delete;
+    ResultCache& operator= (const ResultCache&) = delete;
+
+    // Cache Functions
+    static CacheKey hash (const void*, std::size_t, std::uint64_t);
+    bool lookup (const CacheKey&, CachedResult&);
+    void insert (const CacheKey&, const CachedResult&);
+
+    // Disk Functions
+    bool open_disk (const std::string&, std::size_t slots = DEFAULT_DISK_CACHE_SLOTS);
+    void close_disk ();
+
+    // Accessors
+    std::uint64_t get_hits () const { return hits; }
+    std::uint64_t get_disk_hits () const { return disk_hits; }
+    std::uint64_t get_misses () const { return misses; }
+    std::uint64_t get_evictions () const { return evictions; }
+    std::size_t get_capacity () const { return shard_capacity * CACHE_SHARDS; }
+    bool has_disk () const { return disk_records != nullptr; }
+
+private:
+
+    /**
+     * @struct KeyHasher
+     *
+     * @brief Hashes a CacheKey for the shard indexes; the key is already a hash, so half of it
+     *        will do.
+     *
+     */
+    struct KeyHasher {
+        std::size_t operator() (const CacheKey& key) const { return (std::size_t)key.high; }
+    };
+
+    struct Entry {
+        CacheKey key;
+        CachedResult result;
+    };
+
+    /**
+     * @struct Shard
+     *
+     * @brief One part of the in-memory tier: its entries from most to least recently used and
+     *        an index into them. The lock also guards the disk records the shard owns.
+     *
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::list <Entry> entries;
+        std::unordered_map <CacheKey, std::list <Entry>::iterator, KeyHasher> index;
+    };
+
+    Shard& shard_of (const CacheKey& key) { return shards[key.low % CACHE_SHARDS]; }
+    void remember (Shard&, const CacheKey&, const CachedResult&);
+    DiskCacheRecord* disk_record (const CacheKey&);
+
+    Shard shards[CACHE_SHARDS];
+    std::size_t shard_capacity;
+
+    std::atomic <std::uint64_t> hits;
+    std::atomic <std::uint64_t> disk_hits;
+    std::atomic <std::uint64_t> misses;
+    std::atomic <std::uint64_t> evictions;
+
+    /**
+     * @var DiskCacheRecord* disk_records
+     *
+     * @brief The records of the mapped disk tier, or nullptr. Records are direct-mapped: each
+     *        key has one slot, among those owned by its shard, and a newer result overwrites an
+     *        older one there.
+     *
+     */
+    DiskCacheRecord* disk_records;
+    std::size_t disk_slots;
+    void* disk_mapping;
+    std::size_t disk_mapping_size;
+};
+
+#endif
@@ -4,8 +4,8 @@
  * @author Drew Wheeler
  * @date 2023-02-11
  * 
- * @brief Contains class definitions for the StringAnalysis class, which is used to analyze the
- *        composition of strings.
+ * @brief Contains class definitions for the BasicStringAnalysis class template, which is used to
+ *        analyze the composition of strings, and StringAnalysis, its A-Z instantiation.
  * 
  * @see StringAnalysis.cpp
  * 
@@ -14,24 +14,37 @@
 #ifndef STRINGANALYSIS_HPP
 #define STRINGANALYSIS_HPP
 
+#include "Alphabet.hpp"
+#include "Histogram.hpp"
+
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <string>
 #include <vector>
 
 
-class StringAnalysis {
+template <class Alphabet>
+class BasicStringAnalysis {
 public:
 
     // Ctors
-    StringAnalysis ();
-    StringAnalysis (const std::string&);
+    BasicStringAnalysis ();
+    BasicStringAnalysis (const std::string&);
 
     // String Manipulation Functions
     void rm_data_string_char (char);
+    void append (const char*, std::size_t);
+    void append (const std::string& str) { append (str.data(), str.size()); }
+    void accumulate (const char*, std::size_t);
+    void accumulate_letters (const std::uint8_t*, std::size_t);
+    void accumulate (char c)
+        { char_instances.add (c); frequencies_generated = false; update_IC(); }
+    void reset ();
 
     // Analysis Functions
     void gen_char_instance_profile ();
+    void gen_letter_instance_profile (const std::uint8_t*, std::size_t);
     void gen_char_frequency_profile ();
     void calculate_IC ();
 
@@ -40,16 +53,26 @@ public:
     void print_frequency_profile ();
 
     // Mutators
-    void set_string (const std::string& str) { data_string = str; }
+    void set_string (const std::string& str) { reset(); data_string = str; }
 
     // Accessors
-    std::string get_string () { return data_string; }
+    const std::string& get_string () { return data_string; }
     unsigned int get_string_length () { return data_string.size(); }
+    std::uint64_t get_analyzed_length () { return char_instances.get_total(); }
     double get_IC () { return index_of_coincidence; }
-    double get_char_freq (char);
+    double get_char_freq (char c)
+    {
+        std::uint64_t total = char_instances.get_total();
+        return (total > 0) ? (double)char_instances.get_byte_count (c) / (double)total : 0.0;
+    }
+    const Histogram& get_histogram () { return char_instances; }
+    const std::uint64_t* get_symbol_counts ()
+        { return Alphabet::count_symbols (char_instances, symbol_counts.data()); }
 
 private:
 
+    void update_IC ();
+
     /**
      * @var std::string data_string
      *
@@ -65,8 +88,33 @@ private:
      */
     double index_of_coincidence;
 
-    std::vector <std::pair <char, unsigned int>> char_instances;
-    std::vector <std::pair <char, double>> char_frequencies;
+    /**
+     * @var Histogram char_instances
+     *
+     * @brief Number of instances of each character in data_string.
+     *
+     */
+    Histogram char_instances;
+
+    /**
+     * @var std::array <double, BYTE_BINS> char_frequencies
+     *
+     * @brief Frequency of each character in data_string, indexed by its byte value.
+     *
+     */
+    std::array <double, BYTE_BINS> char_frequencies;
+    bool frequencies_generated;
+
+    /**
+     * @var std::array <std::uint64_t, Alphabet::SIZE + 1> symbol_counts
+     *
+     * @brief Scratch space for get_symbol_counts when the alphabet has to fold the byte counts,
+     *        e.g. to count 'a' as 'A'; the last bin collects the bytes outside the alphabet.
+     *
+     */
+    std::array <std::uint64_t, Alphabet::SIZE + 1> symbol_counts;
 };
 
+typedef BasicStringAnalysis <UpperLatinAlphabet> StringAnalysis;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,177 @@
+/**
+ * @file SubstitutionSolver.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the SubstitutionSolver class, which recovers the key of
+ *        a general monoalphabetic substitution cipher, any permutation of A-Z, by hill climbing
+ *        on the quadgram fitness of the decryption from many restarts in parallel.
+ *
+ * @see SubstitutionSolver.cpp
+ *
+ */
+
+#ifndef SUBSTITUTIONSOLVER_HPP
+#define SUBSTITUTIONSOLVER_HPP
+
+#include "LanguageModel.hpp"
+#include "LetterBuffer.hpp"
+#include "NgramScorer.hpp"
+#include "ThreadPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Most hill climbs run for one ciphertext; fewer are run once enough of them agree
+const unsigned int DEFAULT_SUBSTITUTION_RESTARTS = 64;
+
+/*
+ * Number of climbs that must end on the same best key before the rest are skipped. Climbs that
+ * start apart and end on one key have almost always found the global maximum
+ */
+const unsigned int SUBSTITUTION_AGREEMENT = 3;
+
+/*
+ * Random swaps applied to the frequency-ordered key to start every climb after the first; enough
+ * to leave its local maximum, few enough to keep most of what the frequencies got right
+ */
+const unsigned int SUBSTITUTION_RESTART_SWAPS = 8;
+
+/*
+ * Number of letters of a file the key is solved from; a few hundred are usually enough, so the
+ * quadgram counts have long settled by then, and memory stays bounded however large the file
+ */
+const std::size_t SUBSTITUTION_SAMPLE_LETTERS = std::size_t (1) << 18;
+
+
+class SubstitutionSolver {
+public:
+
+    // Ctors
+    SubstitutionSolver ();
+
+    SubstitutionSolver (const SubstitutionSolver&) = delete;
+    SubstitutionSolver& operator= (const SubstitutionSolver&) = delete;
+
+    // Solving Functions
+    void solve (const std::string&);
+    void solve_letters (const std::uint8_t*, std::size_t);
+    void decrypt_letters (const std::uint8_t*, std::size_t, char*) const;
+
+    // Mutators
+    void set_thread_pool (ThreadPool* pool) { thread_pool = pool; }
+    void set_language_model (const LanguageModel*);
+    void set_max_restarts (unsigned int restarts) { max_restarts = restarts; }
+    void set_seed (std::uint64_t value) { seed = value; }
+
+    // Accessors
+    std::string get_key () const;
+    const std::string& get_plaintext () const { return plaintext; }
+    const LetterBuffer& get_letters () const { return letters; }
+    double get_fitness () const;
+    unsigned int get_restarts_run () const { return restarts_run; }
+    unsigned int get_agreement () const { return agreement; }
+
+private:
+
+    /**
+     * @struct Quadgram
+     *
+     * @brief One distinct quadgram of the ciphertext, as its four letter indices, and the number
+     *        of times it occurs. A key is scored from these alone, never from the text.
+     *
+     */
+    struct Quadgram {
+        std::uint8_t codes[NGRAM_WINDOW];
+        std::uint64_t count;
+    };
+
+    /**
+     * @struct Climb
+     *
+     * @brief The state of one hill climb: its decryption key, the weighted score of every
+     *        distinct quadgram under that key, and scratch space for the scores a swap changes.
+     *
+     */
+    struct Climb {
+        std::array <std::uint8_t, LETTER_BINS> key;
+        std::vector <double> scores;
+        std::vector <double> changed;
+        double fitness;
+    };
+
+    /**
+     * @struct ClimbResult
+     *
+     * @brief The key and fitness a climb ended on, kept until every climb before it has ended so
+     *        the climbs are weighed in restart order, whichever thread finished first.
+     *
+     */
+    struct ClimbResult {
+        std::array <std::uint8_t, LETTER_BINS> key;
+        double fitness;
+        bool done;
+    };
+
+    void count_quadgrams (const std::uint8_t*, std::size_t);
+    void order_by_frequency (const std::uint8_t*, std::size_t);
+    void climb (Climb&) const;
+    void place_absent_letters ();
+    double score_quadgram (const Quadgram&, const std::uint8_t*) const;
+
+    // Quadgram tables and letter frequencies of the plaintext language; not owned
+    const NgramScorer* scorer;
+    const double* frequencies;
+
+    // Optional pool the climbs are spread across; not owned
+    ThreadPool* thread_pool;
+
+    unsigned int max_restarts;
+    std::uint64_t seed;
+
+    /**
+     * @var std::vector <Quadgram> quadgrams
+     *
+     * @brief The distinct quadgrams of the ciphertext, sorted by their packed index.
+     *
+     */
+    std::vector <Quadgram> quadgrams;
+
+    // Scratch space for count_quadgrams: the packed index of every quadgram of a short text
+    std::vector <std::uint32_t> packed;
+
+    /**
+     * @var std::vector <std::uint32_t> containing
+     *
+     * @brief For every cipher letter, the quadgrams it occurs in, from
+     *        containing[first_containing[c]] up to containing[first_containing[c + 1]]. A swap of
+     *        two letters only rescores these.
+     *
+     */
+    std::vector <std::uint32_t> containing;
+    std::array <std::uint32_t, LETTER_BINS + 1> first_containing;
+
+    // Decryption key of the first climb: cipher letters in frequency order mapped to plain ones
+    std::array <std::uint8_t, LETTER_BINS> frequency_key;
+
+    // Best decryption key found, cipher letter to plain letter, and its total quadgram score
+    std::array <std::uint8_t, LETTER_BINS> best_key;
+    double best_fitness;
+    std::uint64_t quadgram_total;
+
+    unsigned int restarts_run;
+    unsigned int agreement;
+
+    // Result of every climb by restart number, for the climbs of the current text
+    std::vector <ClimbResult> results;
+
+    LetterBuffer letters;
+    std::string plaintext;
+};
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file ThreadPool.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains class definitions for the ThreadPool class, a fixed-size work-stealing pool
+ *        that runs the engine's parallel work.
+ *
+ * @see ThreadPool.cpp
+ *
+ */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class ThreadPool {
+public:
+
+    // Ctors
+    ThreadPool (unsigned int threads = 0);
+    ~ThreadPool ();
+
+    ThreadPool (const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    // Task Functions
+    void submit (std::function <void()>);
+    void parallel_for (std::size_t, const std::function <void(std::size_t)>&);
+    void wait_idle ();
+
+    // Accessors
+    unsigned int get_thread_count () const { return workers.size(); }
+
+private:
+
+    /**
+     * @struct WorkerQueue
+     *
+     * @brief Tasks owned by one worker. The owner takes from the back; idle workers steal from
+     *        the front.
+     *
+     */
+    struct WorkerQueue {
+        std::mutex queue_mutex;
+        std::deque <std::function <void()>> tasks;
+    };
+
+    void worker_loop (unsigned int);
+    bool take_task (unsigned int, std::function <void()>&);
+
+    std::vector <std::unique_ptr <WorkerQueue>> queues;
+    std::vector <std::thread> workers;
+
+    // Bookkeeping shared by all workers
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_idle;
+    std::size_t queued_tasks;
+    std::size_t unfinished_tasks;
+    unsigned int next_queue;
+    bool stopping;
+};
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * @file TrainingText.hpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Declares the English sample text the built-in n-gram tables are trained on.
+ *
+ * @see TrainingText.cpp
+ *
+ */
+
+#ifndef TRAININGTEXT_HPP
+#define TRAININGTEXT_HPP
+
+#include <cstddef>
+
+
+// Plain English prose, mixed case and punctuated; only its letters are used for training
+extern const char ENGLISH_TRAINING_TEXT[];
+extern const std::size_t ENGLISH_TRAINING_TEXT_LENGTH;
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file caesarcrack.h
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief The C interface of libcaesarcrack, for hosts that embed the cracker rather than run the
+ *        decrypt executable. Every buffer belongs to the caller: ciphertext is read where it is
+ *        and plaintext and keys are written straight into the caller's memory. An engine handle
+ *        keeps its threads and working memory between calls, so a host reuses one for many
+ *        messages rather than creating one per message.
+ *
+ *        The interface is plain C99 and its structs have fixed layouts; a host checks
+ *        cc_api_version and cc_message_size against the values it was compiled with before its
+ *        first call.
+ *
+ * @see caesarcrack.cpp
+ *
+ */
+
+#ifndef CAESARCRACK_H
+#define CAESARCRACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Version of this interface; raised whenever a struct or a signature changes */
+#define CC_API_VERSION 1
+
+/* Ciphers an engine cracks. Caesar works on upper case letters, as `decrypt batch` does */
+#define CC_MODE_CAESAR 0
+#define CC_MODE_VIGENERE 1
+#define CC_MODE_SUBSTITUTION 2
+
+/*
+ * Engine flag: Vigenere and substitution plaintext keeps the case, spacing and punctuation of the
+ * ciphertext rather than being upper case letters alone. Caesar plaintext always keeps them
+ */
+#define CC_KEEP_LAYOUT 0x1u
+
+/* Status of a call or of one message */
+#define CC_OK 0
+#define CC_ERROR_ARGUMENT 1
+#define CC_ERROR_BUFFER_TOO_SMALL 2
+#define CC_ERROR_MODE 3
+#define CC_ERROR_INTERNAL 4
+
+/* Opaque engine handle; one thread at a time may use a handle */
+typedef struct cc_engine cc_engine;
+
+/**
+ * @struct cc_message
+ *
+ * @brief One message to be cracked. The caller fills in the first six fields; the rest are
+ *        written by cc_crack. A plaintext_capacity of ciphertext_length always suffices, and
+ *        plaintext may point at the ciphertext itself to decrypt it in place. On
+ *        CC_ERROR_BUFFER_TOO_SMALL, plaintext_length or key_length holds the size needed.
+ *
+ */
+typedef struct cc_message {
+    const char* ciphertext;
+    uint64_t ciphertext_length;
+    char* plaintext;
+    uint64_t plaintext_capacity;
+    char* key;
+    uint64_t key_capacity;
+
+    uint64_t plaintext_length;
+    uint64_t key_length;
+    int32_t status;
+    uint32_t reserved;
+} cc_message;
+
+/**
+ * @struct cc_analysis
+ *
+ * @brief Letter counts of a text, A-Z with either case folded together, the number of letters
+ *        and the index of coincidence of the letters.
+ *
+ */
+typedef struct cc_analysis {
+    uint64_t counts[26];
+    uint64_t letters;
+    double ic;
+} cc_analysis;
+
+int cc_api_version (void);
+size_t cc_message_size (void);
+
+cc_engine* cc_engine_create (int mode, unsigned int flags, unsigned int threads);
+void cc_engine_destroy (cc_engine* engine);
+
+int cc_crack (cc_engine* engine, cc_message* message);
+size_t cc_crack_batch (cc_engine* engine, cc_message* messages, size_t count);
+
+int cc_analyze (const char* text, uint64_t length, cc_analysis* analysis);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
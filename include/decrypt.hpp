@@ -3,7 +3,8 @@
  * @author Drew Wheeler
  * @date 2023-02-12
  * 
- * @brief Contains definitions for the DecryptEngine class and a few reference tables.
+ * @brief Contains definitions for the BasicDecryptEngine class template, DecryptEngine (its A-Z
+ *        instantiation) and a few reference tables.
  * 
  * @see decrypt.cpp
  * 
@@ -13,41 +14,119 @@
 #ifndef DECRYPT_H
 #define DECRYPT_H
 
+#include "Alphabet.hpp"
+#include "ColumnHistograms.hpp"
+#include "EngineStats.hpp"
+#include "KeyEnumerator.hpp"
+#include "KeyLengthSearch.hpp"
+#include "LanguageModel.hpp"
+#include "LetterBuffer.hpp"
+#include "MappedFile.hpp"
+#include "MultiModelScorer.hpp"
+#include "NgramScorer.hpp"
+#include "ReferenceMatrix.hpp"
+#include "ResultCache.hpp"
 #include "StringAnalysis.hpp"
+#include "ThreadPool.hpp"
 
 #include <cmath>
+#include <ostream>
+
+// Every rotation of ALPHABET_FREQUENCIES, built at compile time for scoring all shifts at once
+constexpr RotatedReference ROTATED_ALPHABET_FREQUENCIES =
+    build_rotated_reference (ALPHABET_FREQUENCIES);
+
+// Upper bound on the key length the engine is willing to work with when splitting a ciphertext
+const unsigned int MAX_KEY_LENGTH = 256;
+
+// Smallest key length for which the columns are solved on the thread pool instead of inline
+const unsigned int PARALLEL_COLUMN_THRESHOLD = 32;
 
-// Frequencies of each letter of the alphabet (ignoring case)
-const double ALPHABET_FREQUENCIES[] = { 0.080, 0.015, 0.030, 0.040, 0.130, 0.020, 0.015, 0.060,
-                                        0.065, 0.005, 0.005, 0.035, 0.030, 0.070, 0.080, 0.020,
-                                        0.002, 0.065, 0.060, 0.090, 0.030, 0.010, 0.015, 0.005,
-                                        0.020, 0.002};
 /*
- * Index of Coincidence table correlating IC values with key length; the index of the value
- * corresponds to the key length (i.e. [3] = key length of 3
+ * Letters per column above which the correlation alone picks the right shift almost every time;
+ * keys are only refined with n-grams when some column is shorter than this
  */
-const unsigned int IC_TABLE_SIZE = 12; 
-const double IC_KEY_SIZE_TABLE[] = { 1.0000, 0.0660, 0.0520, 0.0473, 0.0449, 0.0435, 0.0426, 0.0419,
-                                     0.0414, 0.0410, 0.0407, 0.0388 };
+const unsigned int REFINE_MAX_COLUMN_LETTERS = 100;
+
+// Letters per column read by the refinement; quadgrams settle a shift long before this
+const unsigned int REFINE_SAMPLE_COLUMN_LETTERS = 40;
+
+// Number of shifts per column tried while refining, taken in order of correlation frequency
+const unsigned int REFINE_CANDIDATE_SHIFTS = 6;
+
+// Upper bound on the passes over the key made while refining it
+const unsigned int REFINE_MAX_SWEEPS = 3;
 
+// Number of enumerated keys, from the best, that are rescored against the text by default
+const unsigned int ENUMERATE_RESCORED_KEYS = 8;
 
-class DecryptEngine {
+// Size of the first prefix analyzed when sampling; each later step doubles the prefix
+const std::size_t SAMPLE_FIRST_BYTES = 4096;
+
+/*
+ * Most letters of a file a sampled Vigenere crack holds in memory; a file whose key is still
+ * unclear once this many letters have been sampled is cracked in full instead
+ */
+const std::size_t SAMPLE_MAX_LETTERS = std::size_t (1) << 26;
+
+/*
+ * Lowest key length score a Vigenere sample may settle on. Random text scores 0 and text in the
+ * plaintext language 1, so a prefix too short to show the key length never settles on noise
+ */
+const double SAMPLE_MIN_PERIOD_SCORE = 0.5;
+
+/*
+ * Hash seeds that keep the cached results of the two cipher modes apart. The alphabet, language
+ * model, key length limit and sample margin of the engine are folded in on top of them
+ */
+const std::uint64_t CACHE_SEED_CAESAR = 0x4341455341520000ULL;
+const std::uint64_t CACHE_SEED_VIGENERE = 0x5649474E45520000ULL;
+
+
+/**
+ * @class BasicDecryptEngine
+ *
+ * @brief Cracks shift ciphers over the symbols of Alphabet (see Alphabet.hpp). The Caesar
+ *        functions, analysis, output functions and their file versions work for every alphabet;
+ *        the Vigenere solver, key length search, n-gram refinement and language detection work
+ *        on the letters A-Z and are only compiled for DecryptEngine.
+ *
+ */
+template <class Alphabet>
+class BasicDecryptEngine {
 public:
 
     // Ctors
-    DecryptEngine ()
+    BasicDecryptEngine ()
     {
-        ciphertext_info = StringAnalysis();
+        ciphertext_info = BasicStringAnalysis <Alphabet>();
+        thread_pool = nullptr;
+        language_model = nullptr;
+        instrumentation_enabled = false;
+        sample_margin = 0.0;
+        sampled_length = 0;
+        result_cache = nullptr;
+        cache_hit = false;
+        key_score = 0.0;
         highest_correlation = 0;
         plaintext = "";
         key_length = 0;
         calculated_key = "";
+        message_allocation_mark = get_thread_allocations();
     }
 
-    DecryptEngine (const std::string& str)
+    BasicDecryptEngine (const std::string& str)
     {
-        ciphertext_info = StringAnalysis (str);
-        for (unsigned int i = 0; i < 26; i++)
+        ciphertext_info = BasicStringAnalysis <Alphabet> (str);
+        thread_pool = nullptr;
+        language_model = nullptr;
+        instrumentation_enabled = false;
+        sample_margin = 0.0;
+        sampled_length = 0;
+        result_cache = nullptr;
+        cache_hit = false;
+        key_score = 0.0;
+        for (unsigned int i = 0; i < Alphabet::SIZE; i++)
         {
             correlation_frequency[i] = 0.0;
         }
@@ -55,6 +134,7 @@ public:
         plaintext = "";
         key_length = 0;
         calculated_key = "";
+        message_allocation_mark = get_thread_allocations();
     }
 
     // Deciphering Methods
@@ -62,42 +142,235 @@ public:
     void decrypt_caesar_cipher (char);
     char decrypt_caesar_cipher (char, char);
     void calc_key_length();
-    void split_ciphertext();
+    void search_key_length (const std::uint8_t*, std::size_t);
     void analyze_ciphertext ();
-    void decrypt_vigenere_cipher (std::string, std::string);
+    void decrypt_vigenere_cipher (const std::string&, const std::string&);
     void process_caesar ();
     void process_vigenere ();
+    void solve_columns (const std::uint8_t*, std::size_t);
+    void refine_key (const std::uint8_t*, std::size_t);
+    void restore_plaintext_layout ();
+    void enumerate_keys (unsigned int, unsigned int rescore = 0);
+    void append_ciphertext (const char*, std::size_t);
+    void detect_caesar_language (const MultiModelScorer&);
+    void detect_vigenere_language (const MultiModelScorer&);
+    static unsigned int calc_column_correlations (const std::uint64_t*, std::uint64_t, double*,
+                                                  const RotatedReference& reference =
+                                                      ROTATED_ALPHABET_FREQUENCIES);
+
+    // Buffer Methods
+    void process_caesar_buffer (const char*, std::size_t);
+    void decrypt_caesar_buffer (const char*, std::size_t, char*) const;
+    void process_vigenere_buffer (const char*, std::size_t);
+    std::size_t decrypt_vigenere_buffer (char*, bool keep_layout = false) const;
+    std::size_t get_letter_count () const { return ciphertext_letters.get_letter_count(); }
+    std::size_t get_text_size () const { return ciphertext_letters.get_text_size(); }
+
+    // File Input Methods
+    bool open_ciphertext_file (const std::string&);
+    void process_caesar_file ();
+    void process_vigenere_file ();
+    void stream_caesar_plaintext (std::ostream&);
+    void stream_vigenere_plaintext (std::ostream&, bool keep_layout = false);
 
     // Output Functions
     void print_correlations();
-    void print_deciphered_caesars();
+    void print_deciphered_caesars (unsigned int top_k = Alphabet::SIZE);
     void print_plaintext() { std::cout << plaintext << '\n'; }
     void print_decrypted_high_corr();
     void print_vigenere_info();
 
+    // Instrumentation
+    void enable_instrumentation (bool enable) { instrumentation_enabled = enable; }
+    void reset_stats () { stats.reset(); }
+    const EngineStats& get_stats () const { return stats; }
+    std::string get_stats_json () const { return stats.to_json(); }
+
     // Mutators
-    void set_ciphertext (const std::string& str){ ciphertext_info.set_string (str); }
+    void reset ();
+    void set_ciphertext (const std::string& str)
+        { reset(); ciphertext_info.set_string (str); stats.set_message_size (str.size()); }
+    void clear_ciphertext () { reset(); }
+    void set_thread_pool (ThreadPool* pool)
+        { thread_pool = pool; key_search.set_thread_pool (pool); }
+    void set_max_key_length (unsigned int max) { key_search.set_max_period (max); }
+    void set_language_model (const LanguageModel*);
+    void set_sample_margin (double margin) { sample_margin = margin; }
+    void set_result_cache (ResultCache* cache) { result_cache = cache; }
+    void set_calculated_key (const std::string& key)
+        { calculated_key = key; key_length = key.size(); }
 
     // Accessors
-    std::string get_plaintext () { return plaintext; }
+    const std::string& get_plaintext () const { return plaintext; }
+    const std::string& get_calculated_key () const { return calculated_key; }
     std::string get_ciphertext () { return ciphertext_info.get_string(); }
-    double get_IC () { return ciphertext_info.get_IC(); }
-    char most_likely_key() { return (char)highest_correlation + 'A'; }
+    double get_IC () { return cache_hit ? cache_entry.IC : ciphertext_info.get_IC(); }
+    double get_key_score () const { return key_score; }
+    char most_likely_key() { return (char)Alphabet::TABLE.symbols[highest_correlation]; }
+    unsigned int most_likely_shift () const { return highest_correlation; }
+    unsigned int get_key_length () { return key_length; }
+    const std::vector <KeyLengthCandidate>& get_key_length_candidates ()
+        { return key_search.get_candidates(); }
+    const LanguageModel* get_language_model () const { return language_model; }
+    const std::vector <LanguageScore>& get_language_scores () const { return language_scores; }
+    const std::vector <KeyCandidate>& get_key_candidates () const
+        { return key_enumerator.get_candidates(); }
+    std::uint64_t get_message_allocations () const
+        { return get_thread_allocations() - message_allocation_mark; }
+    std::uint64_t get_sampled_length () const { return sampled_length; }
+    bool is_cache_hit () const { return cache_hit; }
+    const CachedResult& get_cache_entry () const { return cache_entry; }
 
 private:
 
-    StringAnalysis ciphertext_info;
-    double correlation_frequency[26];
+    void select_highest_correlation ();
+    void solve_vigenere (const char*, std::size_t);
+    void reserve_key_scratch ();
+    std::size_t sample_caesar (const char*, std::size_t);
+    std::size_t sample_vigenere (const std::uint8_t*, std::size_t);
+    bool sample_vigenere_file ();
+    bool vigenere_settled () const;
+    static double runner_up_margin (const double*, unsigned int);
+    std::uint64_t cache_seed (std::uint64_t) const;
+    bool find_cached (const void*, std::size_t, std::uint64_t);
+    void store_cached (const char*, std::size_t);
+    static unsigned int key_shift (char key)
+        { return Alphabet::TABLE.bins[(unsigned char)key] % Alphabet::SIZE; }
+    static void rank_shifts (const double*, unsigned int*);
+    EngineStats* active_stats () { return instrumentation_enabled ? &stats : nullptr; }
+    const RotatedReference& active_reference () const
+        { return (language_model != nullptr) ? language_model->get_reference()
+                                             : ROTATED_ALPHABET_FREQUENCIES; }
+    const NgramScorer& active_scorer () const
+        { return (language_model != nullptr) ? language_model->get_scorer()
+                                             : NgramScorer::get_english(); }
+
+    BasicStringAnalysis <Alphabet> ciphertext_info;
+
+    /**
+     * @var LetterBuffer ciphertext_letters
+     *
+     * @brief The letters of the Vigenere ciphertext as indices 0-25, which every Vigenere stage
+     *        works on, and the map that puts the rest of the ciphertext back around them.
+     *
+     */
+    LetterBuffer ciphertext_letters;
+    double correlation_frequency[Alphabet::SIZE];
     unsigned int highest_correlation;
 
-    // Output variable for decryption methods
+    // Output variable for decryption methods, and scratch space for restoring its layout
     std::string plaintext;
+    std::string layout_plaintext;
 
     // Used mostly for the Vigenere cipher
     unsigned int key_length;
-    std::vector <std::string> split_alphabet;
     std::string calculated_key;
+    KeyLengthSearch key_search;
+
+    // Scratch space for the columnar solver; sized once and reused between messages
+    ColumnHistograms column_counts;
+    std::vector <double> column_correlations;
+
+    /**
+     * @struct RefineWindow
+     *
+     * @brief A quadgram window rescored by refine_key. When weight is non-zero the window holds
+     *        one letter of the column being changed, at index, and scores as the quadgram at
+     *        base + letter * weight; otherwise the window starting at index is packed in full.
+     *
+     */
+    struct RefineWindow {
+        unsigned int base;
+        unsigned int weight;
+        unsigned int index;
+    };
+
+    // Scratch space for refine_key: sampled letters, their decryption and their column order
+    std::vector <unsigned char> refine_cipher;
+    std::vector <unsigned char> refine_plain;
+    std::vector <unsigned int> refine_columns;
+    std::vector <unsigned int> refine_order;
+    std::vector <unsigned int> refine_offsets;
+    std::vector <unsigned int> refine_fill;
+    std::vector <unsigned int> refine_candidates;
+    std::vector <unsigned char> refine_dirty;
+    std::vector <RefineWindow> refine_windows;
+
+    // Lists the runners-up to calculated_key from the same column correlations
+    KeyEnumerator key_enumerator;
+
+    /**
+     * @var double sample_margin
+     *
+     * @brief Confidence margin for sampling; 0 analyzes the whole ciphertext. Otherwise the
+     *        analysis reads a growing prefix and stops once the best shift of every column, and
+     *        the best key length, lead their runners-up by this fraction of their own score.
+     *
+     */
+    double sample_margin;
+
+    // Bytes (Caesar) or letters (Vigenere) of the ciphertext the key was chosen from, and the
+    // letters of a sampled file
+    std::uint64_t sampled_length;
+    std::vector <std::uint8_t> sample_letters;
+
+    /**
+     * @var ResultCache* result_cache
+     *
+     * @brief Optional cache of earlier results; not owned, and may be shared by many engines
+     *        and, through its disk tier, by later runs. Results are addressed by the normalized
+     *        ciphertext and the settings that decide the key, so engines with another alphabet,
+     *        language model, key length limit or sample margin never see each other's results.
+     *
+     */
+    ResultCache* result_cache;
+
+    // Address of the current message in the cache, and its result: found there or stored
+    CacheKey cache_key;
+    CachedResult cache_entry;
+    bool cache_hit;
+
+    // Symbol numbers of a Caesar ciphertext, which address it in the cache
+    std::vector <std::uint8_t> cache_symbols;
+
+    // Score of the key found, as kept in CachedResult, whether found or taken from the cache
+    double key_score;
+
+    // Optional pool used to solve the columns of long keys in parallel; not owned
+    ThreadPool* thread_pool;
+
+    /**
+     * @var const LanguageModel* language_model
+     *
+     * @brief Model of the plaintext language; not owned. When nullptr the built-in English
+     *        tables are used.
+     *
+     */
+    const LanguageModel* language_model;
+
+    // Ranking of the candidate languages and scratch space for scoring them
+    std::vector <LanguageScore> language_scores;
+    std::vector <double> language_matrix;
+
+    // Input source for ciphertexts that are read from disk instead of held in memory
+    MappedFile ciphertext_file;
+
+    // Per-stage timings, byte counts and allocations; only recorded while instrumentation is on
+    EngineStats stats;
+    bool instrumentation_enabled;
+
+    /**
+     * @var std::uint64_t message_allocation_mark
+     *
+     * @brief Allocation count of the calling thread when the current message was set. Every
+     *        buffer above keeps its capacity across reset, so once an engine has seen a message
+     *        as long as the next, cracking it should not allocate at all.
+     *
+     */
+    std::uint64_t message_allocation_mark;
 
 };
 
+typedef BasicDecryptEngine <UpperLatinAlphabet> DecryptEngine;
+
 #endif
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+Load generator for `decrypt serve`.
+
+Opens several connections to a running server, keeps a fixed number of requests in flight on
+each one, and reports throughput, latency percentiles and how many keys came back right. Every
+ciphertext is generated from a seeded word list, so runs are repeatable.
+
+Usage: loadgen.py <socket> [--mode caesar|vigenere] [--connections N] [--depth N]
+                  [--requests N] [--length CHARS] [--seed N]
+"""
+
+import argparse
+import random
+import socket
+import struct
+import threading
+import time
+
+# Must match CrackProtocol.hpp
+HEADER = struct.Struct("<IIB3x")
+KINDS = {"caesar": ord("C"), "vigenere": ord("V")}
+FRAME_OK = 0
+
+WORDS = ("THE OF AND TO IN IS YOU THAT IT HE WAS FOR ON ARE AS WITH HIS THEY AT BE THIS "
+         "HAVE FROM OR ONE HAD BY WORD BUT NOT WHAT ALL WERE WE WHEN YOUR CAN SAID THERE "
+         "USE EACH WHICH SHE DO HOW THEIR IF WILL UP OTHER ABOUT OUT MANY THEN THEM THESE "
+         "SO SOME HER WOULD MAKE LIKE HIM INTO TIME HAS LOOK TWO MORE WRITE GO SEE NUMBER "
+         "NO WAY COULD PEOPLE MY THAN FIRST WATER BEEN CALL WHO OIL ITS NOW FIND LONG DOWN "
+         "DAY DID GET COME MADE MAY PART").split()
+
+
+def make_message(rng, mode, length):
+    """Returns (ciphertext, key) for a random plaintext of about length characters."""
+    words = []
+    while sum(len(w) + 1 for w in words) < length:
+        words.append(rng.choice(WORDS))
+    plaintext = " ".join(words)[:length]
+
+    if mode == "caesar":
+        key = chr(ord("A") + rng.randrange(26))
+    else:
+        key = "".join(chr(ord("A") + rng.randrange(26)) for _ in range(rng.randint(3, 8)))
+
+    # Vigenere keys advance on letters only, as the engine removes spaces before solving
+    out, k = [], 0
+    for c in plaintext:
+        if "A" <= c <= "Z":
+            shift = ord(key[k % len(key)]) - ord("A")
+            out.append(chr((ord(c) - ord("A") + shift) % 26 + ord("A")))
+            k += 1
+        else:
+            out.append(c)
+    return "".join(out), key
+
+
+def read_exact(sock, n):
+    data = bytearray()
+    while len(data) < n:
+        chunk = sock.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("server closed the connection")
+        data += chunk
+    return bytes(data)
+
+
+def run_connection(args, index, latencies, totals, lock):
+    rng = random.Random(args.seed * 1000 + index)
+    messages = [make_message(rng, args.mode, args.length) for _ in range(args.requests)]
+    kind = KINDS[args.mode]
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.connect(args.socket)
+
+    sent_at = {}
+    next_to_send = 0
+    received = 0
+    correct = 0
+    local = []
+
+    while received < len(messages):
+        # Top up the pipeline, then wait for one answer
+        while next_to_send < len(messages) and next_to_send - received < args.depth:
+            ciphertext = messages[next_to_send][0].encode()
+            sent_at[next_to_send] = time.perf_counter()
+            sock.sendall(HEADER.pack(len(ciphertext), next_to_send, kind) + ciphertext)
+            next_to_send += 1
+
+        length, request_id, status = HEADER.unpack(read_exact(sock, HEADER.size))
+        payload = read_exact(sock, length).decode() if length else ""
+        local.append(time.perf_counter() - sent_at.pop(request_id))
+        received += 1
+
+        if status == FRAME_OK and payload.split("\t", 1)[0] == messages[request_id][1]:
+            correct += 1
+
+    sock.close()
+    with lock:
+        latencies.extend(local)
+        totals["correct"] += correct
+
+
+def percentile(values, p):
+    return values[min(len(values) - 1, int(p / 100.0 * len(values)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("socket")
+    parser.add_argument("--mode", choices=sorted(KINDS), default="caesar")
+    parser.add_argument("--connections", type=int, default=4)
+    parser.add_argument("--depth", type=int, default=8, help="requests in flight per connection")
+    parser.add_argument("--requests", type=int, default=5000, help="requests per connection")
+    parser.add_argument("--length", type=int, default=100, help="characters per message")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    latencies, totals, lock = [], {"correct": 0}, threading.Lock()
+    threads = [threading.Thread(target=run_connection, args=(args, i, latencies, totals, lock))
+               for i in range(args.connections)]
+
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.perf_counter() - start
+
+    latencies.sort()
+    count = len(latencies)
+    print("%d requests in %.2f s: %.0f req/s" % (count, elapsed, count / elapsed))
+    print("latency us: p50 %.0f  p90 %.0f  p99 %.0f  max %.0f" %
+          tuple(1e6 * v for v in (percentile(latencies, 50), percentile(latencies, 90),
+                                  percentile(latencies, 99), latencies[-1])))
+    print("keys recovered: %.1f%%" % (100.0 * totals["correct"] / count))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+/**
+ * @file AllocationCounter.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Replaces the global operator new and delete so EngineStats can count the heap
+ *        allocations made by each thread. Only linked into the executables; code embedding the
+ *        engine keeps its own allocator and simply sees allocation counts of zero.
+ *
+ * @see EngineStats.hpp
+ *
+ */
+
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+extern thread_local std::uint64_t thread_allocation_count;
+
+
+// === Counting Allocation Functions ==============================================================
+
+static void* counted_alloc (std::size_t size)
+{
+    thread_allocation_count++;
+    void* p = std::malloc (size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+static void* counted_aligned_alloc (std::size_t size, std::align_val_t align)
+{
+    thread_allocation_count++;
+    std::size_t alignment = (std::size_t)align;
+    if (alignment < sizeof (void*))
+        alignment = sizeof (void*);
+
+    void* p = nullptr;
+    if (posix_memalign (&p, alignment, size ? size : 1) != 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new (std::size_t size) { return counted_alloc (size); }
+void* operator new[] (std::size_t size) { return counted_alloc (size); }
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return counted_alloc (size); } catch (...) { return nullptr; }
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return counted_alloc (size); } catch (...) { return nullptr; }
+}
+
+void* operator new (std::size_t size, std::align_val_t align)
+{
+    return counted_aligned_alloc (size, align);
+}
+
+void* operator new[] (std::size_t size, std::align_val_t align)
+{
+    return counted_aligned_alloc (size, align);
+}
+
+void operator delete (void* p) noexcept { std::free (p); }
+void operator delete[] (void* p) noexcept { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete (void* p, std::align_val_t) noexcept { std::free (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept { std::free (p); }
+void operator delete (void* p, std::size_t, std::align_val_t) noexcept { std::free (p); }
+void operator delete[] (void* p, std::size_t, std::align_val_t) noexcept { std::free (p); }
@@ -0,0 +1,209 @@
+/**
+ * @file BatchCracker.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the BatchCracker class.
+ *
+ * @see BatchCracker.hpp
+ *
+ */
+
+
+#include "BatchCracker.hpp"
+
+#include "BoundedQueue.hpp"
+#include "decrypt.hpp"
+#include "SubstitutionSolver.hpp"
+
+#include <map>
+#include <memory>
+#include <thread>
+
+/**
+ * @fn thread_engine
+ *
+ * @return The engine the calling thread cracks Caesar and Vigenere lines with, kept for every
+ *         line it cracks.
+ *
+ */
+static DecryptEngine& thread_engine ()
+{
+    thread_local DecryptEngine engine;
+    return engine;
+}
+
+// === Ctors ======================================================================================
+
+BatchCracker::BatchCracker (CipherMode m, unsigned int threads) : mode (m), pool (threads)
+{
+    result_cache = nullptr;
+    stats_enabled = false;
+}
+
+
+// === Processing Functions =======================================================================
+
+/**
+ * @fn BatchCracker::run
+ *
+ * @param in: Corpus with one ciphertext per line.
+ * @param out: Receives one "<key>\t<plaintext>" line per input line, in input order.
+ *
+ * @brief Cracks every line of a corpus. A reader thread, the worker pool and a writer thread are
+ *        connected by bounded queues so reading, cracking and writing overlap. The number of
+ *        batches between the reader and the writer is capped, which also caps memory use.
+ *
+ */
+void BatchCracker::run (std::istream& in, std::ostream& out)
+{
+    std::size_t max_in_flight = BATCHES_IN_FLIGHT_PER_THREAD * pool.get_thread_count();
+    BoundedQueue <Batch> read_queue (max_in_flight);
+    BoundedQueue <Batch> done_queue (max_in_flight);
+
+    // Reader: groups lines into numbered batches
+    std::thread reader ([&] {
+        Batch batch;
+        batch.sequence = 0;
+        std::string line;
+        while (std::getline (in, line))
+        {
+            batch.lines.push_back (std::move (line));
+            if (batch.lines.size() == BATCH_LINES)
+            {
+                std::size_t next = batch.sequence + 1;
+                read_queue.push (std::move (batch));
+                batch = Batch();
+                batch.sequence = next;
+            }
+        }
+        if (!batch.lines.empty())
+            read_queue.push (std::move (batch));
+        read_queue.close();
+    });
+
+    // Writer: holds batches that finish early until every batch before them has been written
+    std::mutex flight_mutex;
+    std::condition_variable flight_done;
+    std::size_t in_flight = 0;
+
+    std::thread writer ([&] {
+        std::map <std::size_t, std::vector <std::string>> finished;
+        std::size_t next_sequence = 0;
+        Batch batch;
+        while (done_queue.pop (batch))
+        {
+            finished[batch.sequence] = std::move (batch.lines);
+            while (!finished.empty() && (finished.begin()->first == next_sequence))
+            {
+                std::vector <std::string>& lines = finished.begin()->second;
+                for (std::size_t i = 0; i < lines.size(); i++)
+                    out << lines[i] << '\n';
+                finished.erase (finished.begin());
+                next_sequence++;
+
+                std::lock_guard <std::mutex> lock (flight_mutex);
+                in_flight--;
+                flight_done.notify_one();
+            }
+        }
+        out.flush();
+    });
+
+    // Dispatcher: hands batches to the pool while keeping the number in flight bounded
+    Batch batch;
+    while (read_queue.pop (batch))
+    {
+        {
+            std::unique_lock <std::mutex> lock (flight_mutex);
+            flight_done.wait (lock, [&] { return in_flight < max_in_flight; });
+            in_flight++;
+        }
+
+        std::shared_ptr <Batch> task_batch (new Batch (std::move (batch)));
+        pool.submit ([this, task_batch, &done_queue] {
+            crack_batch (*task_batch);
+            done_queue.push (std::move (*task_batch));
+        });
+    }
+
+    pool.wait_idle();
+    done_queue.close();
+    reader.join();
+    writer.join();
+}
+
+/**
+ * @fn BatchCracker::crack_batch
+ *
+ * @param batch: Batch whose lines are replaced by their results.
+ *
+ * @brief Cracks every line of a batch in place. With stats enabled, the stats the thread's
+ *        engine gathered over the batch are then moved into the totals of the whole run.
+ *
+ */
+void BatchCracker::crack_batch (Batch& batch)
+{
+    for (std::size_t i = 0; i < batch.lines.size(); i++)
+        crack_line (batch.lines[i]);
+
+    if (stats_enabled)
+    {
+        DecryptEngine& engine = thread_engine();
+        std::lock_guard <std::mutex> lock (stats_mutex);
+        stats.merge (engine.get_stats());
+        engine.reset_stats();
+    }
+}
+
+/**
+ * @fn BatchCracker::crack_line
+ *
+ * @param line: A ciphertext, replaced by "<key>\t<plaintext>".
+ *
+ * @brief Cracks a single ciphertext with the engine matching the batch's cipher mode. Each
+ *        thread reuses one engine for every line it cracks, and the result is written over the
+ *        line in place, so once the buffers have grown to the longest line no allocations are
+ *        made.
+ *
+ */
+void BatchCracker::crack_line (std::string& line)
+{
+    // Tolerate corpora written with CRLF line endings
+    if (!line.empty() && (line.back() == '\r'))
+        line.pop_back();
+
+    if (line.empty())
+        return;
+
+    if (mode == SUBSTITUTION_MODE)
+    {
+        thread_local SubstitutionSolver solver;
+        solver.set_thread_pool (&pool);
+        solver.solve (line);
+        line.assign (solver.get_key());
+        line += '\t';
+        line += solver.get_plaintext();
+        return;
+    }
+
+    DecryptEngine& engine = thread_engine();
+    engine.set_thread_pool (&pool);
+    engine.set_result_cache (result_cache);
+    engine.enable_instrumentation (stats_enabled);
+    engine.set_ciphertext (line);
+    if (mode == CAESAR_MODE)
+    {
+        engine.process_caesar();
+        engine.decrypt_caesar_cipher (engine.most_likely_key());
+        line.assign (1, engine.most_likely_key());
+    }
+    else
+    {
+        engine.process_vigenere();
+        line.assign (engine.get_calculated_key());
+    }
+    line += '\t';
+    line += engine.get_plaintext();
+}
@@ -0,0 +1,128 @@
+/**
+ * @file ColumnHistograms.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the ColumnHistograms class.
+ *
+ * @see ColumnHistograms.hpp
+ *
+ */
+
+
+#include "ColumnHistograms.hpp"
+
+#include <algorithm>
+
+// === Ctors ======================================================================================
+
+ColumnHistograms::ColumnHistograms ()
+{
+    period = 0;
+    next_column = 0;
+}
+
+
+// === Counting Functions =========================================================================
+
+/**
+ * @fn ColumnHistograms::reset
+ *
+ * @param p: The period (key length) the text is split at.
+ *
+ * @brief Clears all counts and sets the number of columns. Storage only grows, so resetting to
+ *        the same or a smaller period does not allocate.
+ *
+ * @post Every column is empty and the next byte counted falls into column 0.
+ *
+ */
+void ColumnHistograms::reset (unsigned int p)
+{
+    period = (p == 0) ? 1 : p;
+    next_column = 0;
+
+    if (counts.size() < period * LETTER_BINS)
+    {
+        counts.resize (period * LETTER_BINS);
+        totals.resize (period);
+    }
+
+    std::fill (counts.begin(), counts.begin() + period * LETTER_BINS, 0);
+    std::fill (totals.begin(), totals.begin() + period, 0);
+}
+
+/**
+ * @fn ColumnHistograms::reserve
+ *
+ * @param p: The longest period the histograms will be reset to.
+ *
+ * @brief Grows the storage for up to p columns ahead of time, so no later reset allocates.
+ *
+ */
+void ColumnHistograms::reserve (unsigned int p)
+{
+    if (counts.size() < p * LETTER_BINS)
+    {
+        counts.resize (p * LETTER_BINS);
+        totals.resize (p);
+    }
+}
+
+/**
+ * @fn ColumnHistograms::count
+ *
+ * @param letters: Letter indices 0-25 from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ *
+ * @brief Counts a normalized text into its columns in a single strided pass. Every letter uses
+ *        up a key position, so no byte needs a range check. The column position carries over
+ *        between calls, so a text may be counted in chunks.
+ *
+ * @pre reset has been called.
+ *
+ */
+void ColumnHistograms::count (const std::uint8_t* letters, std::size_t len)
+{
+    std::uint64_t* table = counts.data();
+    unsigned int column = next_column;
+
+    for (std::size_t i = 0; i < len; i++)
+    {
+        table[column * LETTER_BINS + letters[i]]++;
+        totals[column]++;
+
+        if (++column == period)
+            column = 0;
+    }
+
+    next_column = column;
+}
+
+/**
+ * @fn ColumnHistograms::merge
+ *
+ * @param table: Column counts of a later part of the same text at the same period, as laid out
+ *               from get_column (0).
+ * @param offset: Position in the whole text of the first letter of that part.
+ *
+ * @brief Adds the columns of one shard of a text, e.g. one counted by another process. The
+ *        shard's column 0 started at its own first letter, so its columns are rotated by offset
+ *        to line up with the columns of the whole text.
+ *
+ * @pre reset has been called with the period the shard was counted at.
+ *
+ */
+void ColumnHistograms::merge (const std::uint64_t* table, std::uint64_t offset)
+{
+    unsigned int shift = (unsigned int)(offset % period);
+    for (unsigned int c = 0; c < period; c++)
+    {
+        unsigned int column = (c + shift) % period;
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+        {
+            counts[column * LETTER_BINS + e] += table[c * LETTER_BINS + e];
+            totals[column] += table[c * LETTER_BINS + e];
+        }
+    }
+}
@@ -0,0 +1,666 @@
+/**
+ * @file Coordinator.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the Coordinator class.
+ *
+ * @see Coordinator.hpp
+ *
+ */
+
+
+#include "Coordinator.hpp"
+
+#include "ColumnHistograms.hpp"
+#include "CrackProtocol.hpp"
+#include "decrypt.hpp"
+#include "KeyLengthSearch.hpp"
+#include "LetterBuffer.hpp"
+#include "ResultCache.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <utility>
+
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// === Ctors ======================================================================================
+
+Coordinator::Coordinator (CipherMode m, unsigned int workers) : mode (m)
+{
+    worker_count = (workers > 0) ? workers : std::thread::hardware_concurrency();
+    if (worker_count == 0)
+        worker_count = 1;
+
+    restarts = 0;
+    failed_lines = 0;
+}
+
+Coordinator::~Coordinator ()
+{
+    stop_workers();
+}
+
+
+// === Processing Functions =======================================================================
+
+/**
+ * @fn Coordinator::run
+ *
+ * @param in: Corpus with one ciphertext per line.
+ * @param out: Receives one "<key>\t<plaintext>" line per input line, in input order.
+ * @return false if no worker could be started; the lines not yet written are lost.
+ *
+ * @brief Cracks every line of a corpus in the worker processes, a shard of lines at a time.
+ *        Shards that finish early are held until every shard before them has been written, so
+ *        the output matches batch mode. A line that still kills its worker after
+ *        COORDINATOR_MAX_ATTEMPTS tries is written as an empty result ("\t").
+ *
+ */
+bool Coordinator::run (std::istream& in, std::ostream& out)
+{
+    std::signal (SIGPIPE, SIG_IGN);
+    start_workers();
+
+    std::uint64_t lines_read = 0;
+    std::string line;
+    ShardSource source = [&] (Shard& shard) {
+        shard.first = lines_read;
+        shard.count = 0;
+        shard.kind = TASK_LINES;
+        shard.attempts = 0;
+        shard.payload.clear();
+        while ((shard.count < COORDINATOR_SHARD_LINES) &&
+               (shard.payload.size() < COORDINATOR_SHARD_BYTES) && std::getline (in, line))
+        {
+            shard.payload += line;
+            shard.payload += '\n';
+            shard.count++;
+        }
+        lines_read += shard.count;
+        return shard.count > 0;
+    };
+
+    // Results by first line; written once every line before them has been
+    std::map <std::uint64_t, std::pair <std::uint32_t, std::string>> finished;
+    std::uint64_t next_line = 0;
+    ShardSink sink = [&] (const Shard& shard, std::string& result, bool failed) {
+        if (failed)
+        {
+            failed_lines += shard.count;
+            result.clear();
+            for (std::uint32_t i = 0; i < shard.count; i++)
+                result += "\t\n";
+        }
+        finished[shard.first] = { shard.count, std::move (result) };
+
+        while (!finished.empty() && (finished.begin()->first == next_line))
+        {
+            out << finished.begin()->second.second;
+            next_line += finished.begin()->second.first;
+            finished.erase (finished.begin());
+        }
+    };
+
+    bool complete = dispatch (source, sink);
+    stop_workers();
+    out.flush();
+    return complete;
+}
+
+/**
+ * @fn Coordinator::crack_file
+ *
+ * @param path: Path of a file holding one Vigenere ciphertext.
+ * @param out: Receives the plaintext, as upper case letters.
+ * @return false if the file could not be opened, the mode is not Vigenere, or a range of the
+ *         file could not be counted.
+ *
+ * @brief Splits a huge file into byte ranges and has the workers count them in two rounds: the
+ *        period tables of KeyLengthSearch, then the column histograms at the best period. The
+ *        tables of every range are merged in file order, each rotated by the number of letters
+ *        before its range, giving the same counts as one pass over the whole file. The key is
+ *        read from the merged columns and the plaintext is streamed by this process.
+ *
+ * @post get_key returns the key found.
+ *
+ */
+bool Coordinator::crack_file (const std::string& path, std::ostream& out)
+{
+    if ((mode != VIGENERE_MODE) || !file.open (path))
+        return false;
+
+    std::signal (SIGPIPE, SIG_IGN);
+    start_workers();
+
+    std::uint64_t size = file.get_size();
+    std::uint64_t ranges = (std::uint64_t)worker_count * COORDINATOR_RANGES_PER_WORKER;
+    std::uint64_t range_size = std::max <std::uint64_t> (FILE_CHUNK_SIZE,
+                                                         (size + ranges - 1) / ranges);
+    ranges = std::max <std::uint64_t> (1, (size + range_size - 1) / range_size);
+
+    // Letters in each range, and what its worker counted there
+    std::vector <std::uint64_t> letters (ranges, 0);
+    std::vector <std::string> tables (ranges);
+    std::uint64_t next_range = 0;
+    unsigned int period = 0;
+    bool counted = true;
+
+    ShardSource source = [&] (Shard& shard) {
+        if (next_range >= ranges)
+            return false;
+
+        std::uint64_t task[3] = { next_range * range_size,
+                                  std::min (size, (next_range + 1) * range_size), period };
+        shard.first = next_range++;
+        shard.count = 1;
+        shard.kind = (period == 0) ? TASK_PERIODS : TASK_COLUMNS;
+        shard.attempts = 0;
+        shard.payload.assign ((const char*)task, sizeof (task));
+        return true;
+    };
+    ShardSink sink = [&] (const Shard& shard, std::string& result, bool failed) {
+        if (failed || (result.size() < sizeof (std::uint64_t)))
+        {
+            counted = false;
+            return;
+        }
+        std::memcpy (&letters[shard.first], result.data(), sizeof (std::uint64_t));
+        tables[shard.first] = std::move (result);
+    };
+
+    // First round: the key length
+    std::vector <std::uint64_t> table;
+    KeyLengthSearch search;
+    search.reset();
+    if (!dispatch (source, sink) || !counted)
+    {
+        stop_workers();
+        return false;
+    }
+
+    std::uint64_t offset = 0;
+    for (std::uint64_t r = 0; r < ranges; r++)
+    {
+        std::uint64_t header[2];
+        std::memcpy (header, tables[r].data(), sizeof (header));
+        std::size_t entries = LETTER_BINS * header[1] * (header[1] + 1) / 2;
+        if (tables[r].size() != sizeof (header) + entries * sizeof (std::uint64_t))
+        {
+            stop_workers();
+            return false;
+        }
+
+        table.resize (entries);
+        std::memcpy (table.data(), tables[r].data() + sizeof (header),
+                     entries * sizeof (std::uint64_t));
+        search.merge (table.data(), (unsigned int)header[1], letters[r], offset);
+        offset += letters[r];
+    }
+    search.rank();
+    period = search.get_best_period();
+
+    // Second round: the shift of every column at that length
+    next_range = 0;
+    ColumnHistograms columns;
+    columns.reset (period);
+    if (!dispatch (source, sink) || !counted)
+    {
+        stop_workers();
+        return false;
+    }
+    stop_workers();
+
+    offset = 0;
+    for (std::uint64_t r = 0; r < ranges; r++)
+    {
+        std::size_t entries = (std::size_t)period * LETTER_BINS;
+        if (tables[r].size() != (entries + 1) * sizeof (std::uint64_t))
+            return false;
+
+        table.resize (entries);
+        std::memcpy (table.data(), tables[r].data() + sizeof (std::uint64_t),
+                     entries * sizeof (std::uint64_t));
+        columns.merge (table.data(), offset);
+        offset += letters[r];
+    }
+
+    double correlations[LETTER_BINS];
+    key.assign (period, 'A');
+    for (unsigned int c = 0; c < period; c++)
+    {
+        unsigned int shift = DecryptEngine::calc_column_correlations (columns.get_column (c),
+                                                                      columns.get_column_total (c),
+                                                                      correlations);
+        key[c] = (char)('A' + shift);
+    }
+    file.close();
+
+    DecryptEngine engine;
+    if (!engine.open_ciphertext_file (path))
+        return false;
+    engine.set_calculated_key (key);
+    engine.stream_vigenere_plaintext (out);
+    return true;
+}
+
+
+// === Dispatch Functions =========================================================================
+
+/**
+ * @fn Coordinator::dispatch
+ *
+ * @param next: Fills in the next shard; returns false once there are none left.
+ * @param done: Receives every shard with its result, or with failed set once it is given up on.
+ * @return false if every worker died and could not be restarted while shards were left.
+ *
+ * @brief Keeps every idle worker busy, handing out shards that were lost to a dead worker before
+ *        new ones, and waits on the result pipes of the busy workers with poll. A worker whose
+ *        pipe closes has died; it is restarted and its shard handed out again.
+ *
+ */
+bool Coordinator::dispatch (const ShardSource& next, const ShardSink& done)
+{
+    std::deque <Shard> retry;
+    bool source_open = true;
+    std::vector <pollfd> polled;
+    std::vector <Worker*> polled_workers;
+
+    while (true)
+    {
+        for (Worker& worker : workers)
+        {
+            if (worker.busy || (worker.pid < 0))
+                continue;
+
+            Shard shard;
+            if (!retry.empty())
+            {
+                shard = std::move (retry.front());
+                retry.pop_front();
+            }
+            else if (!source_open || !(source_open = next (shard)))
+                break;
+
+            if (!assign (worker, shard))
+                fail (worker, retry, done);
+        }
+
+        polled.clear();
+        polled_workers.clear();
+        bool alive = false;
+        for (Worker& worker : workers)
+        {
+            alive = alive || (worker.pid >= 0);
+            if (worker.busy)
+            {
+                polled.push_back ({ worker.result_fd, POLLIN, 0 });
+                polled_workers.push_back (&worker);
+            }
+        }
+
+        if (polled.empty())
+        {
+            if (retry.empty() && !source_open)
+                return true;
+            if (!alive)
+                return false;
+
+            // A worker restarted after a failed hand-out is idle again
+            continue;
+        }
+
+        if (poll (polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        for (std::size_t i = 0; i < polled.size(); i++)
+        {
+            if (polled[i].revents == 0)
+                continue;
+
+            Worker& worker = *polled_workers[i];
+            unsigned char header_bytes[FRAME_HEADER_SIZE];
+            if (!read_full (worker.result_fd, header_bytes, FRAME_HEADER_SIZE))
+            {
+                fail (worker, retry, done);
+                continue;
+            }
+
+            FrameHeader header = decode_frame_header (header_bytes);
+            std::string result (header.length, '\0');
+            if ((header.length > 0) && !read_full (worker.result_fd, &result[0], header.length))
+            {
+                fail (worker, retry, done);
+                continue;
+            }
+
+            worker.busy = false;
+            done (worker.shard, result, false);
+        }
+    }
+}
+
+/**
+ * @fn Coordinator::assign
+ *
+ * @param worker: An idle worker.
+ * @param shard: The shard to hand it; moved into the worker.
+ * @return false if the task could not be written, i.e. the worker has died.
+ *
+ * @post The worker is busy with the shard either way, so fail can hand the shard out again.
+ *
+ */
+bool Coordinator::assign (Worker& worker, Shard& shard)
+{
+    worker.shard = std::move (shard);
+    worker.busy = true;
+
+    unsigned char header_bytes[FRAME_HEADER_SIZE];
+    encode_frame_header ({ (std::uint32_t)worker.shard.payload.size(),
+                           (std::uint32_t)worker.shard.first, worker.shard.kind }, header_bytes);
+    return write_full (worker.task_fd, header_bytes, FRAME_HEADER_SIZE) &&
+           write_full (worker.task_fd, worker.shard.payload.data(), worker.shard.payload.size());
+}
+
+/**
+ * @fn Coordinator::fail
+ *
+ * @param worker: A busy worker that has died.
+ * @param retry: Shards to be handed out again, ahead of new ones.
+ * @param done: Receives the shard if it is given up on.
+ *
+ * @brief Reaps and restarts the worker and decides what happens to its shard. A shard of
+ *        several lines is split into single lines, so a line that crashes every worker it is
+ *        given to only takes itself down; any other shard is retried until it has been tried
+ *        COORDINATOR_MAX_ATTEMPTS times.
+ *
+ */
+void Coordinator::fail (Worker& worker, std::deque <Shard>& retry, const ShardSink& done)
+{
+    Shard shard = std::move (worker.shard);
+    worker.busy = false;
+    stop_worker (worker, true);
+    restarts++;
+    start_worker (worker);
+
+    shard.attempts++;
+    if ((shard.kind == TASK_LINES) && (shard.count > 1))
+    {
+        std::vector <Shard> lines (shard.count);
+        std::size_t start = 0;
+        for (std::uint32_t i = 0; i < shard.count; i++)
+        {
+            std::size_t end = shard.payload.find ('\n', start);
+            lines[i] = { shard.first + i, 1, TASK_LINES, shard.attempts,
+                         shard.payload.substr (start, end + 1 - start) };
+            start = end + 1;
+        }
+        for (std::size_t i = lines.size(); i > 0; i--)
+            retry.push_front (std::move (lines[i - 1]));
+    }
+    else if (shard.attempts >= COORDINATOR_MAX_ATTEMPTS)
+    {
+        std::string none;
+        done (shard, none, true);
+    }
+    else
+        retry.push_front (std::move (shard));
+}
+
+
+// === Worker Functions ===========================================================================
+
+/**
+ * @fn Coordinator::start_worker
+ *
+ * @param worker: Receives the pid and pipe ends of the new worker.
+ * @return false if the pipes or the process could not be created; the worker is left unused.
+ *
+ * @brief Forks a worker connected by two pipes. The child closes every other worker's pipe ends,
+ *        so a worker's death is seen as soon as its own process exits.
+ *
+ * @pre No other threads are running in this process.
+ *
+ */
+bool Coordinator::start_worker (Worker& worker)
+{
+    worker.pid = -1;
+    worker.task_fd = -1;
+    worker.result_fd = -1;
+    worker.busy = false;
+
+    int tasks[2], results[2];
+    if (pipe (tasks) != 0)
+        return false;
+    if (pipe (results) != 0)
+    {
+        ::close (tasks[0]);
+        ::close (tasks[1]);
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        ::close (tasks[0]);
+        ::close (tasks[1]);
+        ::close (results[0]);
+        ::close (results[1]);
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        ::close (tasks[1]);
+        ::close (results[0]);
+        for (Worker& other : workers)
+        {
+            if (other.task_fd >= 0)
+                ::close (other.task_fd);
+            if (other.result_fd >= 0)
+                ::close (other.result_fd);
+        }
+        serve_worker (tasks[0], results[1]);
+        _exit (0);
+    }
+
+    ::close (tasks[0]);
+    ::close (results[1]);
+    worker.pid = pid;
+    worker.task_fd = tasks[1];
+    worker.result_fd = results[0];
+    return true;
+}
+
+/**
+ * @fn Coordinator::stop_worker
+ *
+ * @param worker: The worker to stop.
+ * @param kill_worker: Kills the worker rather than letting it finish; for a worker that has
+ *                     died or stopped answering.
+ *
+ * @brief Closes the worker's task pipe, which an idle worker takes as the signal to exit, and
+ *        reaps it.
+ *
+ */
+void Coordinator::stop_worker (Worker& worker, bool kill_worker)
+{
+    if (worker.task_fd >= 0)
+        ::close (worker.task_fd);
+    if (kill_worker && (worker.pid > 0))
+        kill (worker.pid, SIGKILL);
+    if (worker.result_fd >= 0)
+        ::close (worker.result_fd);
+    if (worker.pid > 0)
+        waitpid (worker.pid, nullptr, 0);
+
+    worker.pid = -1;
+    worker.task_fd = -1;
+    worker.result_fd = -1;
+    worker.busy = false;
+}
+
+/**
+ * @fn Coordinator::start_workers
+ *
+ * @brief Forks worker_count workers. Any that cannot be started are left unused.
+ *
+ */
+void Coordinator::start_workers ()
+{
+    stop_workers();
+    workers.resize (worker_count);
+    for (Worker& worker : workers)
+    {
+        worker.task_fd = -1;
+        worker.result_fd = -1;
+    }
+    for (Worker& worker : workers)
+        start_worker (worker);
+}
+
+/**
+ * @fn Coordinator::stop_workers
+ *
+ * @brief Lets every worker exit and reaps it.
+ *
+ */
+void Coordinator::stop_workers ()
+{
+    for (Worker& worker : workers)
+        stop_worker (worker, worker.busy);
+    workers.clear();
+}
+
+/**
+ * @fn Coordinator::serve_worker
+ *
+ * @param task_fd: Pipe the tasks are read from.
+ * @param result_fd: Pipe the results are written to.
+ *
+ * @brief The loop of a worker process: answers one task frame with one result frame until the
+ *        task pipe is closed. Lines are cracked by a single-threaded BatchCracker sharing the
+ *        disk cache, if there is one, with every other worker.
+ *
+ */
+void Coordinator::serve_worker (int task_fd, int result_fd)
+{
+    BatchCracker cracker (mode, 1);
+    ResultCache cache;
+    if (!cache_path.empty() && cache.open_disk (cache_path))
+        cracker.set_result_cache (&cache);
+
+    unsigned char header_bytes[FRAME_HEADER_SIZE];
+    std::string payload, result, line;
+    while (read_full (task_fd, header_bytes, FRAME_HEADER_SIZE))
+    {
+        FrameHeader header = decode_frame_header (header_bytes);
+        payload.resize (header.length);
+        if ((header.length > 0) && !read_full (task_fd, &payload[0], header.length))
+            break;
+
+        result.clear();
+        std::uint64_t task[3] = { 0, 0, 0 };
+        std::memcpy (task, payload.data(), std::min (payload.size(), sizeof (task)));
+        if (header.kind == TASK_LINES)
+        {
+            std::size_t start = 0;
+            while (start < payload.size())
+            {
+                std::size_t end = std::min (payload.find ('\n', start), payload.size());
+                line.assign (payload, start, end - start);
+                cracker.crack_line (line);
+                result += line;
+                result += '\n';
+                start = end + 1;
+            }
+        }
+        else if (header.kind == TASK_PERIODS)
+            count_periods (task[0], task[1], result);
+        else if (header.kind == TASK_COLUMNS)
+            count_columns (task[0], task[1], (unsigned int)task[2], result);
+
+        encode_frame_header ({ (std::uint32_t)result.size(), header.id, FRAME_OK }, header_bytes);
+        if (!write_full (result_fd, header_bytes, FRAME_HEADER_SIZE) ||
+            !write_full (result_fd, result.data(), result.size()))
+            break;
+    }
+}
+
+/**
+ * @fn Coordinator::count_periods
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past the last byte of the range.
+ * @param result: Receives the number of letters in the range, the active period and the period
+ *                tables, as native 64-bit integers.
+ *
+ * @brief Counts the letters of one range of the file at every candidate period, a chunk at a
+ *        time, releasing each chunk once it is counted.
+ *
+ */
+void Coordinator::count_periods (std::uint64_t begin, std::uint64_t end, std::string& result)
+{
+    KeyLengthSearch search;
+    LetterBuffer letters;
+    search.reset();
+
+    std::uint64_t counted = 0;
+    for (std::uint64_t offset = begin; offset < end; offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = (std::size_t)std::min <std::uint64_t> (FILE_CHUNK_SIZE, end - offset);
+        letters.normalize (file.get_data() + offset, len);
+        search.count (letters.get_letters(), letters.get_letter_count());
+        counted += letters.get_letter_count();
+        file.release ((std::size_t)offset, len);
+    }
+
+    std::uint64_t header[2] = { counted, search.get_active_period() };
+    result.assign ((const char*)header, sizeof (header));
+    result.append ((const char*)search.get_counts(),
+                   search.get_table_size() * sizeof (std::uint64_t));
+}
+
+/**
+ * @fn Coordinator::count_columns
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past the last byte of the range.
+ * @param period: Key length to split the letters at.
+ * @param result: Receives the number of letters in the range and the histogram of every column,
+ *                as native 64-bit integers.
+ *
+ */
+void Coordinator::count_columns (std::uint64_t begin, std::uint64_t end, unsigned int period,
+                                 std::string& result)
+{
+    ColumnHistograms columns;
+    LetterBuffer letters;
+    columns.reset (std::max (period, 1u));
+
+    std::uint64_t counted = 0;
+    for (std::uint64_t offset = begin; offset < end; offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = (std::size_t)std::min <std::uint64_t> (FILE_CHUNK_SIZE, end - offset);
+        letters.normalize (file.get_data() + offset, len);
+        columns.count (letters.get_letters(), letters.get_letter_count());
+        counted += letters.get_letter_count();
+        file.release ((std::size_t)offset, len);
+    }
+
+    result.assign ((const char*)&counted, sizeof (counted));
+    result.append ((const char*)columns.get_column (0),
+                   (std::size_t)columns.get_period() * LETTER_BINS * sizeof (std::uint64_t));
+}
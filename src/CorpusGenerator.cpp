@@ -0,0 +1,154 @@
+/**
+ * @file CorpusGenerator.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the CorpusGenerator class.
+ *
+ * @see CorpusGenerator.hpp
+ *
+ */
+
+
+#include "CorpusGenerator.hpp"
+
+// Common English words, most frequent first
+static const char* const WORD_LIST[] = {
+    "THE", "OF", "AND", "TO", "A", "IN", "IS", "IT", "THAT", "WAS", "HE", "FOR", "ON", "ARE",
+    "AS", "WITH", "HIS", "THEY", "I", "AT", "BE", "THIS", "HAVE", "FROM", "OR", "ONE", "HAD",
+    "BY", "WORD", "BUT", "NOT", "WHAT", "ALL", "WERE", "WE", "WHEN", "YOUR", "CAN", "SAID",
+    "THERE", "USE", "AN", "EACH", "WHICH", "SHE", "DO", "HOW", "THEIR", "IF", "WILL", "UP",
+    "OTHER", "ABOUT", "OUT", "MANY", "THEN", "THEM", "THESE", "SO", "SOME", "HER", "WOULD",
+    "MAKE", "LIKE", "HIM", "INTO", "TIME", "HAS", "LOOK", "TWO", "MORE", "WRITE", "GO", "SEE",
+    "NUMBER", "NO", "WAY", "COULD", "PEOPLE", "MY", "THAN", "FIRST", "WATER", "BEEN", "CALL",
+    "WHO", "OIL", "ITS", "NOW", "FIND", "LONG", "DOWN", "DAY", "DID", "GET", "COME", "MADE",
+    "MAY", "PART", "OVER", "NEW", "SOUND", "TAKE", "ONLY", "LITTLE", "WORK", "KNOW", "PLACE",
+    "YEAR", "LIVE", "ME", "BACK", "GIVE", "MOST", "VERY", "AFTER", "THING", "OUR", "JUST",
+    "NAME", "GOOD", "SENTENCE", "MAN", "THINK", "SAY", "GREAT", "WHERE", "HELP", "THROUGH",
+    "MUCH", "BEFORE", "LINE", "RIGHT", "TOO", "MEAN", "OLD", "ANY", "SAME", "TELL", "BOY",
+    "FOLLOW", "CAME", "WANT", "SHOW", "ALSO", "AROUND", "FORM", "THREE", "SMALL", "SET", "PUT",
+    "END", "DOES", "ANOTHER", "WELL", "LARGE", "MUST", "BIG", "EVEN", "SUCH", "BECAUSE",
+    "TURN", "HERE", "WHY", "ASK", "WENT", "MEN", "READ", "NEED", "LAND", "DIFFERENT", "HOME",
+    "US", "MOVE", "TRY", "KIND", "HAND", "PICTURE", "AGAIN", "CHANGE", "OFF", "PLAY", "SPELL",
+    "AIR", "AWAY", "ANIMAL", "HOUSE", "POINT", "PAGE", "LETTER", "MOTHER", "ANSWER", "FOUND",
+    "STUDY", "STILL", "LEARN", "SHOULD", "AMERICA", "WORLD", "QUIET", "JUMP", "ZERO", "EXTRA"
+};
+
+const unsigned int WORD_LIST_SIZE = sizeof (WORD_LIST) / sizeof (WORD_LIST[0]);
+
+// === Ctors ======================================================================================
+
+CorpusGenerator::CorpusGenerator (std::uint64_t seed) : rng (seed)
+{
+    std::vector <double> weights (WORD_LIST_SIZE);
+    for (unsigned int i = 0; i < WORD_LIST_SIZE; i++)
+        weights[i] = 1.0 / (double)(i + 1);
+
+    word_choice = std::discrete_distribution <unsigned int> (weights.begin(), weights.end());
+}
+
+
+// === Generation Functions =======================================================================
+
+/**
+ * @fn CorpusGenerator::gen_plaintext
+ *
+ * @param text: Receives the plaintext; its existing capacity is reused.
+ * @param size: Length of the plaintext in bytes.
+ *
+ * @brief Generates uppercase words separated by single spaces, drawn with English-like word
+ *        frequencies. The last word is cut short if needed to hit size exactly.
+ *
+ */
+void CorpusGenerator::gen_plaintext (std::string& text, std::size_t size)
+{
+    text.clear();
+    text.reserve (size);
+
+    while (text.size() < size)
+    {
+        if (!text.empty())
+            text += ' ';
+        text += WORD_LIST[word_choice (rng)];
+    }
+
+    text.resize (size);
+}
+
+/**
+ * @fn CorpusGenerator::gen_caesar_key
+ *
+ * @return A random key letter A-Z.
+ *
+ */
+char CorpusGenerator::gen_caesar_key ()
+{
+    return 'A' + (char)(rng() % 26);
+}
+
+/**
+ * @fn CorpusGenerator::gen_vigenere_key
+ *
+ * @return A random key of MIN_RANDOM_KEY_LENGTH to MAX_RANDOM_KEY_LENGTH letters.
+ *
+ */
+std::string CorpusGenerator::gen_vigenere_key ()
+{
+    unsigned int range = MAX_RANDOM_KEY_LENGTH - MIN_RANDOM_KEY_LENGTH + 1;
+    unsigned int length = MIN_RANDOM_KEY_LENGTH + (unsigned int)(rng() % range);
+
+    std::string key (length, 'A');
+    for (unsigned int i = 0; i < length; i++)
+        key[i] = gen_caesar_key();
+
+    return key;
+}
+
+
+// === Encryption Functions =======================================================================
+
+/**
+ * @fn CorpusGenerator::encrypt_caesar
+ *
+ * @param text: Plaintext, encrypted in place.
+ * @param key: The key letter A-Z.
+ *
+ * @brief Shifts the letters A-Z of text forward by the key; spaces are left in place.
+ *
+ */
+void CorpusGenerator::encrypt_caesar (std::string& text, char key)
+{
+    unsigned int shift = key - 'A';
+    for (std::size_t i = 0; i < text.size(); i++)
+    {
+        unsigned int index = (unsigned char)text[i] - 'A';
+        if (index < 26)
+            text[i] = 'A' + (char)((index + shift) % 26);
+    }
+}
+
+/**
+ * @fn CorpusGenerator::encrypt_vigenere
+ *
+ * @param text: Plaintext, encrypted in place.
+ * @param key: The key, as letters A-Z.
+ *
+ * @brief Encrypts the letters A-Z of text with a Vigenere cipher. Only letters use up a key
+ *        position, which matches how the engine normalizes a ciphertext into its letters.
+ *
+ */
+void CorpusGenerator::encrypt_vigenere (std::string& text, const std::string& key)
+{
+    std::size_t key_index = 0;
+    for (std::size_t i = 0; i < text.size(); i++)
+    {
+        unsigned int index = (unsigned char)text[i] - 'A';
+        if (index < 26)
+        {
+            text[i] = 'A' + (char)((index + (key[key_index] - 'A')) % 26);
+            if (++key_index == key.size())
+                key_index = 0;
+        }
+    }
+}
@@ -0,0 +1,330 @@
+/**
+ * @file CrackServer.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the CrackServer class.
+ *
+ * @see CrackServer.hpp
+ *
+ */
+
+
+#include "CrackServer.hpp"
+
+#include "CrackProtocol.hpp"
+#include "decrypt.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// === Ctors ======================================================================================
+
+CrackServer::CrackServer (unsigned int threads) : pool (threads)
+{
+    language_model = nullptr;
+    result_cache = nullptr;
+    requests_served = 0;
+    stats_enabled = false;
+    listen_fd = -1;
+    stopping = false;
+}
+
+CrackServer::~CrackServer ()
+{
+    if (listen_fd >= 0)
+    {
+        ::close (listen_fd);
+        ::unlink (socket_path.c_str());
+    }
+}
+
+
+// === Server Functions ===========================================================================
+
+/**
+ * @fn CrackServer::listen
+ *
+ * @param path: Path of the Unix domain socket to create; a stale socket left at the path is
+ *              replaced.
+ * @return true if the socket is bound and listening, false otherwise.
+ *
+ */
+bool CrackServer::listen (const std::string& path)
+{
+    sockaddr_un address;
+    std::memset (&address, 0, sizeof (address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof (address.sun_path))
+        return false;
+    std::memcpy (address.sun_path, path.c_str(), path.size());
+
+    int fd = ::socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    ::unlink (path.c_str());
+    if ((::bind (fd, (const sockaddr*)&address, sizeof (address)) != 0) ||
+        (::listen (fd, SERVER_BACKLOG) != 0))
+    {
+        ::close (fd);
+        return false;
+    }
+
+    listen_fd = fd;
+    socket_path = path;
+    return true;
+}
+
+/**
+ * @fn CrackServer::run
+ *
+ * @brief Accepts connections until stop is called, serving each on its own thread. Requests
+ *        from every connection are cracked on the shared pool. Once stopped, open connections
+ *        are shut down and run returns after their last responses have been written.
+ *
+ * @pre listen has succeeded.
+ *
+ */
+void CrackServer::run ()
+{
+    while (!stopping)
+    {
+        int fd = ::accept4 (listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if ((errno == EINTR) || (errno == ECONNABORTED))
+                continue;
+            break;
+        }
+
+        std::lock_guard <std::mutex> lock (connections_mutex);
+        connection_fds.push_back (fd);
+        std::thread ([this, fd] {
+            serve (fd, fd);
+
+            std::lock_guard <std::mutex> lock (connections_mutex);
+            connection_fds.erase (std::find (connection_fds.begin(), connection_fds.end(), fd));
+            ::close (fd);
+            connections_done.notify_all();
+        }).detach();
+    }
+
+    // Wake every reader still blocked on a client, then wait for them to drain
+    std::unique_lock <std::mutex> lock (connections_mutex);
+    for (int fd : connection_fds)
+        ::shutdown (fd, SHUT_RD);
+    connections_done.wait (lock, [this] { return connection_fds.empty(); });
+}
+
+/**
+ * @fn CrackServer::serve
+ *
+ * @param in_fd: Descriptor requests are read from.
+ * @param out_fd: Descriptor responses are written to; the same socket as in_fd, or stdout when
+ *                serving over a pipe.
+ *
+ * @brief Reads requests until the other end closes, handing each to the pool as soon as it has
+ *        arrived. Responses are written by a second thread of the connection, so pool threads
+ *        never wait on a slow client. At most MAX_PENDING_REQUESTS are in flight at once.
+ *        Returns once every response has been written.
+ *
+ */
+void CrackServer::serve (int in_fd, int out_fd)
+{
+    std::shared_ptr <Connection> connection (new Connection());
+    connection->in_fd = in_fd;
+    connection->out_fd = out_fd;
+    std::thread writer ([this, connection] { write_responses (*connection); });
+
+    unsigned char header_bytes[FRAME_HEADER_SIZE];
+    while (read_full (in_fd, header_bytes, FRAME_HEADER_SIZE))
+    {
+        FrameHeader header = decode_frame_header (header_bytes);
+
+        // An oversized request cannot be skipped safely, so it ends the connection
+        if (header.length > MAX_FRAME_PAYLOAD)
+        {
+            {
+                std::lock_guard <std::mutex> lock (connection->pending_mutex);
+                connection->pending++;
+            }
+            respond (*connection, header.id, FRAME_TOO_LONG, "request too long");
+            break;
+        }
+
+        std::string ciphertext (header.length, '\0');
+        if ((header.length > 0) && !read_full (in_fd, &ciphertext[0], header.length))
+            break;
+
+        {
+            std::unique_lock <std::mutex> lock (connection->pending_mutex);
+            connection->pending_done.wait (lock, [&] {
+                return connection->pending < MAX_PENDING_REQUESTS;
+            });
+            connection->pending++;
+        }
+
+        std::shared_ptr <std::string> payload (new std::string (std::move (ciphertext)));
+        pool.submit ([this, connection, header, payload] {
+            crack_request (connection, header.id, header.kind, *payload);
+        });
+    }
+
+    {
+        std::unique_lock <std::mutex> lock (connection->pending_mutex);
+        connection->pending_done.wait (lock, [&] { return connection->pending == 0; });
+        connection->closing = true;
+    }
+    connection->outbox_ready.notify_one();
+    writer.join();
+}
+
+/**
+ * @fn CrackServer::stop
+ *
+ * @brief Makes run stop accepting connections and return once the open ones are finished. Safe
+ *        to call from a signal handler.
+ *
+ */
+void CrackServer::stop ()
+{
+    stopping = true;
+    if (listen_fd >= 0)
+        ::shutdown (listen_fd, SHUT_RDWR);
+}
+
+/**
+ * @fn CrackServer::crack_request
+ *
+ * @param connection: Connection the request arrived on.
+ * @param id: Id of the request, echoed in the response.
+ * @param kind: FRAME_CAESAR or FRAME_VIGENERE.
+ * @param ciphertext: The ciphertext; consumed.
+ *
+ * @brief Cracks one request with the calling pool thread's engine and queues the response,
+ *        "<key>\t<plaintext>" as in batch mode; an empty ciphertext gets an empty response. Each
+ *        pool thread keeps its engine between requests, so its scratch space and tables stay
+ *        warm. With stats enabled, the engine's stats for the request are moved into the totals
+ *        of the server.
+ *
+ */
+void CrackServer::crack_request (const std::shared_ptr <Connection>& connection, std::uint32_t id,
+                                 std::uint8_t kind, std::string& ciphertext)
+{
+    thread_local DecryptEngine engine;
+    thread_local std::string result;
+    std::uint8_t status = FRAME_OK;
+
+    if ((kind != FRAME_CAESAR) && (kind != FRAME_VIGENERE))
+    {
+        status = FRAME_BAD_MODE;
+        result = "unknown mode";
+    }
+    else if (ciphertext.empty())
+        result.clear();
+    else
+    {
+        engine.set_thread_pool (&pool);
+        engine.set_language_model (language_model);
+        engine.set_result_cache (result_cache);
+        engine.enable_instrumentation (stats_enabled);
+        engine.set_ciphertext (ciphertext);
+
+        if (kind == FRAME_CAESAR)
+        {
+            engine.process_caesar();
+            engine.decrypt_caesar_cipher (engine.most_likely_key());
+            result.assign (1, engine.most_likely_key());
+        }
+        else
+        {
+            engine.process_vigenere();
+            result = engine.get_calculated_key();
+        }
+        result += '\t';
+        result += engine.get_plaintext();
+
+        if (stats_enabled)
+        {
+            std::lock_guard <std::mutex> lock (stats_mutex);
+            stats.merge (engine.get_stats());
+            engine.reset_stats();
+        }
+    }
+
+    // Queued last, as writing it frees the connection's pending slot
+    requests_served++;
+    respond (*connection, id, status, result);
+}
+
+/**
+ * @fn CrackServer::respond
+ *
+ * @param connection: Connection to answer on.
+ * @param id: Id of the request being answered.
+ * @param status: FRAME_OK or an error code.
+ * @param payload: Body of the response.
+ * @return false if the client has gone away.
+ *
+ * @brief Encodes one response as a single frame and queues it for the connection's writer
+ *        thread, so the caller never blocks on the client.
+ *
+ * @pre The request being answered is counted in connection.pending.
+ *
+ */
+bool CrackServer::respond (Connection& connection, std::uint32_t id, std::uint8_t status,
+                           const std::string& payload)
+{
+    std::string frame (FRAME_HEADER_SIZE, '\0');
+    encode_frame_header ({ (std::uint32_t)payload.size(), id, status },
+                         (unsigned char*)&frame[0]);
+    frame += payload;
+
+    std::lock_guard <std::mutex> lock (connection.pending_mutex);
+    connection.outbox.push_back (std::move (frame));
+    connection.outbox_ready.notify_one();
+    return !connection.broken;
+}
+
+/**
+ * @fn CrackServer::write_responses
+ *
+ * @param connection: Connection whose responses are written.
+ *
+ * @brief Writes queued responses in the order they were queued until serve marks the connection
+ *        closing. Each written response frees a pending slot. Once a write fails the client has
+ *        gone away, and later responses are dropped rather than written.
+ *
+ */
+void CrackServer::write_responses (Connection& connection)
+{
+    std::unique_lock <std::mutex> lock (connection.pending_mutex);
+    while (true)
+    {
+        connection.outbox_ready.wait (lock, [&] {
+            return !connection.outbox.empty() || connection.closing;
+        });
+        if (connection.outbox.empty())
+            break;
+
+        std::string frame (std::move (connection.outbox.front()));
+        connection.outbox.pop_front();
+        bool broken = connection.broken;
+
+        lock.unlock();
+        if (!broken && !write_full (connection.out_fd, frame.data(), frame.size()))
+            broken = true;
+        lock.lock();
+
+        connection.broken = broken;
+        connection.pending--;
+        connection.pending_done.notify_all();
+    }
+}
@@ -0,0 +1,396 @@
+/**
+ * @file DecryptKernels.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the Caesar and Vigenere decryption kernels.
+ *
+ *        Every kernel works on letter indices: a byte b is a letter when (b - 'A') < 26, and is
+ *        decrypted by adding (26 - shift) and subtracting 26 once if the sum wrapped, which
+ *        avoids a modulo per byte. The vector versions compute the same thing on 16, 32 or 64
+ *        bytes at a time and blend the result with the original bytes so non-letters pass
+ *        through untouched.
+ *
+ * @see DecryptKernels.hpp
+ *
+ */
+
+
+#include "DecryptKernels.hpp"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DECRYPT_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+
+// Widest vector used by any kernel; the Vigenere shift pattern is padded by this much
+const unsigned int MAX_VECTOR_WIDTH = 64;
+
+
+// === Scalar Kernels =============================================================================
+
+/**
+ * @fn shift_byte
+ *
+ * @param c: The ciphertext byte.
+ * @param add: 26 minus the shift being undone.
+ * @return The decrypted byte, or c itself if it is not a letter.
+ *
+ */
+static inline char shift_byte (char c, unsigned int add)
+{
+    unsigned int index = (unsigned char)c - 'A';
+    if (index >= 26)
+        return c;
+
+    index += add;
+    if (index >= 26)
+        index -= 26;
+    return (char)(index + 'A');
+}
+
+static void caesar_scalar (const char* in, char* out, std::size_t len, unsigned int shift)
+{
+    unsigned int add = 26 - shift;
+    for (std::size_t i = 0; i < len; i++)
+        out[i] = shift_byte (in[i], add);
+}
+
+static void vigenere_scalar (const char* in, char* out, std::size_t len, const char* key,
+                             unsigned int key_len, unsigned int key_offset)
+{
+    for (std::size_t i = 0; i < len; i++)
+    {
+        out[i] = shift_byte (in[i], 26 - ((unsigned char)(key[key_offset] - 'A') % 26));
+        if (++key_offset == key_len)
+            key_offset = 0;
+    }
+}
+
+// === SSE2 Kernels ===============================================================================
+
+#ifdef DECRYPT_KERNELS_X86
+
+/**
+ * @fn build_shift_pattern
+ *
+ * @param key: The Vigenere key.
+ * @param key_len: Number of letters in key.
+ * @param pattern: Receives (26 - shift) for every key position, repeated until it is
+ *                 key_len + MAX_VECTOR_WIDTH bytes long so a full vector can be loaded from any
+ *                 key position.
+ *
+ */
+static void build_shift_pattern (const char* key, unsigned int key_len, unsigned char* pattern)
+{
+    for (unsigned int i = 0; i < key_len + MAX_VECTOR_WIDTH; i++)
+        pattern[i] = 26 - ((unsigned char)(key[i % key_len] - 'A') % 26);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i shift_block_sse2 (__m128i x, __m128i add)
+{
+    const __m128i first_letter = _mm_set1_epi8 ('A');
+    const __m128i last_index = _mm_set1_epi8 (25);
+    const __m128i alphabet = _mm_set1_epi8 (26);
+
+    __m128i index = _mm_sub_epi8 (x, first_letter);
+    __m128i is_letter = _mm_cmpeq_epi8 (_mm_min_epu8 (index, last_index), index);
+
+    __m128i shifted = _mm_add_epi8 (index, add);
+    __m128i wrapped = _mm_cmpeq_epi8 (_mm_max_epu8 (shifted, alphabet), shifted);
+    shifted = _mm_sub_epi8 (shifted, _mm_and_si128 (wrapped, alphabet));
+    shifted = _mm_add_epi8 (shifted, first_letter);
+
+    return _mm_or_si128 (_mm_and_si128 (is_letter, shifted), _mm_andnot_si128 (is_letter, x));
+}
+
+__attribute__((target("sse2")))
+static void caesar_sse2 (const char* in, char* out, std::size_t len, unsigned int shift)
+{
+    const __m128i add = _mm_set1_epi8 ((char)(26 - shift));
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i x = _mm_loadu_si128 ((const __m128i*)(in + i));
+        _mm_storeu_si128 ((__m128i*)(out + i), shift_block_sse2 (x, add));
+    }
+    caesar_scalar (in + i, out + i, len - i, shift);
+}
+
+__attribute__((target("sse2")))
+static void vigenere_sse2 (const char* in, char* out, std::size_t len,
+                           const unsigned char* pattern, unsigned int key_len,
+                           unsigned int key_offset)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i x = _mm_loadu_si128 ((const __m128i*)(in + i));
+        __m128i add = _mm_loadu_si128 ((const __m128i*)(pattern + key_offset));
+        _mm_storeu_si128 ((__m128i*)(out + i), shift_block_sse2 (x, add));
+        key_offset = (key_offset + 16) % key_len;
+    }
+    for (; i < len; i++)
+    {
+        out[i] = shift_byte (in[i], pattern[key_offset]);
+        if (++key_offset == key_len)
+            key_offset = 0;
+    }
+}
+
+
+// === AVX2 Kernels ===============================================================================
+
+__attribute__((target("avx2")))
+static inline __m256i shift_block_avx2 (__m256i x, __m256i add)
+{
+    const __m256i first_letter = _mm256_set1_epi8 ('A');
+    const __m256i last_index = _mm256_set1_epi8 (25);
+    const __m256i alphabet = _mm256_set1_epi8 (26);
+
+    __m256i index = _mm256_sub_epi8 (x, first_letter);
+    __m256i is_letter = _mm256_cmpeq_epi8 (_mm256_min_epu8 (index, last_index), index);
+
+    __m256i shifted = _mm256_add_epi8 (index, add);
+    __m256i wrapped = _mm256_cmpeq_epi8 (_mm256_max_epu8 (shifted, alphabet), shifted);
+    shifted = _mm256_sub_epi8 (shifted, _mm256_and_si256 (wrapped, alphabet));
+    shifted = _mm256_add_epi8 (shifted, first_letter);
+
+    return _mm256_blendv_epi8 (x, shifted, is_letter);
+}
+
+__attribute__((target("avx2")))
+static void caesar_avx2 (const char* in, char* out, std::size_t len, unsigned int shift)
+{
+    const __m256i add = _mm256_set1_epi8 ((char)(26 - shift));
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256 ((const __m256i*)(in + i));
+        _mm256_storeu_si256 ((__m256i*)(out + i), shift_block_avx2 (x, add));
+    }
+    caesar_sse2 (in + i, out + i, len - i, shift);
+}
+
+__attribute__((target("avx2")))
+static void vigenere_avx2 (const char* in, char* out, std::size_t len,
+                           const unsigned char* pattern, unsigned int key_len,
+                           unsigned int key_offset)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256 ((const __m256i*)(in + i));
+        __m256i add = _mm256_loadu_si256 ((const __m256i*)(pattern + key_offset));
+        _mm256_storeu_si256 ((__m256i*)(out + i), shift_block_avx2 (x, add));
+        key_offset = (key_offset + 32) % key_len;
+    }
+    vigenere_sse2 (in + i, out + i, len - i, pattern, key_len, key_offset);
+}
+
+
+// === AVX-512 Kernels ============================================================================
+
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i shift_block_avx512 (__m512i x, __m512i add)
+{
+    const __m512i first_letter = _mm512_set1_epi8 ('A');
+    const __m512i alphabet = _mm512_set1_epi8 (26);
+
+    __m512i index = _mm512_sub_epi8 (x, first_letter);
+    __mmask64 is_letter = _mm512_cmplt_epu8_mask (index, alphabet);
+
+    __m512i shifted = _mm512_add_epi8 (index, add);
+    __mmask64 wrapped = _mm512_cmpge_epu8_mask (shifted, alphabet);
+    shifted = _mm512_mask_sub_epi8 (shifted, wrapped, shifted, alphabet);
+    shifted = _mm512_add_epi8 (shifted, first_letter);
+
+    return _mm512_mask_blend_epi8 (is_letter, x, shifted);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void caesar_avx512 (const char* in, char* out, std::size_t len, unsigned int shift)
+{
+    const __m512i add = _mm512_set1_epi8 ((char)(26 - shift));
+    std::size_t i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i x = _mm512_loadu_si512 ((const void*)(in + i));
+        _mm512_storeu_si512 ((void*)(out + i), shift_block_avx512 (x, add));
+    }
+
+    // The tail is handled with a masked load and store instead of a scalar loop
+    if (i < len)
+    {
+        __mmask64 tail = (~(__mmask64)0) >> (64 - (len - i));
+        __m512i x = _mm512_maskz_loadu_epi8 (tail, (const void*)(in + i));
+        _mm512_mask_storeu_epi8 ((void*)(out + i), tail, shift_block_avx512 (x, add));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void vigenere_avx512 (const char* in, char* out, std::size_t len,
+                             const unsigned char* pattern, unsigned int key_len,
+                             unsigned int key_offset)
+{
+    std::size_t i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i x = _mm512_loadu_si512 ((const void*)(in + i));
+        __m512i add = _mm512_loadu_si512 ((const void*)(pattern + key_offset));
+        _mm512_storeu_si512 ((void*)(out + i), shift_block_avx512 (x, add));
+        key_offset = (key_offset + 64) % key_len;
+    }
+
+    if (i < len)
+    {
+        __mmask64 tail = (~(__mmask64)0) >> (64 - (len - i));
+        __m512i x = _mm512_maskz_loadu_epi8 (tail, (const void*)(in + i));
+        __m512i add = _mm512_loadu_si512 ((const void*)(pattern + key_offset));
+        _mm512_mask_storeu_epi8 ((void*)(out + i), tail, shift_block_avx512 (x, add));
+    }
+}
+
+#endif
+
+
+// === Dispatch Functions =========================================================================
+
+/**
+ * @fn active_kernel_level
+ *
+ * @return The level currently used by the kernels; starts at the best the CPU supports.
+ *
+ */
+static std::atomic <int>& active_kernel_level ()
+{
+    static std::atomic <int> level (get_supported_kernel_level());
+    return level;
+}
+
+/**
+ * @fn get_supported_kernel_level
+ *
+ * @return The widest set of kernels the running CPU supports.
+ *
+ */
+DecryptKernelLevel get_supported_kernel_level ()
+{
+#ifdef DECRYPT_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports ("avx512bw") && __builtin_cpu_supports ("avx512f"))
+        return KERNEL_AVX512;
+    if (__builtin_cpu_supports ("avx2"))
+        return KERNEL_AVX2;
+    if (__builtin_cpu_supports ("sse2"))
+        return KERNEL_SSE2;
+#endif
+    return KERNEL_SCALAR;
+}
+
+DecryptKernelLevel get_decrypt_kernel_level ()
+{
+    return (DecryptKernelLevel)active_kernel_level().load (std::memory_order_relaxed);
+}
+
+/**
+ * @fn set_decrypt_kernel_level
+ *
+ * @param level: The kernels to use from now on; lowered to what the CPU supports if needed.
+ *
+ * @brief Overrides the kernel selection, e.g. to compare the kernels against each other.
+ *
+ */
+void set_decrypt_kernel_level (DecryptKernelLevel level)
+{
+    if (level > get_supported_kernel_level())
+        level = get_supported_kernel_level();
+    active_kernel_level().store (level, std::memory_order_relaxed);
+}
+
+const char* get_decrypt_kernel_name ()
+{
+    switch (get_decrypt_kernel_level())
+    {
+        case KERNEL_AVX512: return "avx512";
+        case KERNEL_AVX2:   return "avx2";
+        case KERNEL_SSE2:   return "sse2";
+        default:            return "scalar";
+    }
+}
+
+
+// === Kernels ====================================================================================
+
+/**
+ * @fn decrypt_caesar_span
+ *
+ * @param in: Ciphertext buffer.
+ * @param out: Receives len bytes of plaintext; may be the same buffer as in.
+ * @param len: Number of bytes to decrypt.
+ * @param shift: The key as a shift from 0 to 25.
+ *
+ * @brief Undoes a Caesar shift on the letters A-Z of a buffer; all other bytes are copied.
+ *
+ */
+void decrypt_caesar_span (const char* in, char* out, std::size_t len, unsigned int shift)
+{
+    shift %= 26;
+
+    switch (get_decrypt_kernel_level())
+    {
+#ifdef DECRYPT_KERNELS_X86
+        case KERNEL_AVX512: caesar_avx512 (in, out, len, shift); return;
+        case KERNEL_AVX2:   caesar_avx2 (in, out, len, shift); return;
+        case KERNEL_SSE2:   caesar_sse2 (in, out, len, shift); return;
+#endif
+        default:            caesar_scalar (in, out, len, shift); return;
+    }
+}
+
+/**
+ * @fn decrypt_vigenere_span
+ *
+ * @param in: Ciphertext buffer.
+ * @param out: Receives len bytes of plaintext; may be the same buffer as in.
+ * @param len: Number of bytes to decrypt.
+ * @param key: The key, as letters A-Z.
+ * @param key_len: Number of letters in key.
+ * @param key_offset: Key position of the first byte, so a text can be decrypted in pieces.
+ *
+ * @brief Undoes a Vigenere cipher on a buffer. Every byte uses up one key position; only the
+ *        letters A-Z are changed.
+ *
+ */
+void decrypt_vigenere_span (const char* in, char* out, std::size_t len, const char* key,
+                            unsigned int key_len, unsigned int key_offset)
+{
+    if (key_len == 0)
+        return;
+    key_offset %= key_len;
+
+    DecryptKernelLevel level = get_decrypt_kernel_level();
+    if ((level == KERNEL_SCALAR) || (key_len > MAX_VECTOR_KEY_LENGTH))
+    {
+        vigenere_scalar (in, out, len, key, key_len, key_offset);
+        return;
+    }
+
+#ifdef DECRYPT_KERNELS_X86
+    unsigned char pattern[MAX_VECTOR_KEY_LENGTH + MAX_VECTOR_WIDTH];
+    build_shift_pattern (key, key_len, pattern);
+
+    switch (level)
+    {
+        case KERNEL_AVX512: vigenere_avx512 (in, out, len, pattern, key_len, key_offset); return;
+        case KERNEL_AVX2:   vigenere_avx2 (in, out, len, pattern, key_len, key_offset); return;
+        default:            vigenere_sse2 (in, out, len, pattern, key_len, key_offset); return;
+    }
+#endif
+}
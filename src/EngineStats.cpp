@@ -0,0 +1,197 @@
+/**
+ * @file EngineStats.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the EngineStats class.
+ *
+ * @see EngineStats.hpp
+ *
+ */
+
+
+#include "EngineStats.hpp"
+
+#include <sstream>
+
+// Allocation count of the current thread; incremented by the operator new in AllocationCounter.cpp
+thread_local std::uint64_t thread_allocation_count = 0;
+
+std::uint64_t get_thread_allocations ()
+{
+    return thread_allocation_count;
+}
+
+// === Ctors ======================================================================================
+
+EngineStats::EngineStats ()
+{
+    message_size = 0;
+    reset();
+}
+
+
+// === Recording Functions ========================================================================
+
+/**
+ * @fn EngineStats::reset
+ *
+ * @brief Zeroes the totals of every stage.
+ *
+ */
+void EngineStats::reset ()
+{
+    for (unsigned int i = 0; i < STAGE_COUNT; i++)
+        stages[i] = StageStats();
+}
+
+/**
+ * @fn EngineStats::record
+ *
+ * @param stage: The stage that ran.
+ * @param calls: Number of calls the run stands for.
+ * @param bytes: Number of input bytes processed.
+ * @param wall_ns: Wall time of the run in nanoseconds.
+ * @param allocations: Heap allocations made during the run.
+ *
+ * @brief Adds one run of a stage to its totals, tracks the slowest run seen and counts the run
+ *        in the latency histogram under the size of the message it was part of.
+ *
+ */
+void EngineStats::record (EngineStage stage, std::uint64_t calls, std::uint64_t bytes,
+                          std::uint64_t wall_ns, std::uint64_t allocations)
+{
+    StageStats& s = stages[stage];
+    s.calls += calls;
+    s.bytes += bytes;
+    s.wall_ns += wall_ns;
+    s.allocations += allocations;
+    if (wall_ns > s.max_wall_ns)
+        s.max_wall_ns = wall_ns;
+    s.latency[bucket_of (message_size, LATENCY_SIZE_BUCKETS)]
+             [bucket_of (wall_ns, LATENCY_TIME_BUCKETS)]++;
+}
+
+/**
+ * @fn EngineStats::merge
+ *
+ * @param other: Stats of another engine, e.g. one of the per-thread engines of batch mode.
+ *
+ * @brief Adds the totals and histograms of other to these, so the stats of every engine a run
+ *        used can be printed as one.
+ *
+ */
+void EngineStats::merge (const EngineStats& other)
+{
+    for (unsigned int i = 0; i < STAGE_COUNT; i++)
+    {
+        StageStats& s = stages[i];
+        const StageStats& o = other.stages[i];
+        s.calls += o.calls;
+        s.bytes += o.bytes;
+        s.wall_ns += o.wall_ns;
+        s.allocations += o.allocations;
+        if (o.max_wall_ns > s.max_wall_ns)
+            s.max_wall_ns = o.max_wall_ns;
+
+        for (unsigned int r = 0; r < LATENCY_SIZE_BUCKETS; r++)
+        {
+            for (unsigned int c = 0; c < LATENCY_TIME_BUCKETS; c++)
+                s.latency[r][c] += o.latency[r][c];
+        }
+    }
+}
+
+
+// === Output Functions ===========================================================================
+
+/**
+ * @fn EngineStats::to_json
+ *
+ * @return A JSON object with one entry per stage, e.g.
+ *         {"analyze":{"calls":1,"bytes":340,"wall_ns":2100,"max_wall_ns":2100,
+ *         "allocations":0,"mb_per_s":161.9,"latency":[[256,2048,1]]},...}
+ *         Each nonzero cell of the latency histogram is listed as [smallest message size in
+ *         bytes, shortest wall time in ns, runs] of its buckets, by size and then time.
+ *
+ */
+std::string EngineStats::to_json () const
+{
+    std::ostringstream json;
+    json << '{';
+
+    for (unsigned int i = 0; i < STAGE_COUNT; i++)
+    {
+        const StageStats& s = stages[i];
+        double mb_per_s = (s.wall_ns > 0) ? ((double)s.bytes * 1e3) / (double)s.wall_ns : 0.0;
+
+        json << (i ? "," : "") << '"' << get_stage_name ((EngineStage)i) << "\":{"
+             << "\"calls\":" << s.calls << ",\"bytes\":" << s.bytes
+             << ",\"wall_ns\":" << s.wall_ns << ",\"max_wall_ns\":" << s.max_wall_ns
+             << ",\"allocations\":" << s.allocations << ",\"mb_per_s\":" << mb_per_s
+             << ",\"latency\":[";
+
+        bool first = true;
+        for (unsigned int r = 0; r < LATENCY_SIZE_BUCKETS; r++)
+        {
+            for (unsigned int c = 0; c < LATENCY_TIME_BUCKETS; c++)
+            {
+                if (s.latency[r][c] == 0)
+                    continue;
+                json << (first ? "" : ",") << '[' << bucket_floor (r) << ',' << bucket_floor (c)
+                     << ',' << s.latency[r][c] << ']';
+                first = false;
+            }
+        }
+        json << "]}";
+    }
+
+    json << '}';
+    return json.str();
+}
+
+
+// === Accessors ==================================================================================
+
+/**
+ * @fn EngineStats::bucket_of
+ *
+ * @param value: A message size or wall time.
+ * @param buckets: Number of buckets; the last also takes every larger value.
+ * @return The bit width of value, at most buckets - 1.
+ *
+ */
+unsigned int EngineStats::bucket_of (std::uint64_t value, unsigned int buckets)
+{
+    unsigned int width = 0;
+    for (; (value != 0) && (width + 1 < buckets); value >>= 1)
+        width++;
+    return width;
+}
+
+/**
+ * @fn EngineStats::bucket_floor
+ *
+ * @param bucket: A bucket of a latency histogram axis.
+ * @return The smallest value counted in it.
+ *
+ */
+std::uint64_t EngineStats::bucket_floor (unsigned int bucket)
+{
+    return (bucket == 0) ? 0 : std::uint64_t (1) << (bucket - 1);
+}
+
+const char* EngineStats::get_stage_name (EngineStage stage)
+{
+    switch (stage)
+    {
+        case STAGE_ANALYZE:    return "analyze";
+        case STAGE_KEY_LENGTH: return "key_length";
+        case STAGE_SPLIT:      return "split";
+        case STAGE_COLUMNS:    return "columns";
+        case STAGE_REFINE:     return "refine";
+        case STAGE_DECRYPT:    return "decrypt";
+        default:               return "unknown";
+    }
+}
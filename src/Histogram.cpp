@@ -0,0 +1,181 @@
+/**
+ * @file Histogram.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the Histogram class.
+ *
+ * @see Histogram.hpp
+ *
+ */
+
+
+#include "Histogram.hpp"
+
+#include <cstring>
+
+/*
+ * Largest number of bytes handed to the lane counters before they are folded into the 64-bit
+ * totals; keeps every 32-bit lane counter well clear of overflow
+ */
+const std::size_t HISTOGRAM_BLOCK_SIZE = std::size_t (1) << 30;
+
+
+// === Ctors ======================================================================================
+
+Histogram::Histogram ()
+{
+    clear();
+}
+
+
+// === Counting Functions =========================================================================
+
+/**
+ * @fn Histogram::count
+ *
+ * @param buf: Buffer of bytes to be counted.
+ * @param len: Number of bytes in buf.
+ *
+ * @brief Adds the bytes in buf to the histogram. Work is split over HISTOGRAM_LANES interleaved
+ *        sub-histograms which are merged once the buffer has been consumed.
+ *
+ * @post byte_counts, letter_counts and the totals include every byte of buf.
+ *
+ */
+void Histogram::count (const char* buf, std::size_t len)
+{
+    const unsigned char* data = (const unsigned char*) buf;
+    std::uint32_t lanes[HISTOGRAM_LANES][BYTE_BINS];
+
+    while (len > 0)
+    {
+        std::size_t block = (len < HISTOGRAM_BLOCK_SIZE) ? len : HISTOGRAM_BLOCK_SIZE;
+        std::memset (lanes, 0, sizeof (lanes));
+
+        // Main loop hands each of four consecutive bytes to its own sub-histogram
+        std::size_t i = 0;
+        for (; i + HISTOGRAM_LANES <= block; i += HISTOGRAM_LANES)
+        {
+            lanes[0][data[i]]++;
+            lanes[1][data[i + 1]]++;
+            lanes[2][data[i + 2]]++;
+            lanes[3][data[i + 3]]++;
+        }
+        for (; i < block; i++)
+            lanes[0][data[i]]++;
+
+        // Fold the sub-histograms back together
+        for (unsigned int b = 0; b < BYTE_BINS; b++)
+        {
+            std::uint64_t merged = 0;
+            for (unsigned int l = 0; l < HISTOGRAM_LANES; l++)
+                merged += lanes[l][b];
+            if (merged != 0)
+                add_byte_run ((unsigned char) b, merged);
+        }
+
+        data += block;
+        len -= block;
+    }
+}
+
+/**
+ * @fn Histogram::count_letters
+ *
+ * @param letters: Letter indices 0-25, e.g. from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ *
+ * @brief Adds a normalized text to the histogram, each index counting as its upper case letter.
+ *        Indices need no range check, so the lanes are only LETTER_BINS wide.
+ *
+ * @post byte_counts, letter_counts and the totals include every letter.
+ *
+ */
+void Histogram::count_letters (const std::uint8_t* letters, std::size_t len)
+{
+    while (len > 0)
+    {
+        std::size_t block = (len < HISTOGRAM_BLOCK_SIZE) ? len : HISTOGRAM_BLOCK_SIZE;
+        std::uint32_t lanes[HISTOGRAM_LANES][LETTER_BINS] = {};
+
+        std::size_t i = 0;
+        for (; i + HISTOGRAM_LANES <= block; i += HISTOGRAM_LANES)
+        {
+            lanes[0][letters[i]]++;
+            lanes[1][letters[i + 1]]++;
+            lanes[2][letters[i + 2]]++;
+            lanes[3][letters[i + 3]]++;
+        }
+        for (; i < block; i++)
+            lanes[0][letters[i]]++;
+
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+        {
+            std::uint64_t merged = 0;
+            for (unsigned int l = 0; l < HISTOGRAM_LANES; l++)
+                merged += lanes[l][e];
+            if (merged != 0)
+                add_byte_run ((unsigned char)('A' + e), merged);
+        }
+
+        letters += block;
+        len -= block;
+    }
+}
+
+/**
+ * @fn Histogram::merge
+ *
+ * @param other: Histogram whose counts are added to this one.
+ *
+ * @brief Combines the counts of two histograms, e.g. ones built from different parts of a text.
+ *
+ */
+void Histogram::merge (const Histogram& other)
+{
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+    {
+        if (other.byte_counts[b] != 0)
+            add_byte_run ((unsigned char) b, other.byte_counts[b]);
+    }
+}
+
+/**
+ * @fn Histogram::clear
+ *
+ * @brief Resets every count in the histogram to zero.
+ *
+ */
+void Histogram::clear ()
+{
+    byte_counts.fill (0);
+    letter_counts.fill (0);
+    total = 0;
+    letter_total = 0;
+    coincidences = 0;
+}
+
+/**
+ * @fn Histogram::add_byte_run
+ *
+ * @param b: The byte value being counted.
+ * @param n: How many instances of b to add.
+ *
+ * @brief Adds n instances of a single byte, keeping the letter table and totals in step.
+ *
+ */
+void Histogram::add_byte_run (unsigned char b, std::uint64_t n)
+{
+    // (c + n)(c + n - 1) - c(c - 1) = n(2c + n - 1)
+    coincidences += n * (2 * byte_counts[b] + n - 1);
+    byte_counts[b] += n;
+    total += n;
+
+    if ((b >= 'A') && (b <= 'Z'))
+    {
+        letter_counts[b - 'A'] += n;
+        letter_total += n;
+    }
+}
@@ -0,0 +1,215 @@
+/**
+ * @file KasiskiSearch.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the KasiskiSearch class.
+ *
+ * @see KasiskiSearch.hpp
+ *
+ */
+
+
+#include "KasiskiSearch.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+// === Ctors ======================================================================================
+
+KasiskiSearch::KasiskiSearch ()
+{
+    last_trigram.resize (TRIGRAM_SLOTS);
+    long_codes.resize (LONG_REPEAT_SLOTS);
+    long_positions.resize (LONG_REPEAT_SLOTS);
+    distances.resize (MAX_REPEAT_DISTANCE + 1);
+
+    // Position 0 is never used, so the zeroed index starts out empty
+    position = 1;
+    longest_distance = 0;
+    reset (0);
+}
+
+
+// === Search Functions ===========================================================================
+
+/**
+ * @fn KasiskiSearch::reset
+ *
+ * @param max: Longest period evidence is gathered for.
+ *
+ * @brief Clears the repeat index and every count so a new text can be scanned. Memory is fixed
+ *        at a few hundred kilobytes however long the text is, and only the part of it the last
+ *        text touched is cleared, so searching many short texts in a row stays cheap.
+ *
+ */
+void KasiskiSearch::reset (unsigned int max)
+{
+    max_period = max;
+    factor_counts.assign (max_period + 1, 0);
+    gcd_counts.assign (max_period + 1, 0);
+
+    // The repeat index is emptied by moving origin past everything in it
+    std::fill (distances.begin(), distances.begin() + longest_distance + 1, 0);
+    origin = position;
+
+    repeat_total = 0;
+    gcd_total = 0;
+    last_long_distance = 0;
+    longest_distance = 0;
+    trigram = 0;
+    run_length = 0;
+    rolling_code = 0;
+}
+
+/**
+ * @fn KasiskiSearch::count
+ *
+ * @param letters: Ciphertext to be scanned, as letter indices 0-25 from LetterBuffer.
+ * @param len: Number of letters.
+ *
+ * @brief Finds repeated trigrams through an exact index of each trigram's latest position, and
+ *        repeated runs of LONG_REPEAT_LENGTH letters through a bounded rolling hash table. The
+ *        distance from each repeat back to its previous occurrence is recorded. One pass, O(1)
+ *        work per letter, no pairwise comparisons. Positions count letters, since every letter
+ *        uses up a key position. The scan state carries over between calls.
+ *
+ * @post tally must be called before the evidence reflects the new text.
+ *
+ */
+void KasiskiSearch::count (const std::uint8_t* letters, std::size_t len)
+{
+    std::uint64_t scanned = position - origin;
+    if (scanned >= MAX_KASISKI_SAMPLE)
+        return;
+    len = (std::size_t)std::min <std::uint64_t> (len, MAX_KASISKI_SAMPLE - scanned);
+
+    for (std::size_t i = 0; i < len; i++, position++)
+    {
+        unsigned int letter = letters[i];
+        trigram = (trigram * LETTER_BINS + letter) % TRIGRAM_SLOTS;
+        rolling_code = (std::uint32_t)(((std::uint64_t)rolling_code * LETTER_BINS + letter)
+                                       % LONG_REPEAT_CODES);
+        if (++run_length < 3)
+            continue;
+
+        // Positions are those of the last letter of each run
+        std::uint64_t previous = last_trigram[trigram];
+        last_trigram[trigram] = position;
+        if (previous >= origin)
+            add_distance (position - previous, 1);
+
+        if (run_length < LONG_REPEAT_LENGTH)
+            continue;
+
+        // Fibonacci hashing spreads the codes over the table
+        unsigned int slot = (std::uint32_t)(rolling_code * 2654435761u)
+                            >> (32 - LONG_REPEAT_SLOT_BITS);
+        if ((long_positions[slot] >= origin) && (long_codes[slot] == rolling_code))
+        {
+            std::uint64_t distance = position - long_positions[slot];
+            add_distance (distance, LONG_REPEAT_WEIGHT);
+
+            // Successive long repeats usually share the key length as their greatest factor
+            if (distance <= MAX_REPEAT_DISTANCE)
+            {
+                if (last_long_distance != 0)
+                {
+                    std::uint64_t divisor = std::gcd (distance, last_long_distance);
+                    if ((divisor >= 2) && (divisor <= max_period))
+                        gcd_counts[divisor] += LONG_REPEAT_WEIGHT;
+                    gcd_total += LONG_REPEAT_WEIGHT;
+                }
+                last_long_distance = distance;
+            }
+        }
+        long_codes[slot] = rolling_code;
+        long_positions[slot] = position;
+    }
+}
+
+/**
+ * @fn KasiskiSearch::tally
+ *
+ * @brief Turns the distance histogram into the number of distances each period divides. Takes
+ *        O(D log(max_period)) time, where D is the longest distance recorded; that is
+ *        at most MAX_REPEAT_DISTANCE whatever the length of the text.
+ *
+ * @post get_factor_count and get_evidence reflect everything counted so far.
+ *
+ */
+void KasiskiSearch::tally ()
+{
+    std::fill (factor_counts.begin(), factor_counts.end(), 0);
+    if (max_period >= 1)
+        factor_counts[1] = repeat_total;
+
+    for (unsigned int p = 2; p <= max_period; p++)
+    {
+        std::uint64_t total = 0;
+        for (std::uint64_t d = p; d <= longest_distance; d += p)
+            total += distances[d];
+        factor_counts[p] = total;
+    }
+}
+
+/**
+ * @fn KasiskiSearch::add_distance
+ *
+ * @param distance: Number of bytes between a repeat and its previous occurrence.
+ * @param weight: How much the repeat counts for.
+ *
+ */
+void KasiskiSearch::add_distance (std::uint64_t distance, unsigned int weight)
+{
+    if (distance > MAX_REPEAT_DISTANCE)
+        return;
+
+    distances[distance] += weight;
+    repeat_total += weight;
+    longest_distance = std::max (longest_distance, distance);
+}
+
+
+// === Accessors ==================================================================================
+
+/**
+ * @fn KasiskiSearch::get_evidence
+ *
+ * @param period: A candidate key length.
+ * @return How strongly the repeats point at period, from 0 (no better than chance) up to 1.
+ *
+ * @brief Compares the share of repeat distances divisible by period with the 1 / period share
+ *        expected by chance, then scales it down when there are only a few repeats. Multiples of
+ *        the key length score lower than the key length itself, as only some of the distances
+ *        they would need divide them. The multiples fall further behind as the score is then
+ *        scaled by the share of long repeat GCDs that period divides, since chance factors
+ *        mostly cancel out of a GCD.
+ *
+ * @pre tally has been called.
+ *
+ */
+double KasiskiSearch::get_evidence (unsigned int period) const
+{
+    if ((period < 2) || (period > max_period) || (repeat_total == 0))
+        return 0.0;
+
+    double total = (double)repeat_total;
+    double chance = 1.0 / (double)period;
+    double share = (double)factor_counts[period] / total;
+    double excess = (share - chance) / (1.0 - chance);
+    if (excess <= 0.0)
+        return 0.0;
+
+    if (gcd_total != 0)
+    {
+        std::uint64_t divided = 0;
+        for (unsigned int g = period; g <= max_period; g += period)
+            divided += gcd_counts[g];
+        double gcd_share = (double)divided / (double)gcd_total;
+        excess += KASISKI_GCD_SHARE * gcd_share * (1.0 - excess);
+    }
+
+    return excess * (total / (total + KASISKI_HALF_CONFIDENCE));
+}
@@ -0,0 +1,209 @@
+/**
+ * @file KeyEnumerator.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the KeyEnumerator class.
+ *
+ * @see KeyEnumerator.hpp
+ *
+ */
+
+
+#include "KeyEnumerator.hpp"
+
+#include <algorithm>
+
+/*
+ * Steps that make a queued key from the popped key it came from: the key made from no shift
+ * changes at all, the next shift down at the last position changed, the second best shift at
+ * the next position, and the last position back to its best while the next takes its second
+ */
+const unsigned int ENUMERATE_ROOT = 0;
+const unsigned int ENUMERATE_DEEPEN = 1;
+const unsigned int ENUMERATE_EXTEND = 2;
+const unsigned int ENUMERATE_MOVE = 3;
+
+// Parent of the root key, which has none
+const unsigned int NO_PARENT = ~0u;
+
+
+// === Ctors ======================================================================================
+
+KeyEnumerator::KeyEnumerator ()
+{
+    candidate_count = 0;
+}
+
+
+// === Enumeration Functions ======================================================================
+
+/**
+ * @fn KeyEnumerator::enumerate
+ *
+ * @param scores: LETTER_BINS scores per column, column c's score for shift s at
+ *                c * LETTER_BINS + s; higher is more likely. e.g. the column correlations.
+ * @param columns: Number of columns, i.e. the key length.
+ * @param count: Number of keys wanted.
+ *
+ * @brief Lists the count best keys by the sum of their column scores, best first, with a
+ *        best-first search over the columns' sorted scores. Each key is reached from exactly
+ *        one better or equal key by one of three steps (see ENUMERATE_DEEPEN), so a popped key
+ *        queues at most three more and nothing is ever queued twice. Nothing is decrypted, and
+ *        the work is O(count * (columns + log count)) after sorting the columns.
+ *
+ * @post get_candidates holds min(count, 26^columns) keys, best first.
+ *
+ */
+void KeyEnumerator::enumerate (const double* scores, unsigned int columns, unsigned int count)
+{
+    candidate_count = 0;
+    queue.clear();
+    if ((columns == 0) || (count == 0))
+    {
+        candidates.clear();
+        return;
+    }
+
+    // Sort each column's shifts from best to worst
+    sorted_shifts.resize (columns * LETTER_BINS);
+    sorted_scores.resize (columns * LETTER_BINS);
+    double root_score = 0.0;
+    for (unsigned int c = 0; c < columns; c++)
+    {
+        const double* column = scores + c * LETTER_BINS;
+        unsigned char* shifts = &sorted_shifts[c * LETTER_BINS];
+        for (unsigned int s = 0; s < LETTER_BINS; s++)
+            shifts[s] = (unsigned char)s;
+        std::sort (shifts, shifts + LETTER_BINS, [column] (unsigned char a, unsigned char b) {
+            return (column[a] != column[b]) ? (column[a] > column[b]) : (a < b);
+        });
+        for (unsigned int r = 0; r < LETTER_BINS; r++)
+            sorted_scores[c * LETTER_BINS + r] = column[shifts[r]];
+        root_score += sorted_scores[c * LETTER_BINS];
+    }
+
+    // Loss of taking the rank + 1 shift of the column at a position instead of its rank shift
+    auto step_loss = [this] (unsigned int position, unsigned int rank) {
+        const double* column = &sorted_scores[order[position] * LETTER_BINS];
+        return column[rank] - column[rank + 1];
+    };
+
+    order.resize (columns);
+    for (unsigned int c = 0; c < columns; c++)
+        order[c] = c;
+    std::sort (order.begin(), order.end(), [this] (unsigned int a, unsigned int b) {
+        double loss_a = sorted_scores[a * LETTER_BINS] - sorted_scores[a * LETTER_BINS + 1];
+        double loss_b = sorted_scores[b * LETTER_BINS] - sorted_scores[b * LETTER_BINS + 1];
+        return (loss_a != loss_b) ? (loss_a < loss_b) : (a < b);
+    });
+
+    auto worse = [] (const Node& a, const Node& b) { return a.score < b.score; };
+    auto push = [this, &worse] (double score, unsigned int parent, unsigned int position,
+                                unsigned int op) {
+        queue.push_back ({ score, parent, position, op });
+        std::push_heap (queue.begin(), queue.end(), worse);
+    };
+
+    // Rank storage is sized up front so a key's parent ranks never move while it is built
+    ranks.resize ((std::size_t)count * columns);
+    if (candidates.size() < count)
+        candidates.resize (count);
+
+    push (root_score, NO_PARENT, 0, ENUMERATE_ROOT);
+    while ((!queue.empty()) && (candidate_count < count))
+    {
+        std::pop_heap (queue.begin(), queue.end(), worse);
+        Node node = queue.back();
+        queue.pop_back();
+
+        unsigned char* rank = &ranks[(std::size_t)candidate_count * columns];
+        if (node.parent == NO_PARENT)
+            std::fill (rank, rank + columns, 0);
+        else
+            std::copy_n (&ranks[(std::size_t)node.parent * columns], columns, rank);
+
+        unsigned int j = node.position;
+        if (node.op == ENUMERATE_DEEPEN)
+            rank[j]++;
+        else if (node.op == ENUMERATE_EXTEND)
+            rank[j] = 1;
+        else if (node.op == ENUMERATE_MOVE)
+        {
+            rank[j - 1] = 0;
+            rank[j] = 1;
+        }
+
+        KeyCandidate& candidate = candidates[candidate_count];
+        candidate.key.assign (columns, 'A');
+        for (unsigned int p = 0; p < columns; p++)
+            candidate.key[order[p]] += sorted_shifts[order[p] * LETTER_BINS + rank[p]];
+        candidate.score = node.score;
+        candidate.fitness = 0.0;
+
+        // The columns are ordered so that none of the three steps can raise the score
+        bool root = (node.op == ENUMERATE_ROOT);
+        if ((!root) && (rank[j] + 1u < LETTER_BINS))
+            push (node.score - step_loss (j, rank[j]), candidate_count, j, ENUMERATE_DEEPEN);
+
+        unsigned int next = root ? 0 : j + 1;
+        if (next < columns)
+        {
+            push (node.score - step_loss (next, 0), candidate_count, next, ENUMERATE_EXTEND);
+            if ((!root) && (rank[j] == 1))
+                push (node.score + step_loss (j, 0) - step_loss (next, 0), candidate_count, next,
+                      ENUMERATE_MOVE);
+        }
+
+        candidate_count++;
+    }
+
+    candidates.resize (candidate_count);
+}
+
+/**
+ * @fn KeyEnumerator::rescore
+ *
+ * @param letters: The ciphertext as letter indices 0-25, from LetterBuffer.
+ * @param len: Number of letters.
+ * @param scorer: n-gram tables of the plaintext language.
+ * @param top: Number of candidates, from the best, to rescore.
+ *
+ * @brief Decrypts the text with each of the top candidates and reorders them by quadgram
+ *        fitness, which tells a readable key from one that only has good letter counts. The
+ *        rest of the list is left in score order below them.
+ *
+ * @pre enumerate has been called with keys for the same text.
+ * @post The first min(top, candidates) candidates have their fitness set, most fit first.
+ *
+ */
+void KeyEnumerator::rescore (const std::uint8_t* letters, std::size_t len,
+                             const NgramScorer& scorer, unsigned int top)
+{
+    top = std::min <unsigned int> (top, candidates.size());
+    if ((top == 0) || (len == 0))
+        return;
+
+    plain.resize (len);
+    for (unsigned int i = 0; i < top; i++)
+    {
+        const std::string& key = candidates[i].key;
+        unsigned int period = key.size(), column = 0;
+        for (std::size_t t = 0; t < len; t++)
+        {
+            unsigned int shift = key[column] - 'A';
+            plain[t] = (unsigned char)((letters[t] + LETTER_BINS - shift) % LETTER_BINS);
+            if (++column == period)
+                column = 0;
+        }
+        candidates[i].fitness = scorer.score (plain.data(), len) / (double)len;
+    }
+
+    std::sort (candidates.begin(), candidates.begin() + top,
+               [] (const KeyCandidate& a, const KeyCandidate& b) {
+        if (a.fitness != b.fitness)
+            return a.fitness > b.fitness;
+        return (a.score != b.score) ? (a.score > b.score) : (a.key < b.key);
+    });
+}
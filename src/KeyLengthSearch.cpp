@@ -0,0 +1,367 @@
+/**
+ * @file KeyLengthSearch.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the KeyLengthSearch class.
+ *
+ * @see KeyLengthSearch.hpp
+ *
+ */
+
+
+#include "KeyLengthSearch.hpp"
+
+#include "Histogram.hpp"
+
+#include <algorithm>
+
+// === Ctors ======================================================================================
+
+KeyLengthSearch::KeyLengthSearch (unsigned int max)
+{
+    thread_pool = nullptr;
+    active_period = 0;
+    letters_counted = 0;
+    expected_IC = ENGLISH_IC;
+    set_max_period (max);
+}
+
+
+// === Search Functions ===========================================================================
+
+/**
+ * @fn KeyLengthSearch::reset
+ *
+ * @param limit: Longest period worth counting for the next text; 0 means max_period.
+ *
+ * @brief Clears the counts so a new text can be searched. Tables only grow, so searching many
+ *        short texts in a row does not allocate.
+ *
+ */
+void KeyLengthSearch::reset (unsigned int limit)
+{
+    active_period = ((limit == 0) || (limit > max_period)) ? max_period : limit;
+
+    std::size_t table_size = LETTER_BINS * active_period * (active_period + 1) / 2;
+    if (counts.size() < table_size)
+    {
+        counts.resize (table_size);
+        next_column.resize (active_period + 1);
+        letters_sampled.resize (active_period + 1);
+        average_IC.resize (active_period + 1);
+    }
+
+    std::fill (counts.begin(), counts.begin() + table_size, 0);
+    std::fill (next_column.begin(), next_column.begin() + active_period + 1, 0);
+    std::fill (letters_sampled.begin(), letters_sampled.begin() + active_period + 1, 0);
+    std::fill (average_IC.begin(), average_IC.begin() + active_period + 1, 0.0);
+    candidates.clear();
+    letters_counted = 0;
+    repeats.reset (active_period);
+}
+
+/**
+ * @fn KeyLengthSearch::search
+ *
+ * @param letters: The whole ciphertext, as letter indices 0-25 from LetterBuffer.
+ * @param len: Number of letters.
+ *
+ * @brief Counts and ranks a ciphertext held in memory, skipping periods the text is too short
+ *        to support.
+ *
+ */
+void KeyLengthSearch::search (const std::uint8_t* letters, std::size_t len)
+{
+    unsigned int limit = (unsigned int)std::min <std::uint64_t> (max_period,
+                                                                 len / MIN_COLUMN_LETTERS);
+    reset ((limit == 0) ? 1 : limit);
+    repeats.count (letters, len);
+    count_sample (letters, len);
+    letters_counted = len;
+    rank();
+}
+
+/**
+ * @fn KeyLengthSearch::count
+ *
+ * @param letters: Ciphertext to be counted, as letter indices 0-25 from LetterBuffer.
+ * @param len: Number of letters.
+ *
+ * @brief Adds a chunk of ciphertext to the column counts of every period being searched. The
+ *        text is walked in blocks small enough to stay in cache while every period takes its
+ *        turn on them. Each period stops once its columns hold MAX_COLUMN_SAMPLE letters, so
+ *        very long texts cost no more than a few megabytes' worth. With a thread pool, the
+ *        periods are split into groups that are counted in parallel. Repeats are indexed for the
+ *        Kasiski evidence on the way. Column positions carry over between calls.
+ *
+ * @post rank must be called before the candidates reflect the new text.
+ *
+ */
+void KeyLengthSearch::count (const std::uint8_t* letters, std::size_t len)
+{
+    letters_counted += len;
+    repeats.count (letters, len);
+    count_sample (letters, len);
+}
+
+/**
+ * @fn KeyLengthSearch::merge
+ *
+ * @param table: Counts of another search over a later part of the same text, as returned by its
+ *               get_counts.
+ * @param period_limit: Active period of that search; periods up to the smaller of it and
+ *                      active_period are merged.
+ * @param letters: Number of letters that search counted.
+ * @param offset: Position in the whole text of the first letter that search counted.
+ *
+ * @brief Adds the counts of a search over one shard of a text, e.g. one counted by another
+ *        process. That search started its columns at its own first letter, so the columns of
+ *        each period are rotated by offset to line up with the columns of the whole text.
+ *        Repeats are not merged, so the ranking falls back on the IC alone.
+ *
+ * @post rank must be called before the candidates reflect the merged counts.
+ *
+ */
+void KeyLengthSearch::merge (const std::uint64_t* table, unsigned int period_limit,
+                             std::uint64_t letters, std::uint64_t offset)
+{
+    unsigned int periods = std::min (period_limit, active_period);
+    for (unsigned int p = 1; p <= periods; p++)
+    {
+        const std::uint64_t* source = &table[LETTER_BINS * p * (p - 1) / 2];
+        std::uint64_t* target = &counts[LETTER_BINS * p * (p - 1) / 2];
+        unsigned int shift = (unsigned int)(offset % p);
+
+        for (unsigned int c = 0; c < p; c++)
+        {
+            std::uint64_t* column = &target[((c + shift) % p) * LETTER_BINS];
+            for (unsigned int e = 0; e < LETTER_BINS; e++)
+                column[e] += source[c * LETTER_BINS + e];
+        }
+    }
+    letters_counted += letters;
+}
+
+/**
+ * @fn KeyLengthSearch::count_sample
+ *
+ * @param data: Ciphertext to be counted.
+ * @param len: Number of letters in data.
+ *
+ * @brief Splits the periods being searched into groups and counts each group, in parallel when
+ *        a thread pool is set and the text has at least PARALLEL_MIN_LETTERS letters.
+ *
+ */
+void KeyLengthSearch::count_sample (const std::uint8_t* data, std::size_t len)
+{
+    unsigned int groups = 1;
+    if ((thread_pool != nullptr) && (len >= PARALLEL_MIN_LETTERS))
+        groups = std::min (thread_pool->get_thread_count(), active_period);
+
+    if (groups <= 1)
+    {
+        count_periods (data, len, 1, 1);
+        return;
+    }
+
+    // Longer periods take longer samples, so interleaving the periods keeps the groups balanced
+    thread_pool->parallel_for (groups, [&] (std::size_t g) {
+        count_periods (data, len, 1 + (unsigned int)g, groups);
+    });
+}
+
+/**
+ * @fn KeyLengthSearch::rank
+ *
+ * @brief Calculates the average column IC of every period and scores it together with the
+ *        Kasiski evidence for it. The IC is scaled so random text scores 0 and text in the
+ *        plaintext language 1. Periods whose columns would be too short to give a meaningful IC
+ *        are left out. Periods that come close to the best score are listed first, shortest
+ *        first, since every multiple of the key length scores about as well as the key length
+ *        itself; the rest follow in order of score. Without any repeats this ranks by IC alone.
+ *
+ * @post candidates holds the ranked periods; get_best_period returns the first of them.
+ *
+ */
+void KeyLengthSearch::rank ()
+{
+    candidates.clear();
+
+    unsigned int usable_period = (unsigned int)std::min <std::uint64_t> (active_period,
+                                 letters_counted / MIN_COLUMN_LETTERS);
+    if (usable_period == 0)
+        usable_period = 1;
+
+    repeats.tally();
+
+    double best_score = 0.0;
+    for (unsigned int p = 1; p <= usable_period; p++)
+    {
+        const std::uint64_t* table = &counts[LETTER_BINS * p * (p - 1) / 2];
+        double IC_total = 0.0;
+        unsigned int columns_used = 0;
+
+        for (unsigned int c = 0; c < p; c++)
+        {
+            std::uint64_t column_length = 0, IC_summation = 0;
+            for (unsigned int e = 0; e < LETTER_BINS; e++)
+            {
+                std::uint64_t n = table[c * LETTER_BINS + e];
+                column_length += n;
+                IC_summation += n * (n - 1);
+            }
+
+            if (column_length > 1)
+            {
+                IC_total += (double)IC_summation /
+                            ((double)column_length * (double)(column_length - 1));
+                columns_used++;
+            }
+        }
+
+        average_IC[p] = (columns_used > 0) ? IC_total / (double)columns_used : 0.0;
+
+        double kasiski = repeats.get_evidence (p);
+        double score = (average_IC[p] - RANDOM_IC) / (expected_IC - RANDOM_IC) +
+                       KASISKI_WEIGHT * kasiski;
+        candidates.push_back ({ p, average_IC[p], kasiski, score });
+        best_score = std::max (best_score, score);
+    }
+
+    // Periods are unique, so breaking ties on them gives a total order without a stable sort
+    double threshold = KEY_IC_THRESHOLD * best_score;
+    std::sort (candidates.begin(), candidates.end(),
+               [threshold] (const KeyLengthCandidate& a, const KeyLengthCandidate& b) {
+        bool a_likely = a.score >= threshold, b_likely = b.score >= threshold;
+        if (a_likely != b_likely)
+            return a_likely;
+        if (a_likely || (a.score == b.score))
+            return a.period < b.period;
+        return a.score > b.score;
+    });
+}
+
+/**
+ * @fn KeyLengthSearch::count_periods
+ *
+ * @param data: Ciphertext to be counted.
+ * @param len: Number of letters in data.
+ * @param first: First period to count.
+ * @param stride: Distance between the periods counted; the last is at most active_period.
+ *
+ * @brief Counts a group of periods one cache-sized block of text at a time.
+ *
+ */
+void KeyLengthSearch::count_periods (const std::uint8_t* data, std::size_t len,
+                                     unsigned int first, unsigned int stride)
+{
+    for (std::size_t start = 0; start < len; start += PERIOD_SWEEP_BLOCK)
+    {
+        std::size_t end = std::min (len, start + PERIOD_SWEEP_BLOCK);
+        bool sampling = false;
+
+        for (unsigned int p = first; p <= active_period; p += stride)
+        {
+            std::uint64_t sample_left = p * MAX_COLUMN_SAMPLE - letters_sampled[p];
+            std::size_t period_end = (std::size_t)std::min <std::uint64_t> (end,
+                                                                             start + sample_left);
+            if (period_end <= start)
+                continue;
+
+            std::uint64_t* table = &counts[LETTER_BINS * p * (p - 1) / 2];
+            unsigned int column = next_column[p];
+
+            for (std::size_t i = start; i < period_end; i++)
+            {
+                table[column * LETTER_BINS + data[i]]++;
+                if (++column == p)
+                    column = 0;
+            }
+
+            next_column[p] = column;
+            letters_sampled[p] += period_end - start;
+            sampling = true;
+        }
+
+        // Every period in the group has a full sample
+        if (!sampling)
+            break;
+    }
+}
+
+
+// === Mutators ===================================================================================
+
+/**
+ * @fn KeyLengthSearch::set_max_period
+ *
+ * @param max: Longest key length to be considered.
+ *
+ * @brief Sets the longest key length searched. Count tables are sized on the next reset.
+ *
+ */
+void KeyLengthSearch::set_max_period (unsigned int max)
+{
+    max_period = (max == 0) ? 1 : max;
+    if (active_period > max_period)
+        active_period = max_period;
+    candidates.clear();
+}
+
+/**
+ * @fn KeyLengthSearch::set_expected_IC
+ *
+ * @param IC: IC of the plaintext language; ENGLISH_IC unless another language is modelled.
+ *
+ * @brief Sets the IC that periods are scored against. Values no higher than RANDOM_IC would
+ *        make every period look alike, so they are ignored.
+ *
+ */
+void KeyLengthSearch::set_expected_IC (double IC)
+{
+    if (IC > RANDOM_IC)
+        expected_IC = IC;
+}
+
+// === Accessors ==================================================================================
+
+/**
+ * @fn KeyLengthSearch::get_average_IC
+ *
+ * @param period: The key length being asked about.
+ * @return The average IC of the columns for that period, or 0.0 if it was not ranked.
+ *
+ */
+double KeyLengthSearch::get_average_IC (unsigned int period) const
+{
+    if ((period == 0) || (period > active_period))
+        return 0.0;
+
+    return average_IC[period];
+}
+
+/**
+ * @fn KeyLengthSearch::get_period_margin
+ *
+ * @return How far the best period's score is ahead of the best period that is not one of its
+ *         multiples, as a fraction of the best score; 0.0 if nothing has been ranked.
+ *
+ * @brief Multiples of the key length score about as well as the key length itself, so they do
+ *        not count as rivals. A margin near 1 means no other period comes close.
+ *
+ */
+double KeyLengthSearch::get_period_margin () const
+{
+    if (candidates.empty() || (candidates[0].score <= 0.0))
+        return 0.0;
+
+    double best = candidates[0].score, runner_up = 0.0;
+    for (const KeyLengthCandidate& candidate : candidates)
+    {
+        if (candidate.period % candidates[0].period != 0)
+            runner_up = std::max (runner_up, candidate.score);
+    }
+    return (best - runner_up) / best;
+}
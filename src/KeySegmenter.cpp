@@ -0,0 +1,277 @@
+/**
+ * @file KeySegmenter.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the KeySegmenter class.
+ *
+ * @see KeySegmenter.hpp
+ *
+ */
+
+
+#include "KeySegmenter.hpp"
+
+#include "Alphabet.hpp"
+#include "decrypt.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Bit that turns an upper case ASCII letter into its lower case form
+const unsigned char CASE_BIT = 0x20;
+
+/**
+ * @fn letter_of
+ *
+ * @param byte: Byte of the capture.
+ * @return Its letter index 0-25, folding case, or LETTER_BINS for anything else.
+ *
+ */
+static inline unsigned int letter_of (unsigned char byte)
+{
+    unsigned int letter = (unsigned int)(byte | CASE_BIT) - 'a';
+    return (letter < LETTER_BINS) ? letter : LETTER_BINS;
+}
+
+// === Ctors ======================================================================================
+
+KeySegmenter::KeySegmenter ()
+{
+    index = nullptr;
+    column_letters = SEGMENT_COLUMN_LETTERS;
+    window_size = 0;
+
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+        log_frequencies[e] = std::log (ALPHABET_FREQUENCIES[e]);
+}
+
+
+// === Processing Functions =======================================================================
+
+/**
+ * @fn KeySegmenter::find_segments
+ *
+ * @param text_index: Index of the capture, built with the period of its keys; 1 for Caesar.
+ *
+ * @brief Splits a capture into stretches under one key each. The capture is cut into windows of
+ *        about SEGMENT_COLUMN_LETTERS letters per column, whose shifts each cost one query of the
+ *        index. Runs of at least SEGMENT_MIN_WINDOWS windows with the same shifts are segments;
+ *        shorter runs are where the key changes or a window misread. Each change is then placed
+ *        to the letter by scanning the windows around it for the split that best explains the
+ *        letters on both sides, and every segment is cracked again from all of its own letters.
+ *
+ * @post get_segments lists the segments in order, covering the whole capture.
+ *
+ */
+void KeySegmenter::find_segments (const PrefixHistogramIndex& text_index)
+{
+    index = &text_index;
+    segments.clear();
+    segment_shifts.clear();
+    window_shifts.clear();
+
+    std::size_t size = index->get_text_size();
+    std::size_t stride = index->get_stride();
+    unsigned int period = index->get_period();
+    std::uint64_t letters = index->get_letter_count();
+    counts.resize ((std::size_t)period * LETTER_BINS);
+    if (size == 0)
+        return;
+
+    double bytes_per_letter = (letters > 0) ? (double)size / (double)letters : 1.0;
+    double wanted = (double)column_letters * period * bytes_per_letter;
+    window_size = std::max <std::size_t> (1, (std::size_t)std::ceil (wanted / (double)stride)) *
+                  stride;
+    std::size_t windows = (size + window_size - 1) / window_size;
+
+    window_shifts.resize (windows * period);
+    for (std::size_t w = 0; w < windows; w++)
+        read_shifts (w * window_size, std::min (size, (w + 1) * window_size),
+                     &window_shifts[w * period]);
+
+    // Group the windows into runs of equal shifts, keeping only the runs long enough to trust
+    std::vector <Run> runs;
+    for (std::size_t w = 0; w < windows; )
+    {
+        std::size_t last = w;
+        while ((last + 1 < windows) && (std::memcmp (&window_shifts[(last + 1) * period],
+                                                     &window_shifts[w * period], period) == 0))
+            last++;
+
+        if (last - w + 1 >= SEGMENT_MIN_WINDOWS)
+        {
+            if (!runs.empty() && (std::memcmp (&window_shifts[runs.back().offset],
+                                               &window_shifts[w * period], period) == 0))
+                runs.back().last = last;
+            else
+                runs.push_back ({ w, last, w * period });
+        }
+        w = last + 1;
+    }
+
+    std::vector <std::size_t> changes;
+    for (std::size_t r = 1; r < runs.size(); r++)
+    {
+        std::size_t begin = runs[r - 1].last * window_size;
+        std::size_t end = std::min (size, (runs[r].first + 1) * window_size);
+        changes.push_back (find_change (begin, end, &window_shifts[runs[r - 1].offset],
+                                        &window_shifts[runs[r].offset]));
+    }
+    changes.push_back (size);
+
+    // Crack every segment from all of its letters, merging neighbours that end up with one key
+    std::size_t begin = 0;
+    for (std::size_t end : changes)
+    {
+        if (end <= begin)
+            continue;
+
+        std::size_t offset = segment_shifts.size();
+        segment_shifts.resize (offset + period);
+        read_shifts (begin, end, &segment_shifts[offset]);
+
+        if (!segments.empty() && (std::memcmp (&segment_shifts[offset - period],
+                                               &segment_shifts[offset], period) == 0))
+        {
+            segment_shifts.resize (offset);
+            segments.back().end = end;
+            read_shifts (segments.back().begin, end, &segment_shifts[offset - period]);
+        }
+        else
+            segments.push_back ({ begin, end, std::string() });
+        begin = end;
+    }
+
+    for (std::size_t s = 0; s < segments.size(); s++)
+    {
+        KeySegment& segment = segments[s];
+        unsigned int first = (unsigned int)(index->get_letter_offset (segment.begin) % period);
+        segment.key.assign (period, 'A');
+        for (unsigned int c = 0; c < period; c++)
+            segment.key[c] = (char)('A' + segment_shifts[s * period + (first + c) % period]);
+    }
+}
+
+/**
+ * @fn KeySegmenter::decrypt
+ *
+ * @param out: Receives the plaintext of the whole capture, in its layout.
+ *
+ * @brief Decrypts every segment with its own key, a chunk at a time, keeping the case of every
+ *        letter and passing everything else through. Each column of a segment's key becomes a
+ *        table of what every byte decrypts to, so a byte costs one lookup and no branch.
+ *
+ * @pre find_segments has been called.
+ *
+ */
+void KeySegmenter::decrypt (std::ostream& out) const
+{
+    const char* data = index->get_text();
+    unsigned int period = index->get_period();
+    std::vector <char> tables ((std::size_t)period * BYTE_BINS);
+    std::string plaintext;
+    unsigned int column = 0;
+
+    for (std::size_t s = 0; s < segments.size(); s++)
+    {
+        const std::uint8_t* shifts = &segment_shifts[s * period];
+        for (unsigned int c = 0; c < period; c++)
+        {
+            for (unsigned int b = 0; b < BYTE_BINS; b++)
+            {
+                unsigned int letter = letter_of ((unsigned char)b);
+                unsigned int plain = (letter + LETTER_BINS - shifts[c]) % LETTER_BINS;
+                tables[c * BYTE_BINS + b] = (letter == LETTER_BINS) ? (char)b :
+                                            (char)(('A' | (b & CASE_BIT)) + plain);
+            }
+        }
+
+        for (std::size_t offset = segments[s].begin; offset < segments[s].end;
+             offset += FILE_CHUNK_SIZE)
+        {
+            std::size_t len = std::min (FILE_CHUNK_SIZE, segments[s].end - offset);
+            plaintext.resize (len);
+            for (std::size_t i = 0; i < len; i++)
+            {
+                unsigned char byte = (unsigned char)data[offset + i];
+                plaintext[i] = tables[column * BYTE_BINS + byte];
+                column += (letter_of (byte) != LETTER_BINS);
+                column = (column == period) ? 0 : column;
+            }
+            out.write (plaintext.data(), (std::streamsize)len);
+        }
+    }
+}
+
+/**
+ * @fn KeySegmenter::read_shifts
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past its last byte.
+ * @param shifts: Receives the best shift of every column of the range, by column of the capture.
+ *
+ */
+void KeySegmenter::read_shifts (std::size_t begin, std::size_t end, std::uint8_t* shifts)
+{
+    index->get_histogram (begin, end, counts.data());
+
+    double correlations[LETTER_BINS];
+    for (unsigned int r = 0; r < index->get_period(); r++)
+    {
+        const std::uint64_t* row = &counts[r * LETTER_BINS];
+        std::uint64_t total = 0;
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+            total += row[e];
+        shifts[r] = (std::uint8_t)DecryptEngine::calc_column_correlations (row, total,
+                                                                           correlations);
+    }
+}
+
+/**
+ * @fn KeySegmenter::find_change
+ *
+ * @param begin: Offset of the first byte that may be under the new key.
+ * @param end: Offset one past the last byte that may still be under the old key.
+ * @param before: Shifts of the old key, by column of the capture.
+ * @param after: Shifts of the new key.
+ * @return Offset of the first byte under the new key.
+ *
+ * @brief Places a key change to the letter. The split that makes the letters before it most
+ *        likely as English under the old key and those after it under the new one is where the
+ *        running sum of how much likelier each letter is under the old key peaks.
+ *
+ */
+std::size_t KeySegmenter::find_change (std::size_t begin, std::size_t end,
+                                       const std::uint8_t* before,
+                                       const std::uint8_t* after) const
+{
+    const char* data = index->get_text();
+    unsigned int period = index->get_period();
+    unsigned int column = (unsigned int)(index->get_letter_offset (begin) % period);
+
+    double advantage = 0.0, best = 0.0;
+    std::size_t change = begin;
+    for (std::size_t i = begin; i < end; i++)
+    {
+        unsigned int letter = letter_of ((unsigned char)data[i]);
+        if (letter == LETTER_BINS)
+            continue;
+
+        advantage += log_frequencies[(letter + LETTER_BINS - before[column]) % LETTER_BINS] -
+                     log_frequencies[(letter + LETTER_BINS - after[column]) % LETTER_BINS];
+        if (advantage > best)
+        {
+            best = advantage;
+            change = i + 1;
+        }
+        if (++column == period)
+            column = 0;
+    }
+
+    return change;
+}
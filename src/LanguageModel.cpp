@@ -0,0 +1,215 @@
+/**
+ * @file LanguageModel.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the LanguageModel class.
+ *
+ * @see LanguageModel.hpp
+ *
+ */
+
+
+#include "LanguageModel.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+/**
+ * @fn align_offset
+ *
+ * @param offset: A byte offset into a model file.
+ * @return offset rounded up to the next multiple of MODEL_ALIGNMENT.
+ *
+ */
+static std::uint64_t align_offset (std::uint64_t offset)
+{
+    return (offset + MODEL_ALIGNMENT - 1) / MODEL_ALIGNMENT * MODEL_ALIGNMENT;
+}
+
+/**
+ * @fn table_fits
+ *
+ * @param offset: Offset of a table in a model file.
+ * @param bytes: Size of the table.
+ * @param file_size: Size of the whole file.
+ * @return true if the table is aligned, clear of the header and inside the file.
+ *
+ */
+static bool table_fits (std::uint64_t offset, std::uint64_t bytes, std::uint64_t file_size)
+{
+    return (offset % MODEL_ALIGNMENT == 0) && (offset >= sizeof (ModelHeader)) &&
+           (offset <= file_size) && (bytes <= file_size - offset);
+}
+
+
+// === Ctors ======================================================================================
+
+LanguageModel::LanguageModel ()
+{
+    header = nullptr;
+    frequencies = nullptr;
+    reference = nullptr;
+}
+
+
+// === File Functions =============================================================================
+
+/**
+ * @fn LanguageModel::open
+ *
+ * @param path: Path of a model file written by LanguageModel::build.
+ * @return true if the file was mapped and its header is valid, false otherwise.
+ *
+ * @brief Maps a model file and points the accessors at its tables. Nothing is parsed or copied;
+ *        only the header is read and checked, so opening takes the same few microseconds
+ *        whatever the size of the tables. The tables are paged in as they are first used.
+ *
+ * @post On failure the model is closed.
+ *
+ */
+bool LanguageModel::open (const std::string& path)
+{
+    close();
+    if (!file.open (path, false) || (file.get_size() < sizeof (ModelHeader)))
+    {
+        close();
+        return false;
+    }
+
+    const ModelHeader* candidate = (const ModelHeader*)file.get_data();
+    std::uint64_t size = file.get_size();
+
+    bool valid = (std::memcmp (candidate->magic, MODEL_MAGIC, sizeof (MODEL_MAGIC)) == 0) &&
+                 (candidate->version == MODEL_FORMAT_VERSION) &&
+                 (candidate->byte_order == MODEL_BYTE_ORDER_MARK) &&
+                 (candidate->header_size == sizeof (ModelHeader)) &&
+                 (candidate->file_size == size) &&
+                 (candidate->name[MODEL_NAME_LENGTH - 1] == '\0') &&
+                 (candidate->expected_IC > 1.0 / LETTER_BINS) && (candidate->expected_IC <= 1.0);
+
+    valid = valid &&
+            table_fits (candidate->frequencies_offset, LETTER_BINS * sizeof (double), size) &&
+            table_fits (candidate->reference_offset, sizeof (RotatedReference), size) &&
+            table_fits (candidate->bigrams_offset, BIGRAM_BINS * sizeof (float), size) &&
+            table_fits (candidate->trigrams_offset, TRIGRAM_BINS * sizeof (float), size) &&
+            table_fits (candidate->quadgrams_offset, QUADGRAM_BINS * sizeof (float), size);
+
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    const char* base = file.get_data();
+    header = candidate;
+    frequencies = (const double*)(base + header->frequencies_offset);
+    reference = (const RotatedReference*)(base + header->reference_offset);
+    scorer.set_tables ((const float*)(base + header->bigrams_offset),
+                       (const float*)(base + header->trigrams_offset),
+                       (const float*)(base + header->quadgrams_offset));
+
+    return true;
+}
+
+/**
+ * @fn LanguageModel::close
+ *
+ * @brief Unmaps the current model, if there is one.
+ *
+ */
+void LanguageModel::close ()
+{
+    scorer.set_tables (nullptr, nullptr, nullptr);
+    header = nullptr;
+    frequencies = nullptr;
+    reference = nullptr;
+    file.close();
+}
+
+/**
+ * @fn LanguageModel::build
+ *
+ * @param path: Path the model file is written to.
+ * @param name: Name of the language, e.g. "english"; at most MODEL_NAME_LENGTH - 1 bytes.
+ * @param text: Sample text in the language; case is ignored and anything other than a letter is
+ *              skipped.
+ * @param len: Number of bytes in text.
+ * @return true if the file was written, false if the name is too long, the text holds too few
+ *         letters to model, or the file could not be written.
+ *
+ * @brief Builds a model file from a sample text: letter frequencies and the expected IC come
+ *        from the letter counts, the rotated reference from the frequencies, and the n-gram
+ *        tables from NgramScorer::train. Meant for offline use; see build_model.cpp.
+ *
+ */
+bool LanguageModel::build (const std::string& path, const std::string& name, const char* text,
+                           std::size_t len)
+{
+    if (name.empty() || (name.size() >= MODEL_NAME_LENGTH))
+        return false;
+
+    Histogram histogram;
+    for (std::size_t i = 0; i < len; i++)
+    {
+        char c = text[i];
+        if ((c >= 'a') && (c <= 'z'))
+            c = c - 'a' + 'A';
+        histogram.add (c);
+    }
+
+    double letters = (double)histogram.get_letter_total();
+    if (letters < 2.0)
+        return false;
+
+    ModelHeader header;
+    std::memset (&header, 0, sizeof (header));
+    std::memcpy (header.magic, MODEL_MAGIC, sizeof (MODEL_MAGIC));
+    header.version = MODEL_FORMAT_VERSION;
+    header.byte_order = MODEL_BYTE_ORDER_MARK;
+    header.header_size = sizeof (ModelHeader);
+    std::memcpy (header.name, name.data(), name.size());
+    header.training_letters = histogram.get_letter_total();
+
+    double frequency_table[LETTER_BINS];
+    double IC_summation = 0.0;
+    for (unsigned int i = 0; i < LETTER_BINS; i++)
+    {
+        double n = (double)histogram.get_letter_count (i);
+        frequency_table[i] = n / letters;
+        IC_summation += n * (n - 1.0);
+    }
+    header.expected_IC = IC_summation / (letters * (letters - 1.0));
+
+    RotatedReference reference_table = build_rotated_reference (frequency_table);
+    NgramScorer trained;
+    trained.train (text, len);
+
+    // Lay the tables out one after another, each on an aligned offset
+    header.frequencies_offset = align_offset (sizeof (ModelHeader));
+    header.reference_offset = align_offset (header.frequencies_offset + sizeof (frequency_table));
+    header.bigrams_offset = align_offset (header.reference_offset + sizeof (reference_table));
+    header.trigrams_offset = align_offset (header.bigrams_offset + BIGRAM_BINS * sizeof (float));
+    header.quadgrams_offset = align_offset (header.trigrams_offset +
+                                            TRIGRAM_BINS * sizeof (float));
+    header.file_size = align_offset (header.quadgrams_offset + QUADGRAM_BINS * sizeof (float));
+
+    std::vector <char> image (header.file_size, 0);
+    std::memcpy (&image[0], &header, sizeof (header));
+    std::memcpy (&image[header.frequencies_offset], frequency_table, sizeof (frequency_table));
+    std::memcpy (&image[header.reference_offset], &reference_table, sizeof (reference_table));
+    std::memcpy (&image[header.bigrams_offset], trained.get_bigrams(),
+                 BIGRAM_BINS * sizeof (float));
+    std::memcpy (&image[header.trigrams_offset], trained.get_trigrams(),
+                 TRIGRAM_BINS * sizeof (float));
+    std::memcpy (&image[header.quadgrams_offset], trained.get_quadgrams(),
+                 QUADGRAM_BINS * sizeof (float));
+
+    std::ofstream output (path, std::ios::binary | std::ios::trunc);
+    output.write (image.data(), (std::streamsize)image.size());
+    output.close();
+
+    return !output.fail();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file LetterBuffer.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the LetterBuffer class.
+ *
+ * @see LetterBuffer.hpp
+ *
+ */
+
+
+#include "LetterBuffer.hpp"
+
+#include "Histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// Bits of a letter code: the letter index, the lower case flag and the mark for non-letters
+const std::uint8_t LETTER_INDEX_BITS = 0x1F;
+const unsigned int LOWER_CASE_SHIFT = 5;
+const std::uint8_t NOT_A_LETTER = 0x80;
+
+// Bits of lower_case per word
+const unsigned int CASE_WORD_BITS = 64;
+
+/**
+ * @fn build_letter_codes
+ *
+ * @return The code of every byte value: 'A'-'Z' map to 0-25, 'a'-'z' to 0-25 with the lower
+ *         case flag set, and everything else to NOT_A_LETTER.
+ *
+ */
+static constexpr std::array <std::uint8_t, BYTE_BINS> build_letter_codes ()
+{
+    std::array <std::uint8_t, BYTE_BINS> codes = {};
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+        codes[b] = NOT_A_LETTER;
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+    {
+        codes['A' + e] = (std::uint8_t)e;
+        codes['a' + e] = (std::uint8_t)(e | (1u << LOWER_CASE_SHIFT));
+    }
+    return codes;
+}
+
+// Lookup table driving normalize, built at compile time
+static constexpr std::array <std::uint8_t, BYTE_BINS> LETTER_CODES = build_letter_codes();
+
+
+// === Ctors ======================================================================================
+
+LetterBuffer::LetterBuffer ()
+{
+    letter_count = 0;
+    text_size = 0;
+    gap_count = 0;
+}
+
+
+// === Normalization Functions ====================================================================
+
+/**
+ * @fn LetterBuffer::normalize
+ *
+ * @param buf: Text to be normalized.
+ * @param len: Number of bytes in buf.
+ *
+ * @brief Replaces the contents of the buffer with the letters of a text, in one table-driven
+ *        pass with no branches on the data. Every byte is looked up once; its letter index and
+ *        its position and value as a non-letter are both stored, and only the one that applies
+ *        advances its output. Case bits are gathered in a register and stored once per
+ *        CASE_WORD_BITS bytes. The position map is grown before each block of CASE_WORD_BITS
+ *        bytes that could overflow it, so it takes space for the gaps alone. Storage is kept
+ *        between texts, so normalizing a text no longer and with no more gaps than one before
+ *        it does not allocate.
+ *
+ * @post get_letters holds the letters of buf; restore can rebuild buf from them.
+ *
+ */
+void LetterBuffer::normalize (const char* buf, std::size_t len)
+{
+    clear();
+    text_size = len;
+    if (letters.size() < len)
+        letters.resize (len);
+    std::size_t words = len / CASE_WORD_BITS + 1;
+    if (lower_case.size() < words)
+        lower_case.resize (words);
+
+    const unsigned char* data = (const unsigned char*) buf;
+    std::uint8_t* out = letters.data();
+    std::size_t n = 0, g = 0;
+
+    for (std::size_t start = 0; start < len; start += CASE_WORD_BITS)
+    {
+        std::size_t end = std::min (len, start + CASE_WORD_BITS);
+
+        // Every byte of the block may be a gap; growth doubles, so it is rare
+        if (gap_positions.size() < g + (end - start))
+        {
+            std::size_t size = std::max (g + (end - start), 2 * gap_positions.size());
+            gap_positions.resize (size);
+            gap_bytes.resize (size);
+        }
+        std::size_t* positions = gap_positions.data();
+        char* bytes = &gap_bytes[0];
+
+        std::uint64_t lower = 0;
+        for (std::size_t i = start; i < end; i++)
+        {
+            std::uint8_t code = LETTER_CODES[data[i]];
+            std::size_t gap = code >> 7;
+            out[n] = code & LETTER_INDEX_BITS;
+            positions[g] = i;
+            bytes[g] = (char)data[i];
+            n += 1 - gap;
+            g += gap;
+            lower |= (std::uint64_t)((code >> LOWER_CASE_SHIFT) & 1) << (i - start);
+        }
+        lower_case[start / CASE_WORD_BITS] = lower;
+    }
+
+    letter_count = n;
+    gap_count = g;
+}
+
+/**
+ * @fn LetterBuffer::clear
+ *
+ * @brief Empties the buffer and the position map, keeping their storage.
+ *
+ */
+void LetterBuffer::clear ()
+{
+    letter_count = 0;
+    text_size = 0;
+    gap_count = 0;
+}
+
+
+// === Reconstruction Functions ===================================================================
+
+/**
+ * @fn LetterBuffer::write_letters
+ *
+ * @param out: Receives get_letter_count bytes.
+ *
+ * @brief Writes the letters back out as the upper case letters A-Z, e.g. for the decrypt
+ *        kernels.
+ *
+ */
+void LetterBuffer::write_letters (char* out) const
+{
+    const std::uint8_t* in = letters.data();
+    for (std::size_t i = 0; i < letter_count; i++)
+        out[i] = (char)('A' + in[i]);
+}
+
+/**
+ * @fn LetterBuffer::restore
+ *
+ * @param plain: get_letter_count upper case letters A-Z, e.g. the decryption of write_letters.
+ * @param out: Receives get_text_size bytes.
+ *
+ * @brief Rebuilds a text in the layout of the one normalized: plain supplies the letters, in
+ *        the case each original letter had, and every other byte is put back where it was.
+ *
+ */
+void LetterBuffer::restore (const char* plain, char* out) const
+{
+    std::size_t position = 0;
+    auto copy_letters = [&] (std::size_t end) {
+        for (; position < end; position++)
+        {
+            std::uint64_t word = lower_case[position / CASE_WORD_BITS];
+            unsigned int lower = (unsigned int)(word >> (position % CASE_WORD_BITS)) & 1;
+            out[position] = (char)(*plain++ | (lower << LOWER_CASE_SHIFT));
+        }
+    };
+
+    for (std::size_t g = 0; g < gap_count; g++)
+    {
+        copy_letters (gap_positions[g]);
+        out[position++] = gap_bytes[g];
+    }
+    copy_letters (text_size);
+}
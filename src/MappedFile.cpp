@@ -0,0 +1,133 @@
+/**
+ * @file MappedFile.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the MappedFile class.
+ *
+ * @see MappedFile.hpp
+ *
+ */
+
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// === Ctors ======================================================================================
+
+MappedFile::MappedFile ()
+{
+    file_descriptor = -1;
+    data = nullptr;
+    size = 0;
+}
+
+MappedFile::~MappedFile ()
+{
+    close();
+}
+
+
+// === File Functions =============================================================================
+
+/**
+ * @fn MappedFile::open
+ *
+ * @param path: Path of the file to be mapped.
+ * @param sequential: Whether the file will be read front to back; tables that are looked up at
+ *                    random should pass false.
+ * @return true if the file could be opened and mapped, false otherwise.
+ *
+ * @brief Maps a file read-only into memory. For sequential reads the kernel is told so it can
+ *        read ahead and drop pages that have already been consumed; otherwise it is told not to
+ *        read ahead, so only the pages actually used are ever loaded.
+ *
+ * @post Any previously mapped file is closed; get_data() and get_size() describe the new file.
+ *
+ */
+bool MappedFile::open (const std::string& path, bool sequential)
+{
+    close();
+
+    file_descriptor = ::open (path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+        return false;
+
+    struct stat file_info;
+    if (fstat (file_descriptor, &file_info) != 0)
+    {
+        close();
+        return false;
+    }
+
+    size = (std::size_t)file_info.st_size;
+
+    // Empty files cannot be mapped, but are still valid (empty) input
+    if (size == 0)
+        return true;
+
+    void* mapping = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        size = 0;
+        close();
+        return false;
+    }
+
+    madvise (mapping, size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    data = (const char*)mapping;
+
+    return true;
+}
+
+/**
+ * @fn MappedFile::close
+ *
+ * @brief Unmaps and closes the current file, if there is one.
+ *
+ */
+void MappedFile::close ()
+{
+    if (data != nullptr)
+        munmap ((void*)data, size);
+
+    if (file_descriptor >= 0)
+        ::close (file_descriptor);
+
+    file_descriptor = -1;
+    data = nullptr;
+    size = 0;
+}
+
+/**
+ * @fn MappedFile::release
+ *
+ * @param offset: Offset of the first byte that is no longer needed.
+ * @param len: Number of bytes that are no longer needed.
+ *
+ * @brief Tells the kernel that a consumed range can be dropped from memory, which keeps the
+ *        resident size of the mapping flat while a large file is being walked.
+ *
+ * @pre The range lies within the mapping. The pages will be re-read from disk if touched again.
+ *
+ */
+void MappedFile::release (std::size_t offset, std::size_t len)
+{
+    if ((data == nullptr) || (len == 0))
+        return;
+
+    // madvise works on whole pages, so only drop the pages that lie completely inside the range
+    std::size_t page_size = (std::size_t)sysconf (_SC_PAGESIZE);
+    std::size_t first_page = ((offset + page_size - 1) / page_size) * page_size;
+    std::size_t end_page = ((offset + len) / page_size) * page_size;
+    if ((offset + len) == size)
+        end_page = ((size + page_size - 1) / page_size) * page_size;
+
+    if (end_page > first_page)
+        madvise ((void*)(data + first_page), end_page - first_page, MADV_DONTNEED);
+}
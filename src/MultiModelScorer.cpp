@@ -0,0 +1,173 @@
+/**
+ * @file MultiModelScorer.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the MultiModelScorer class.
+ *
+ * @see MultiModelScorer.hpp
+ *
+ */
+
+
+#include "MultiModelScorer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// === Model Functions ============================================================================
+
+/**
+ * @fn MultiModelScorer::add_model
+ *
+ * @param name: Name of the language.
+ * @param frequencies: Shares of the letters A-Z in the language.
+ *
+ * @brief Adds a language to the set scored. Its log probabilities are rotated once here so
+ *        scoring is a single pass over the blocked matrix.
+ *
+ */
+void MultiModelScorer::add_model (const std::string& name, const double* frequencies)
+{
+    std::size_t m = names.size();
+    names.push_back (name);
+
+    // Start a new block of zeroed rows when the last one is full
+    std::size_t block_size = LETTER_BINS * MODEL_BLOCK * SHIFT_LANES;
+    if (m % MODEL_BLOCK == 0)
+        weights.resize (weights.size() + block_size, 0.0);
+
+    double log_probabilities[LETTER_BINS];
+    for (unsigned int c = 0; c < LETTER_BINS; c++)
+        log_probabilities[c] = std::log10 (std::max (frequencies[c], MODEL_PROBABILITY_FLOOR));
+
+    double* block = &weights[(m / MODEL_BLOCK) * block_size];
+    unsigned int k = m % MODEL_BLOCK;
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+    {
+        double* row = block + (e * MODEL_BLOCK + k) * SHIFT_LANES;
+        for (unsigned int i = 0; i < LETTER_BINS; i++)
+            row[i] = log_probabilities[(LETTER_BINS + e - i) % LETTER_BINS];
+    }
+}
+
+/**
+ * @fn MultiModelScorer::add_library
+ *
+ * @param library: Loaded language models.
+ *
+ * @brief Adds every model of a library, in library order, so a result's model index is also
+ *        its index in the library.
+ *
+ */
+void MultiModelScorer::add_library (const ModelLibrary& library)
+{
+    for (std::size_t m = 0; m < library.get_count(); m++)
+        add_model (library.get_model (m).get_name(), library.get_model (m).get_frequencies());
+}
+
+/**
+ * @fn MultiModelScorer::clear
+ *
+ * @brief Removes every model.
+ *
+ */
+void MultiModelScorer::clear ()
+{
+    weights.clear();
+    names.clear();
+}
+
+
+// === Scoring Functions ==========================================================================
+
+/**
+ * @fn MultiModelScorer::score
+ *
+ * @param letter_counts: Counts of the letters A-Z in the ciphertext.
+ * @param scores: Receives get_model_count() * SHIFT_LANES values; scores[m * SHIFT_LANES + i]
+ *                is the log10 likelihood of the ciphertext decrypted with shift i under model
+ *                m. Padding shifts score 0.
+ *
+ * @brief Scores every shift against every model as one product of the histogram with the
+ *        blocked matrix. Each block of models is finished before the next starts, so its
+ *        running sums stay in cache and every count is loaded once per block. The work depends
+ *        only on the number of models, not on the length of the text.
+ *
+ */
+void MultiModelScorer::score (const std::uint64_t* letter_counts, double* scores) const
+{
+    const unsigned int width = MODEL_BLOCK * SHIFT_LANES;
+    std::size_t blocks = (names.size() + MODEL_BLOCK - 1) / MODEL_BLOCK;
+
+    for (std::size_t b = 0; b < blocks; b++)
+    {
+        alignas (64) double sums[MODEL_BLOCK * SHIFT_LANES] = {};
+        const double* block = &weights[b * LETTER_BINS * width];
+
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+        {
+            double count = (double)letter_counts[e];
+            if (count == 0.0)
+                continue;
+
+            const double* row = block + e * width;
+            for (unsigned int j = 0; j < width; j++)
+                sums[j] += count * row[j];
+        }
+
+        std::size_t models = std::min <std::size_t> (MODEL_BLOCK, names.size() - b * MODEL_BLOCK);
+        std::copy (sums, sums + models * SHIFT_LANES, scores + b * width);
+    }
+}
+
+/**
+ * @fn MultiModelScorer::rank
+ *
+ * @param letter_counts: Counts of the letters A-Z in the ciphertext.
+ * @param results: Receives the best shift of every model, most likely language first.
+ * @param scores: Scratch space for the score matrix; kept between calls so ranking many texts
+ *                does not allocate.
+ *
+ * @brief Finds the most likely (language, key) pairs of a Caesar ciphertext from its histogram.
+ *
+ */
+void MultiModelScorer::rank (const std::uint64_t* letter_counts,
+                             std::vector <LanguageScore>& results,
+                             std::vector <double>& scores) const
+{
+    scores.resize (names.size() * SHIFT_LANES);
+    score (letter_counts, scores.data());
+
+    std::uint64_t letters = 0;
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+        letters += letter_counts[e];
+    double scale = (letters > 0) ? 1.0 / (double)letters : 0.0;
+
+    results.resize (names.size());
+    for (std::size_t m = 0; m < names.size(); m++)
+    {
+        const double* row = &scores[m * SHIFT_LANES];
+        unsigned int best = (unsigned int)(std::max_element (row, row + LETTER_BINS) - row);
+        results[m].model = (unsigned int)m;
+        results[m].key.assign (1, (char)('A' + best));
+        results[m].score = row[best] * scale;
+    }
+
+    sort_scores (results);
+}
+
+/**
+ * @fn MultiModelScorer::sort_scores
+ *
+ * @param results: Scores to be ordered, most likely language first; ties keep model order.
+ *
+ */
+void MultiModelScorer::sort_scores (std::vector <LanguageScore>& results)
+{
+    std::sort (results.begin(), results.end(),
+               [] (const LanguageScore& a, const LanguageScore& b) {
+        return (a.score != b.score) ? (a.score > b.score) : (a.model < b.model);
+    });
+}
@@ -0,0 +1,193 @@
+/**
+ * @file NgramScorer.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the NgramScorer class.
+ *
+ * @see NgramScorer.hpp
+ *
+ */
+
+
+#include "NgramScorer.hpp"
+
+#include "TrainingText.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// === Ctors ======================================================================================
+
+NgramScorer::NgramScorer ()
+{
+    bigrams = nullptr;
+    trigrams = nullptr;
+    quadgrams = nullptr;
+}
+
+
+// === Table Functions ============================================================================
+
+/**
+ * @fn NgramScorer::train
+ *
+ * @param text: Sample text in the language being modelled; case is ignored and anything other
+ *              than a letter is skipped.
+ * @param len: Number of bytes in text.
+ *
+ * @brief Builds the bigram, trigram and quadgram tables from the n-gram counts of a sample text.
+ *        N-grams the sample never contains are given the score of their prefix plus the single
+ *        letter that follows it, less NGRAM_BACKOFF_PENALTY, so a small sample still ranks
+ *        likely unseen n-grams above unlikely ones.
+ *
+ * @post The scorer owns its tables and is_loaded is true.
+ *
+ */
+void NgramScorer::train (const char* text, std::size_t len)
+{
+    std::vector <unsigned char> codes;
+    codes.reserve (len);
+    for (std::size_t i = 0; i < len; i++)
+    {
+        char c = text[i];
+        if ((c >= 'a') && (c <= 'z'))
+            codes.push_back ((unsigned char)(c - 'a'));
+        else if ((c >= 'A') && (c <= 'Z'))
+            codes.push_back ((unsigned char)(c - 'A'));
+    }
+
+    // Count every n-gram up to the window length
+    std::vector <std::uint32_t> counts (LETTER_BINS + BIGRAM_BINS + TRIGRAM_BINS + QUADGRAM_BINS);
+    std::uint32_t* unigram_counts = counts.data();
+    std::uint32_t* bigram_counts = unigram_counts + LETTER_BINS;
+    std::uint32_t* trigram_counts = bigram_counts + BIGRAM_BINS;
+    std::uint32_t* quadgram_counts = trigram_counts + TRIGRAM_BINS;
+
+    unsigned int index = 0;
+    for (std::size_t i = 0; i < codes.size(); i++)
+    {
+        index = (index * LETTER_BINS + codes[i]) % QUADGRAM_BINS;
+        unigram_counts[codes[i]]++;
+        if (i >= 1)
+            bigram_counts[index % BIGRAM_BINS]++;
+        if (i >= 2)
+            trigram_counts[index % TRIGRAM_BINS]++;
+        if (i >= 3)
+            quadgram_counts[index]++;
+    }
+
+    // Each order falls back on the one below it; single letters get add-half smoothing
+    double n = (double)codes.size();
+    float unigrams[LETTER_BINS];
+    for (unsigned int i = 0; i < LETTER_BINS; i++)
+        unigrams[i] = (float)std::log10 ((unigram_counts[i] + 0.5) / (n + LETTER_BINS * 0.5));
+
+    tables.assign (BIGRAM_BINS + TRIGRAM_BINS + QUADGRAM_BINS, 0.0f);
+    float* bigram_table = tables.data();
+    float* trigram_table = bigram_table + BIGRAM_BINS;
+    float* quadgram_table = trigram_table + TRIGRAM_BINS;
+
+    auto build_order = [] (const std::uint32_t* order_counts, double order_total,
+                           const float* prefix_table, const float* unigram_table,
+                           unsigned int bins, float* out) {
+        for (unsigned int i = 0; i < bins; i++)
+        {
+            if (order_counts[i] > 0)
+                out[i] = (float)std::log10 ((double)order_counts[i] / order_total);
+            else
+                out[i] = prefix_table[i / LETTER_BINS] + unigram_table[i % LETTER_BINS]
+                         + NGRAM_BACKOFF_PENALTY;
+        }
+    };
+
+    build_order (bigram_counts, std::max (n - 1.0, 1.0), unigrams, unigrams, BIGRAM_BINS,
+                 bigram_table);
+    build_order (trigram_counts, std::max (n - 2.0, 1.0), bigram_table, unigrams, TRIGRAM_BINS,
+                 trigram_table);
+    build_order (quadgram_counts, std::max (n - 3.0, 1.0), trigram_table, unigrams,
+                 QUADGRAM_BINS, quadgram_table);
+
+    bigrams = bigram_table;
+    trigrams = trigram_table;
+    quadgrams = quadgram_table;
+}
+
+/**
+ * @fn NgramScorer::set_tables
+ *
+ * @param bigram_table: BIGRAM_BINS log10 probabilities.
+ * @param trigram_table: TRIGRAM_BINS log10 probabilities.
+ * @param quadgram_table: QUADGRAM_BINS log10 probabilities.
+ *
+ * @brief Points the scorer at tables held elsewhere, e.g. in a memory-mapped model file. No data
+ *        is copied, so the tables must outlive the scorer.
+ *
+ */
+void NgramScorer::set_tables (const float* bigram_table, const float* trigram_table,
+                              const float* quadgram_table)
+{
+    tables.clear();
+    bigrams = bigram_table;
+    trigrams = trigram_table;
+    quadgrams = quadgram_table;
+}
+
+
+// === Scoring Functions ==========================================================================
+
+/**
+ * @fn NgramScorer::score
+ *
+ * @param codes: Letters to be scored as codes 0-25.
+ * @param n: Number of letters in codes.
+ * @return The log10 likelihood of the letters; higher is more like the language modelled.
+ *
+ * @brief Sums the quadgram scores of every window of NGRAM_WINDOW letters. Texts shorter than a
+ *        window are scored with the longest n-gram that fits.
+ *
+ * @pre is_loaded is true.
+ *
+ */
+double NgramScorer::score (const unsigned char* codes, std::size_t n) const
+{
+    if (n == 2)
+        return bigrams[codes[0] * LETTER_BINS + codes[1]];
+    if (n == 3)
+        return trigrams[(codes[0] * LETTER_BINS + codes[1]) * LETTER_BINS + codes[2]];
+    if (n < NGRAM_WINDOW)
+        return 0.0;
+
+    double total = 0.0;
+    unsigned int index = (codes[0] * LETTER_BINS + codes[1]) * LETTER_BINS + codes[2];
+    for (std::size_t i = 3; i < n; i++)
+    {
+        index = (index * LETTER_BINS + codes[i]) % QUADGRAM_BINS;
+        total += quadgrams[index];
+    }
+    return total;
+}
+
+
+// === Accessors ==================================================================================
+
+/**
+ * @fn NgramScorer::get_english
+ *
+ * @return A scorer trained on the built-in English sample text.
+ *
+ * @brief The tables are built on first use, which takes a few milliseconds, and shared by every
+ *        engine afterwards; initialization is thread-safe.
+ *
+ */
+const NgramScorer& NgramScorer::get_english ()
+{
+    static const NgramScorer& english = [] () -> const NgramScorer& {
+        static NgramScorer scorer;
+        scorer.train (ENGLISH_TRAINING_TEXT, ENGLISH_TRAINING_TEXT_LENGTH);
+        return scorer;
+    } ();
+    return english;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file PrefixHistogramIndex.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the PrefixHistogramIndex class.
+ *
+ * @see PrefixHistogramIndex.hpp
+ *
+ */
+
+
+#include "PrefixHistogramIndex.hpp"
+
+#include "decrypt.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// Bits of a code in LETTER_OF: the letter index, and the mark for bytes that are not letters
+const std::uint8_t LETTER_INDEX_BITS = 0x1F;
+const unsigned int NOT_A_LETTER_SHIFT = 7;
+const std::uint8_t NOT_A_LETTER = 1u << NOT_A_LETTER_SHIFT;
+
+/**
+ * @fn build_letter_of
+ *
+ * @return The code of every byte value: 'A'-'Z' and 'a'-'z' map to 0-25, as LetterBuffer folds
+ *         them, and everything else to NOT_A_LETTER, whose letter index bits are 0.
+ *
+ */
+static constexpr std::array <std::uint8_t, BYTE_BINS> build_letter_of ()
+{
+    std::array <std::uint8_t, BYTE_BINS> codes = {};
+    for (unsigned int b = 0; b < BYTE_BINS; b++)
+        codes[b] = NOT_A_LETTER;
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+    {
+        codes['A' + e] = (std::uint8_t)e;
+        codes['a' + e] = (std::uint8_t)e;
+    }
+    return codes;
+}
+
+// Lookup table for building and querying, built at compile time
+static constexpr std::array <std::uint8_t, BYTE_BINS> LETTER_OF = build_letter_of();
+
+/**
+ * @fn count_span
+ *
+ * @param text: Bytes to be counted.
+ * @param len: Number of bytes in text.
+ * @param period: Number of rows in counts.
+ * @param counts: period rows of LETTER_BINS counts, each letter adding step to its cell.
+ * @param letters: Number of letters before text.
+ * @param step: 1 to add the span, or all ones to take it away again in modular arithmetic.
+ * @return Number of letters in text.
+ *
+ * @brief Counts every letter of a span into the row of its position among the letters, picking
+ *        up from the letters counted so far. Letters and other bytes mix unpredictably in text,
+ *        so the loop has no branch on them: another byte adds 0 to the first cell of its row and
+ *        does not move on to the next row.
+ *
+ */
+template <class Count>
+static std::uint64_t count_span (const char* text, std::size_t len, unsigned int period,
+                                 Count* counts, std::uint64_t letters, Count step)
+{
+    unsigned int row = (unsigned int)(letters % period);
+    std::uint64_t found = 0;
+
+    for (std::size_t i = 0; i < len; i++)
+    {
+        std::uint8_t code = LETTER_OF[(unsigned char)text[i]];
+        unsigned int is_letter = 1 - (code >> NOT_A_LETTER_SHIFT);
+
+        counts[row * LETTER_BINS + (code & LETTER_INDEX_BITS)] += (Count)(step * is_letter);
+        found += is_letter;
+        row += is_letter;
+        row = (row == period) ? 0 : row;
+    }
+
+    return found;
+}
+
+
+// === Ctors ======================================================================================
+
+PrefixHistogramIndex::PrefixHistogramIndex ()
+{
+    data = nullptr;
+    size = 0;
+    period = 1;
+    stride = PREFIX_INDEX_MIN_STRIDE;
+    strides_per_block = 1;
+    record_size = 1 + LETTER_BINS;
+}
+
+
+// === Building Functions =========================================================================
+
+/**
+ * @fn PrefixHistogramIndex::build
+ *
+ * @param text: Text to be indexed, e.g. a mapped file; only read, and kept for queries.
+ * @param len: Number of bytes in text.
+ * @param columns: Period the letters are split at; 1 for a single histogram, and at most
+ *                 PREFIX_INDEX_MAX_PERIOD.
+ * @return false, leaving the index empty, if columns is above PREFIX_INDEX_MAX_PERIOD.
+ *
+ * @brief Indexes a text in one pass. The running counts are saved once per stride rather than at
+ *        every byte, which would take 26 counts per column per byte; a query adds back the at
+ *        most one stride of text between a checkpoint and the position it asks about. The
+ *        checkpoints hold 16-bit counts from the start of their block, a quarter of the size of
+ *        full counts, which lets the stride, and so the cost of a query, be as much smaller.
+ *        For periods whose blocks would hold a single stride, the checkpoints are left out and
+ *        the stride is sized for the full counts of a block instead.
+ *
+ * @post Every query answers for byte ranges of text until the next build or clear.
+ *
+ */
+bool PrefixHistogramIndex::build (const char* text, std::size_t len, unsigned int columns)
+{
+    if (columns > PREFIX_INDEX_MAX_PERIOD)
+    {
+        clear();
+        return false;
+    }
+
+    data = text;
+    size = len;
+    period = std::max (columns, 1u);
+    record_size = 1 + (std::size_t)period * LETTER_BINS;
+
+    stride = std::max (PREFIX_INDEX_MIN_STRIDE,
+                       record_size * sizeof (std::uint16_t) * PREFIX_INDEX_SIZE_RATIO);
+    strides_per_block = PREFIX_INDEX_MAX_BLOCK / stride;
+    if (strides_per_block < 2)
+    {
+        stride = record_size * sizeof (std::uint64_t) * PREFIX_INDEX_SIZE_RATIO;
+        strides_per_block = 1;
+    }
+
+    std::size_t strides = size / stride + 1;
+    std::size_t block_count = (strides + strides_per_block - 1) / strides_per_block;
+    checkpoints.assign ((strides_per_block > 1) ? strides * record_size : 0, 0);
+    blocks.assign (block_count * record_size, 0);
+
+    // Counts since the start of the current block, copied into every checkpoint within it
+    std::vector <std::uint64_t> running (record_size, 0);
+    std::uint64_t letters = 0;
+    for (std::size_t j = 1; j < strides; j++)
+    {
+        std::uint64_t found = count_span <std::uint64_t> (data + (j - 1) * stride, stride, period,
+                                                          &running[1], letters, 1);
+        letters += found;
+        running[0] += found;
+
+        if (j % strides_per_block != 0)
+        {
+            std::uint16_t* checkpoint = &checkpoints[j * record_size];
+            for (std::size_t i = 0; i < record_size; i++)
+                checkpoint[i] = (std::uint16_t)running[i];
+            continue;
+        }
+
+        std::uint64_t* block = &blocks[(j / strides_per_block) * record_size];
+        for (std::size_t i = 0; i < record_size; i++)
+            block[i] = block[i - record_size] + running[i];
+        std::fill (running.begin(), running.end(), 0);
+    }
+    return true;
+}
+
+/**
+ * @fn PrefixHistogramIndex::clear
+ *
+ * @brief Drops the index and forgets the text; the checkpoint storage is kept for the next build.
+ *
+ */
+void PrefixHistogramIndex::clear ()
+{
+    data = nullptr;
+    size = 0;
+    blocks.clear();
+    checkpoints.clear();
+}
+
+
+// === Query Functions ============================================================================
+
+/**
+ * @fn PrefixHistogramIndex::add_counts_at
+ *
+ * @param pos: Byte offset in the text, at most its size.
+ * @param counts: period rows of LETTER_BINS counts, to which the counts of the letters before pos
+ *                are added step times.
+ * @param step: 1 to add the counts, or all ones to take them away.
+ *
+ */
+void PrefixHistogramIndex::add_counts_at (std::size_t pos, std::uint64_t* counts,
+                                          std::uint64_t step) const
+{
+    std::size_t j = pos / stride;
+    const std::uint64_t* block = &blocks[(j / strides_per_block) * record_size];
+    std::uint64_t letters = block[0];
+    for (std::size_t i = 1; i < record_size; i++)
+        counts[i - 1] += step * block[i];
+
+    if (strides_per_block > 1)
+    {
+        const std::uint16_t* checkpoint = &checkpoints[j * record_size];
+        letters += checkpoint[0];
+        for (std::size_t i = 1; i < record_size; i++)
+            counts[i - 1] += step * checkpoint[i];
+    }
+    count_span <std::uint64_t> (data + j * stride, pos - j * stride, period, counts, letters,
+                                step);
+}
+
+/**
+ * @fn PrefixHistogramIndex::get_histogram
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past its last byte.
+ * @param counts: Receives period rows of LETTER_BINS counts; row r counts the letters of the range
+ *                whose position among the letters of the whole text is r modulo the period.
+ *
+ * @brief Letter counts of any range, by column, at the cost of two checkpoints and at most two
+ *        strides of counting, however long the range. The counts before begin are taken away
+ *        in place, so a query needs no memory of its own.
+ *
+ * @pre build has been called, and begin <= end <= the size of the text.
+ *
+ */
+void PrefixHistogramIndex::get_histogram (std::size_t begin, std::size_t end,
+                                          std::uint64_t* counts) const
+{
+    std::fill (counts, counts + (record_size - 1), 0);
+    add_counts_at (end, counts, 1);
+    add_counts_at (begin, counts, ~std::uint64_t (0));
+}
+
+/**
+ * @fn PrefixHistogramIndex::get_letter_offset
+ *
+ * @param pos: Byte offset in the text.
+ * @return Number of letters before pos.
+ *
+ */
+std::uint64_t PrefixHistogramIndex::get_letter_offset (std::size_t pos) const
+{
+    if (blocks.empty())
+        return 0;
+
+    pos = std::min (pos, size);
+    std::size_t j = pos / stride;
+    std::uint64_t letters = blocks[(j / strides_per_block) * record_size];
+    if (strides_per_block > 1)
+        letters += checkpoints[j * record_size];
+    for (std::size_t i = j * stride; i < pos; i++)
+        letters += 1 - (LETTER_OF[(unsigned char)data[i]] >> NOT_A_LETTER_SHIFT);
+    return letters;
+}
+
+/**
+ * @fn PrefixHistogramIndex::get_IC
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past its last byte.
+ * @return The mean IC of the columns of the range; with a period of 1, the IC of its letters.
+ *
+ * @pre build has been called, and begin <= end.
+ *
+ */
+double PrefixHistogramIndex::get_IC (std::size_t begin, std::size_t end) const
+{
+    std::vector <std::uint64_t> counts (record_size - 1);
+    get_histogram (begin, end, counts.data());
+
+    double sum = 0.0;
+    unsigned int columns = 0;
+    for (unsigned int r = 0; r < period; r++)
+    {
+        const std::uint64_t* row = &counts[r * LETTER_BINS];
+        double total = 0.0, coincidences = 0.0;
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+        {
+            total += (double)row[e];
+            coincidences += (double)row[e] * ((double)row[e] - 1.0);
+        }
+
+        if (total > 1.0)
+        {
+            sum += coincidences / (total * (total - 1.0));
+            columns++;
+        }
+    }
+
+    return (columns > 0) ? sum / columns : 0.0;
+}
+
+/**
+ * @fn PrefixHistogramIndex::get_best_shift
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past its last byte.
+ * @param column: Row of the histogram, counted from the start of the whole text.
+ * @return The shift whose decryption of the column best matches English letter frequencies.
+ *
+ * @pre build has been called, begin <= end and column < the period.
+ *
+ */
+unsigned int PrefixHistogramIndex::get_best_shift (std::size_t begin, std::size_t end,
+                                                   unsigned int column) const
+{
+    std::vector <std::uint64_t> counts (record_size - 1);
+    get_histogram (begin, end, counts.data());
+
+    const std::uint64_t* row = &counts[column * LETTER_BINS];
+    std::uint64_t total = 0;
+    for (unsigned int e = 0; e < LETTER_BINS; e++)
+        total += row[e];
+
+    double correlations[LETTER_BINS];
+    return DecryptEngine::calc_column_correlations (row, total, correlations);
+}
+
+/**
+ * @fn PrefixHistogramIndex::get_key
+ *
+ * @param begin: Offset of the first byte of the range.
+ * @param end: Offset one past its last byte.
+ * @return The Vigenere key of the range as if it had been encrypted from its first letter on, one
+ *         letter per column of the period.
+ *
+ * @brief Cracks any range of the text from its column histograms alone, as the Vigenere solver
+ *        cracks a whole text once it knows the key length.
+ *
+ * @pre build has been called, and begin <= end.
+ *
+ */
+std::string PrefixHistogramIndex::get_key (std::size_t begin, std::size_t end) const
+{
+    std::vector <std::uint64_t> counts (record_size - 1);
+    get_histogram (begin, end, counts.data());
+    unsigned int first = (unsigned int)(get_letter_offset (begin) % period);
+
+    std::string key (period, 'A');
+    double correlations[LETTER_BINS];
+    for (unsigned int c = 0; c < period; c++)
+    {
+        const std::uint64_t* row = &counts[((first + c) % period) * LETTER_BINS];
+        std::uint64_t total = 0;
+        for (unsigned int e = 0; e < LETTER_BINS; e++)
+            total += row[e];
+        key[c] = (char)('A' + DecryptEngine::calc_column_correlations (row, total, correlations));
+    }
+
+    return key;
+}
@@ -4,7 +4,8 @@
  * @author Drew Wheeler
  * @date 2023-02-11
  * 
- * @brief Contains function definitions for the StringAnalysis class.
+ * @brief Contains function definitions for the BasicStringAnalysis class template, compiled
+ *        for A-Z and every alphabet in FOR_EACH_EXTRA_ALPHABET.
  * 
  * @see StringAnalysis.hpp
  * 
@@ -15,23 +16,31 @@
 
 // === Ctors ======================================================================================
 
-StringAnalysis::StringAnalysis ()
+template <class Alphabet>
+BasicStringAnalysis <Alphabet>::BasicStringAnalysis ()
 {
     data_string = "";
     index_of_coincidence = 0.0;
+    char_frequencies.fill (0.0);
+    frequencies_generated = false;
+    symbol_counts.fill (0);
 }
 
-StringAnalysis::StringAnalysis (const std::string& str)
+template <class Alphabet>
+BasicStringAnalysis <Alphabet>::BasicStringAnalysis (const std::string& str)
 {
     data_string = str;
     index_of_coincidence = 0.0;
+    char_frequencies.fill (0.0);
+    frequencies_generated = false;
+    symbol_counts.fill (0);
 }
 
 
 // === String Manipulation Functions ==============================================================
 
 /**
- * @fn StringAnalysis::rm_data_string_char
+ * @fn BasicStringAnalysis::rm_data_string_char
  * 
  * @param rm: The character to be removed from data_string.
  * 
@@ -41,63 +50,148 @@ StringAnalysis::StringAnalysis (const std::string& str)
  * @post All instances of character specified in parameter are removed from data_string.
  * 
  */
-void StringAnalysis::rm_data_string_char (char rm)
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::rm_data_string_char (char rm)
 {
+    std::size_t old_size = data_string.size();
     data_string.erase (std::remove (data_string.begin(), data_string.end(), rm), data_string.end());
+
+    // Counts taken before the removal no longer describe data_string; rebuild them on next use
+    if (data_string.size() != old_size)
+    {
+        char_instances.clear();
+        index_of_coincidence = 0.0;
+        frequencies_generated = false;
+    }
+}
+
+/**
+ * @fn BasicStringAnalysis::append
+ *
+ * @param buf: Chunk of text to be added to data_string.
+ * @param len: Number of bytes in buf.
+ *
+ * @brief Adds a chunk to the end of data_string and updates the counts and IC in O(len) time,
+ *        so a text that arrives piece by piece never has to be rescanned.
+ *
+ * @post data_string, char_instances and index_of_coincidence include the chunk.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::append (const char* buf, std::size_t len)
+{
+    // Bring the counts up to date first in case data_string was set without being analyzed
+    if ((data_string.size() > 0) && (char_instances.get_total() == 0))
+        gen_char_instance_profile();
+
+    data_string.append (buf, len);
+    accumulate (buf, len);
+}
+
+/**
+ * @fn BasicStringAnalysis::accumulate
+ *
+ * @param buf: Chunk of text to be counted.
+ * @param len: Number of bytes in buf.
+ *
+ * @brief Adds a chunk of text to the character counts without storing it in data_string. Used
+ *        to analyze input that is too large to be held in memory as a single string.
+ *
+ * @post char_instances and index_of_coincidence include the chunk; the frequency table must be
+ *       regenerated before it is printed.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::accumulate (const char* buf, std::size_t len)
+{
+    char_instances.count (buf, len);
+    frequencies_generated = false;
+    update_IC();
+}
+
+/**
+ * @fn BasicStringAnalysis::accumulate_letters
+ *
+ * @param letters: Letter indices 0-25 from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ *
+ * @brief Counts a normalized text as the letters A-Z, so the IC and correlations describe only
+ *        its letters whatever case and punctuation the original had.
+ *
+ * @post char_instances and index_of_coincidence include the letters.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::accumulate_letters (const std::uint8_t* letters,
+                                                         std::size_t len)
+{
+    char_instances.count_letters (letters, len);
+    frequencies_generated = false;
+    update_IC();
+}
+
+/**
+ * @fn BasicStringAnalysis::reset
+ *
+ * @brief Clears the stored string and every count so the object can analyze a new text. The
+ *        capacity of data_string is kept, so reusing the object does not allocate.
+ *
+ * @post data_string is empty and all counts, frequencies and the IC are zero.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::reset ()
+{
+    data_string.clear();
+    char_instances.clear();
+    char_frequencies.fill (0.0);
+    frequencies_generated = false;
+    index_of_coincidence = 0.0;
 }
 
 
 // === Analysis Functions =========================================================================
 
 /**
- * @fn StringAnalysis::gen_char_instance_profile
+ * @fn BasicStringAnalysis::gen_char_instance_profile
  * 
- * @brief Counts the number of instances of each character in a string.
+ * @brief Counts the number of instances of each character in a string using the histogram
+ *        counting kernel.
  * 
  * @pre Member variable data_string has been initialized with a string.
  * @post Quantities of each character in data_string are counted and stored in char_instances.
  * 
  */
-void StringAnalysis::gen_char_instance_profile ()
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::gen_char_instance_profile ()
 {
-    // Store length as a temporary variable to avoid calling .size() repeatidly
-    unsigned int str_len = data_string.size();
-
-    // Get number of instances of each char in `data_string`
-    for (unsigned int i = 0; i < str_len; i++)
-    {
-        if (char_instances.size() != 0)
-        {
-            for (unsigned int j = 0; j < char_instances.size(); j++)
-            {
-                // One instance of char already exists in the string, increment its counter instead
-                if (char_instances[j].first == data_string[i])
-                {
-                    char_instances[j].second++;
-                    break;
-                }
-
-                // New character found, add it to the list
-                else if (j == char_instances.size() - 1)
-                {
-                    char_instances.push_back (std::make_pair (data_string[i], 1));
-                    break;
-                }
-            }
-        }
-
-        // Starting with an empty list, initialize first character encountered
-        else
-        {
-            char_instances.push_back (std::make_pair (data_string[i], 1));
-        }
-    }
+    char_instances.clear();
+    char_instances.count (data_string.data(), data_string.size());
+    update_IC();
+}
 
-    std::sort(char_instances.begin(), char_instances.end());
+/**
+ * @fn BasicStringAnalysis::gen_letter_instance_profile
+ *
+ * @param letters: The letters of data_string as indices 0-25, from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ *
+ * @brief Replaces the character counts with the counts of a normalized text, so the analysis
+ *        covers only the letters of data_string, each counted as upper case.
+ *
+ * @post char_instances holds the letter counts and index_of_coincidence their IC.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::gen_letter_instance_profile (const std::uint8_t* letters,
+                                                                  std::size_t len)
+{
+    char_instances.clear();
+    accumulate_letters (letters, len);
 }
 
 /**
- * @fn StringAnalysis::gen_char_frequency_profile
+ * @fn BasicStringAnalysis::gen_char_frequency_profile
  * 
  * @brief Generates a table containing the frequencies of each character in data_string. If no data
  *        exists in char_instances, it will call gen_instance_profile first.
@@ -106,120 +200,103 @@ void StringAnalysis::gen_char_instance_profile ()
  * @post Character frequencies for data_string are calculated.
  * 
  */
-void StringAnalysis::gen_char_frequency_profile ()
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::gen_char_frequency_profile ()
 {
     // If a valid string is stored, but its composition has not been analyzed, do that first
-    if ((data_string.size() > 0) && (char_instances.size() == 0))
+    if ((data_string.size() > 0) && (char_instances.get_total() == 0))
         gen_char_instance_profile();
-    
-    // Variables used as part of the frequency calculation
-    double frequency = 0.0;
-    unsigned int str_length = data_string.size();
 
     // Calculate frequencies for each character in the sub-alphabet of `data_string`
-    unsigned int instance_list_length = char_instances.size();
-    for (unsigned int i = 0; i < instance_list_length; i++)
+    char_frequencies.fill (0.0);
+    double str_length = (double)char_instances.get_total();
+    if (str_length > 0)
     {
-        frequency = (double)char_instances[i].second / (double)str_length;
-        char_frequencies.push_back (std::make_pair (char_instances[i].first, frequency));
+        for (unsigned int i = 0; i < BYTE_BINS; i++)
+            char_frequencies[i] = (double)char_instances.get_byte_count ((char)i) / str_length;
     }
+    frequencies_generated = true;
 }
 
 /**
- * @fn StringAnalysis::calculate_IC
+ * @fn BasicStringAnalysis::calculate_IC
  * 
  * @brief Calculates the Index of Coincidence for data_string.
  * 
  */
-void StringAnalysis::calculate_IC ()
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::calculate_IC ()
 {
     // Generate a frequency profile if one doesn't exist yet
-    if ((char_frequencies.size() == 0) && (data_string.size() > 0))
+    if (!frequencies_generated)
         gen_char_frequency_profile();
 
-    // Remove all spaces from temporary text as true ciphertext length is needed for algorithm
-    std::string temp_dat_str = data_string;
-    for(unsigned int i = 0; i < temp_dat_str.size();)
-    {
-        if (temp_dat_str[i] == ' ')
-        {
-            temp_dat_str.erase (std::remove (temp_dat_str.begin(), temp_dat_str.end(), ' '), temp_dat_str.end());
-        }
-        else
-            i++;
-    }
+    update_IC();
+}
 
+/**
+ * @fn BasicStringAnalysis::update_IC
+ *
+ * @brief Recomputes the IC from the running summation kept by char_instances; O(1), so it is
+ *        called after every update to the counts.
+ *
+ * @post index_of_coincidence matches char_instances.
+ *
+ */
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::update_IC ()
+{
     // Calculate the IC summation's multiplier based on input string size
-    double IC_mult = 1.0 / (((double)data_string.size()) * ((double)data_string.size() - 1.0));
-    unsigned int IC_summation = 0;
-
-    // Calculate the summation portion of the IC
-    unsigned int instance_list_length = char_instances.size();
-    for (unsigned int i = 0; i < instance_list_length; i++)
+    double str_length = (double)char_instances.get_total();
+    if (str_length < 2.0)
     {
-        IC_summation += (char_instances[i].second * (char_instances[i].second - 1));
+        index_of_coincidence = 0.0;
+        return;
     }
+    double IC_mult = 1.0 / (str_length * (str_length - 1.0));
 
-    index_of_coincidence = IC_mult * (double)(IC_summation);
+    index_of_coincidence = IC_mult * (double)char_instances.get_coincidences();
 }
 
 
 // === Output Functions ===========================================================================
 
 /**
- * @fn StringAnalysis::print_instance_profile
+ * @fn BasicStringAnalysis::print_instance_profile
  * 
  * @brief Prints the number of instances for each character in data_string.
  * 
  */
-void StringAnalysis::print_instance_profile ()
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::print_instance_profile ()
 {
-    unsigned int instance_list_length = char_instances.size();
-
-    for (unsigned int i = 0; i < instance_list_length; i++)
+    for (unsigned int i = 0; i < BYTE_BINS; i++)
     {
-        std::cout << char_instances[i].first << ": " << char_instances[i].second << '\n';
+        if (char_instances.get_byte_count ((char)i) != 0)
+            std::cout << (char)i << ": " << char_instances.get_byte_count ((char)i) << '\n';
     }
 }
 
 /**
- * @fn StringAnalysis::print_frequency_profile
+ * @fn BasicStringAnalysis::print_frequency_profile
  * 
  * @brief Prints the frequencies for each character in data_string.
  * 
  */
-void StringAnalysis::print_frequency_profile ()
+template <class Alphabet>
+void BasicStringAnalysis <Alphabet>::print_frequency_profile ()
 {
-    unsigned int frequency_list_length = char_frequencies.size();
-
-    for (unsigned int i = 0; i < frequency_list_length; i++)
+    for (unsigned int i = 0; i < BYTE_BINS; i++)
     {
-        std::cout << char_frequencies[i].first << ": " << char_frequencies[i].second << '\n';
+        if (char_instances.get_byte_count ((char)i) != 0)
+            std::cout << (char)i << ": " << char_frequencies[i] << '\n';
     }
 }
 
 
-// === Accessors ==================================================================================
+// === Instantiations =============================================================================
 
-/**
- * @fn StringAnalysis::get_char_freq
- * 
- * @brief Returns the frequency of a character within the stored data_string
- * 
- * @param c The character to be searched for within the char_frequencies array.
- * @return A double containing the frequency of the character; defaults to 0.0 if not found.
- * 
- * @pre char_frequencies should be properly initialized using gen_char_frequency_profile.
- * 
- */
-double StringAnalysis::get_char_freq (char c)
-{
-    unsigned int frequency_list_length = char_frequencies.size();
-    for (unsigned int i = 0; i < frequency_list_length; i++)
-    {
-        if (c == char_frequencies[i].first)
-            return char_frequencies[i].second;
-    }
+template class BasicStringAnalysis <UpperLatinAlphabet>;
 
-    return 0.0;
-}
+#define INSTANTIATE_STRING_ANALYSIS(Alphabet) template class BasicStringAnalysis <Alphabet>;
+FOR_EACH_EXTRA_ALPHABET (INSTANTIATE_STRING_ANALYSIS)
@@ -0,0 +1,448 @@
+/**
+ * @file SubstitutionSolver.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the SubstitutionSolver class.
+ *
+ * @see SubstitutionSolver.hpp
+ *
+ */
+
+
+#include "SubstitutionSolver.hpp"
+
+#include "StringAnalysis.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+
+// === Ctors ======================================================================================
+
+SubstitutionSolver::SubstitutionSolver ()
+{
+    scorer = &NgramScorer::get_english();
+    frequencies = ALPHABET_FREQUENCIES;
+    thread_pool = nullptr;
+    max_restarts = DEFAULT_SUBSTITUTION_RESTARTS;
+    seed = 0;
+
+    first_containing.fill (0);
+    for (unsigned int c = 0; c < LETTER_BINS; c++)
+        frequency_key[c] = best_key[c] = (std::uint8_t)c;
+    best_fitness = 0.0;
+    quadgram_total = 0;
+    restarts_run = 0;
+    agreement = 0;
+}
+
+
+// === Solving Functions ==========================================================================
+
+/**
+ * @fn SubstitutionSolver::solve
+ *
+ * @param ciphertext: Text to be cracked; only its letters take part, whatever their case.
+ *
+ * @brief Normalizes a ciphertext into its letters and solves it.
+ *
+ * @post get_plaintext holds the decryption as upper case letters alone.
+ *
+ */
+void SubstitutionSolver::solve (const std::string& ciphertext)
+{
+    letters.normalize (ciphertext);
+    solve_letters (letters.get_letters(), letters.get_letter_count());
+
+    plaintext.resize (letters.get_letter_count());
+    decrypt_letters (letters.get_letters(), letters.get_letter_count(), &plaintext[0]);
+}
+
+/**
+ * @fn SubstitutionSolver::solve_letters
+ *
+ * @param text: Ciphertext as letter indices 0-25 from LetterBuffer.
+ * @param len: Number of letters.
+ *
+ * @brief Finds the permutation key whose decryption has the highest quadgram fitness. The first
+ *        climb starts from the frequency ordering of the ciphertext, and every later one from
+ *        that key scrambled by SUBSTITUTION_RESTART_SWAPS random swaps, seeded by its restart
+ *        number. Climbs run across the thread pool when there is one, but their results are
+ *        weighed in restart order, so the key found is the one the climbs would give run one by
+ *        one. Once SUBSTITUTION_AGREEMENT climbs have ended on the best key seen, the climbs not
+ *        yet started are skipped and those after it that ended early are ignored.
+ *
+ * @post get_key returns the best key found.
+ *
+ */
+void SubstitutionSolver::solve_letters (const std::uint8_t* text, std::size_t len)
+{
+    count_quadgrams (text, len);
+    order_by_frequency (text, len);
+
+    best_key = frequency_key;
+    best_fitness = -std::numeric_limits <double>::infinity();
+    restarts_run = 0;
+    agreement = 0;
+    if (quadgrams.empty())
+    {
+        best_fitness = 0.0;
+        return;
+    }
+
+    results.assign (max_restarts, ClimbResult());
+    std::mutex best_mutex;
+    std::atomic <bool> settled (false);
+    auto run_climb = [&] (std::size_t restart) {
+        if (settled.load (std::memory_order_relaxed))
+            return;
+
+        Climb state;
+        state.key = frequency_key;
+        if (restart > 0)
+        {
+            std::mt19937_64 rng (seed + restart);
+            for (unsigned int s = 0; s < SUBSTITUTION_RESTART_SWAPS; s++)
+                std::swap (state.key[rng() % LETTER_BINS], state.key[rng() % LETTER_BINS]);
+        }
+        climb (state);
+
+        std::lock_guard <std::mutex> lock (best_mutex);
+        results[restart] = { state.key, state.fitness, true };
+
+        // Keys that decrypt the text alike score exactly alike, as the sums run in one order
+        while (!settled.load (std::memory_order_relaxed) && (restarts_run < max_restarts) &&
+               results[restarts_run].done)
+        {
+            const ClimbResult& result = results[restarts_run++];
+            if (result.fitness > best_fitness)
+            {
+                best_fitness = result.fitness;
+                best_key = result.key;
+                agreement = 1;
+            }
+            else if (result.fitness == best_fitness)
+                agreement++;
+
+            if (agreement >= SUBSTITUTION_AGREEMENT)
+                settled.store (true, std::memory_order_relaxed);
+        }
+    };
+
+    if (thread_pool != nullptr)
+        thread_pool->parallel_for (max_restarts, run_climb);
+    else
+    {
+        for (unsigned int r = 0; r < max_restarts; r++)
+            run_climb (r);
+    }
+    place_absent_letters();
+}
+
+/**
+ * @fn SubstitutionSolver::decrypt_letters
+ *
+ * @param text: Ciphertext as letter indices 0-25.
+ * @param len: Number of letters.
+ * @param out: Receives len upper case plaintext letters.
+ *
+ * @pre solve or solve_letters has been called.
+ *
+ */
+void SubstitutionSolver::decrypt_letters (const std::uint8_t* text, std::size_t len,
+                                          char* out) const
+{
+    for (std::size_t i = 0; i < len; i++)
+        out[i] = (char)('A' + best_key[text[i]]);
+}
+
+/**
+ * @fn SubstitutionSolver::count_quadgrams
+ *
+ * @param text: Ciphertext as letter indices 0-25.
+ * @param len: Number of letters.
+ *
+ * @brief Reduces the ciphertext to its distinct quadgrams and their counts, and lists the
+ *        quadgrams every letter occurs in. Short texts sort their packed quadgrams; texts with
+ *        more quadgrams than there are possible ones count them in a table instead, so the work
+ *        stays linear and the memory bounded however long the text.
+ *
+ */
+void SubstitutionSolver::count_quadgrams (const std::uint8_t* text, std::size_t len)
+{
+    quadgrams.clear();
+    containing.clear();
+    first_containing.fill (0);
+    quadgram_total = (len >= NGRAM_WINDOW) ? len - NGRAM_WINDOW + 1 : 0;
+
+    auto add_quadgram = [this] (std::uint32_t index, std::uint64_t count) {
+        Quadgram quadgram;
+        for (unsigned int k = NGRAM_WINDOW; k > 0; k--)
+        {
+            quadgram.codes[k - 1] = (std::uint8_t)(index % LETTER_BINS);
+            index /= LETTER_BINS;
+        }
+        quadgram.count = count;
+        quadgrams.push_back (quadgram);
+    };
+
+    if (quadgram_total <= QUADGRAM_BINS)
+    {
+        packed.resize (quadgram_total);
+        for (std::size_t i = 0; i < quadgram_total; i++)
+            packed[i] = NgramScorer::pack_quadgram (text + i);
+        std::sort (packed.begin(), packed.end());
+
+        for (std::size_t i = 0; i < packed.size(); )
+        {
+            std::size_t run = i + 1;
+            while ((run < packed.size()) && (packed[run] == packed[i]))
+                run++;
+            add_quadgram (packed[i], run - i);
+            i = run;
+        }
+    }
+    else
+    {
+        std::vector <std::uint64_t> counts (QUADGRAM_BINS, 0);
+        for (std::size_t i = 0; i < quadgram_total; i++)
+            counts[NgramScorer::pack_quadgram (text + i)]++;
+        for (std::uint32_t index = 0; index < QUADGRAM_BINS; index++)
+        {
+            if (counts[index] > 0)
+                add_quadgram (index, counts[index]);
+        }
+    }
+
+    // A letter occurring twice in a quadgram lists it once
+    auto for_each_letter = [] (const Quadgram& quadgram, auto&& body) {
+        for (unsigned int k = 0; k < NGRAM_WINDOW; k++)
+        {
+            if (std::find (quadgram.codes, quadgram.codes + k, quadgram.codes[k]) ==
+                quadgram.codes + k)
+                body (quadgram.codes[k]);
+        }
+    };
+
+    for (const Quadgram& quadgram : quadgrams)
+        for_each_letter (quadgram, [this] (std::uint8_t c) { first_containing[c + 1]++; });
+    std::partial_sum (first_containing.begin(), first_containing.end(),
+                      first_containing.begin());
+
+    std::array <std::uint32_t, LETTER_BINS> next;
+    std::copy (first_containing.begin(), first_containing.end() - 1, next.begin());
+    containing.resize (first_containing[LETTER_BINS]);
+    for (std::uint32_t e = 0; e < quadgrams.size(); e++)
+        for_each_letter (quadgrams[e], [&] (std::uint8_t c) { containing[next[c]++] = e; });
+}
+
+/**
+ * @fn SubstitutionSolver::order_by_frequency
+ *
+ * @param text: Ciphertext as letter indices 0-25.
+ * @param len: Number of letters.
+ *
+ * @brief Builds the key of the first climb from the letter frequencies StringAnalysis finds:
+ *        the most common cipher letter decrypts to the most common letter of the language, and
+ *        so on down. Ties keep alphabetical order, so the key depends on the text alone.
+ *
+ */
+void SubstitutionSolver::order_by_frequency (const std::uint8_t* text, std::size_t len)
+{
+    StringAnalysis analysis;
+    analysis.accumulate_letters (text, len);
+    const std::uint64_t* counts = analysis.get_symbol_counts();
+
+    std::array <std::uint8_t, LETTER_BINS> cipher_order, plain_order;
+    std::iota (cipher_order.begin(), cipher_order.end(), 0);
+    std::iota (plain_order.begin(), plain_order.end(), 0);
+    std::stable_sort (cipher_order.begin(), cipher_order.end(),
+                      [counts] (std::uint8_t a, std::uint8_t b) { return counts[a] > counts[b]; });
+    std::stable_sort (plain_order.begin(), plain_order.end(),
+                      [this] (std::uint8_t a, std::uint8_t b) {
+                          return frequencies[a] > frequencies[b];
+                      });
+
+    for (unsigned int r = 0; r < LETTER_BINS; r++)
+        frequency_key[cipher_order[r]] = plain_order[r];
+}
+
+/**
+ * @fn SubstitutionSolver::place_absent_letters
+ *
+ * @brief Gives the cipher letters absent from the text the plain letters left to them in
+ *        alphabetical order. Any order decrypts the text alike, so without this the key would
+ *        depend on which climb found it.
+ *
+ */
+void SubstitutionSolver::place_absent_letters ()
+{
+    std::array <std::uint8_t, LETTER_BINS> plain;
+    unsigned int absent = 0;
+    for (unsigned int c = 0; c < LETTER_BINS; c++)
+    {
+        if (first_containing[c] == first_containing[c + 1])
+            plain[absent++] = best_key[c];
+    }
+    std::sort (plain.begin(), plain.begin() + absent);
+
+    absent = 0;
+    for (unsigned int c = 0; c < LETTER_BINS; c++)
+    {
+        if (first_containing[c] == first_containing[c + 1])
+            best_key[c] = plain[absent++];
+    }
+}
+
+/**
+ * @fn SubstitutionSolver::climb
+ *
+ * @param state: A climb holding its starting key; receives the local maximum and its fitness.
+ *
+ * @brief Tries swapping the plain letters of every pair of cipher letters, keeping each swap
+ *        that raises the fitness, until a full pass over the pairs keeps none. A swap of cipher
+ *        letters a and b only rescores the quadgrams that contain a or b, so its cost is set by
+ *        how many distinct quadgrams those letters occur in rather than by the text length.
+ *
+ */
+void SubstitutionSolver::climb (Climb& state) const
+{
+    state.scores.resize (quadgrams.size());
+    for (std::size_t e = 0; e < quadgrams.size(); e++)
+        state.scores[e] = score_quadgram (quadgrams[e], state.key.data());
+
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        for (unsigned int a = 0; a < LETTER_BINS; a++)
+        {
+            for (unsigned int b = a + 1; b < LETTER_BINS; b++)
+            {
+                /*
+                 * A swap matters as long as either letter occurs: a cipher letter missing from
+                 * the text still holds a plain letter that one that occurs may be better off with
+                 */
+                if ((first_containing[a] == first_containing[a + 1]) &&
+                    (first_containing[b] == first_containing[b + 1]))
+                    continue;
+
+                std::swap (state.key[a], state.key[b]);
+
+                // Rescore the quadgrams of a, then those of b that a did not already cover
+                double delta = 0.0;
+                state.changed.clear();
+                for (std::uint32_t i = first_containing[a]; i < first_containing[a + 1]; i++)
+                {
+                    std::uint32_t e = containing[i];
+                    double score = score_quadgram (quadgrams[e], state.key.data());
+                    state.changed.push_back (score);
+                    delta += score - state.scores[e];
+                }
+                for (std::uint32_t i = first_containing[b]; i < first_containing[b + 1]; i++)
+                {
+                    std::uint32_t e = containing[i];
+                    const std::uint8_t* codes = quadgrams[e].codes;
+                    if (std::find (codes, codes + NGRAM_WINDOW, a) != codes + NGRAM_WINDOW)
+                        continue;
+                    double score = score_quadgram (quadgrams[e], state.key.data());
+                    state.changed.push_back (score);
+                    delta += score - state.scores[e];
+                }
+
+                if (delta <= 0.0)
+                {
+                    std::swap (state.key[a], state.key[b]);
+                    continue;
+                }
+
+                std::size_t next = 0;
+                for (std::uint32_t i = first_containing[a]; i < first_containing[a + 1]; i++)
+                    state.scores[containing[i]] = state.changed[next++];
+                for (std::uint32_t i = first_containing[b]; i < first_containing[b + 1]; i++)
+                {
+                    const std::uint8_t* codes = quadgrams[containing[i]].codes;
+                    if (std::find (codes, codes + NGRAM_WINDOW, a) == codes + NGRAM_WINDOW)
+                        state.scores[containing[i]] = state.changed[next++];
+                }
+                improved = true;
+            }
+        }
+    }
+
+    state.fitness = 0.0;
+    for (double score : state.scores)
+        state.fitness += score;
+}
+
+/**
+ * @fn SubstitutionSolver::score_quadgram
+ *
+ * @param quadgram: A distinct quadgram of the ciphertext.
+ * @param key: Decryption key, cipher letter to plain letter.
+ * @return The log10 probability of the quadgram's decryption, times its count.
+ *
+ */
+double SubstitutionSolver::score_quadgram (const Quadgram& quadgram,
+                                           const std::uint8_t* key) const
+{
+    unsigned char plain[NGRAM_WINDOW];
+    for (unsigned int k = 0; k < NGRAM_WINDOW; k++)
+        plain[k] = key[quadgram.codes[k]];
+    return (double)quadgram.count *
+           scorer->score_quadgram (NgramScorer::pack_quadgram (plain));
+}
+
+
+// === Mutators ===================================================================================
+
+/**
+ * @fn SubstitutionSolver::set_language_model
+ *
+ * @param model: Model of the plaintext language, or nullptr for the built-in English tables.
+ *
+ * @brief Climbs on the model's quadgrams and starts from its letter frequencies. The tables are
+ *        used in place, so the model must stay open while the solver uses it.
+ *
+ */
+void SubstitutionSolver::set_language_model (const LanguageModel* model)
+{
+    scorer = (model != nullptr) ? &model->get_scorer() : &NgramScorer::get_english();
+    frequencies = (model != nullptr) ? model->get_frequencies() : ALPHABET_FREQUENCIES;
+}
+
+
+// === Accessors ==================================================================================
+
+/**
+ * @fn SubstitutionSolver::get_key
+ *
+ * @return The best key found as the cipher letters of plain A-Z, the form a substitution key is
+ *         usually written in. Cipher letters absent from the text appear in alphabetical order
+ *         among the places left to them.
+ *
+ */
+std::string SubstitutionSolver::get_key () const
+{
+    std::string key (LETTER_BINS, 'A');
+    for (unsigned int c = 0; c < LETTER_BINS; c++)
+        key[best_key[c]] = (char)('A' + c);
+    return key;
+}
+
+/**
+ * @fn SubstitutionSolver::get_fitness
+ *
+ * @return The log10 quadgram likelihood per quadgram of the decryption with the best key, or 0
+ *         for a text too short to hold a quadgram.
+ *
+ */
+double SubstitutionSolver::get_fitness () const
+{
+    return (quadgram_total > 0) ? best_fitness / (double)quadgram_total : 0.0;
+}
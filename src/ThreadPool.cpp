@@ -0,0 +1,242 @@
+/**
+ * @file ThreadPool.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the ThreadPool class.
+ *
+ * @see ThreadPool.hpp
+ *
+ */
+
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// Pool and queue index of the worker running on the current thread, if any
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local unsigned int current_worker = 0;
+
+// === Ctors ======================================================================================
+
+ThreadPool::ThreadPool (unsigned int threads)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    queued_tasks = 0;
+    unfinished_tasks = 0;
+    next_queue = 0;
+    stopping = false;
+
+    for (unsigned int i = 0; i < threads; i++)
+        queues.push_back (std::unique_ptr <WorkerQueue> (new WorkerQueue()));
+
+    for (unsigned int i = 0; i < threads; i++)
+        workers.push_back (std::thread (&ThreadPool::worker_loop, this, i));
+}
+
+ThreadPool::~ThreadPool ()
+{
+    wait_idle();
+
+    {
+        std::lock_guard <std::mutex> lock (state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+
+    for (unsigned int i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+
+// === Task Functions =============================================================================
+
+/**
+ * @fn ThreadPool::submit
+ *
+ * @param task: The work to be run on the pool.
+ *
+ * @brief Queues a task. Tasks submitted from a worker go to that worker's own queue so related
+ *        work stays on one core; tasks from outside the pool are spread round-robin.
+ *
+ */
+void ThreadPool::submit (std::function <void()> task)
+{
+    unsigned int target = 0;
+    if (current_pool == this)
+        target = current_worker;
+    else
+    {
+        std::lock_guard <std::mutex> lock (state_mutex);
+        target = next_queue;
+        next_queue = (next_queue + 1) % queues.size();
+    }
+
+    // Counted before it is visible so a fast worker can never finish it before it is counted
+    {
+        std::lock_guard <std::mutex> lock (state_mutex);
+        queued_tasks++;
+        unfinished_tasks++;
+    }
+
+    {
+        std::lock_guard <std::mutex> lock (queues[target]->queue_mutex);
+        queues[target]->tasks.push_back (std::move (task));
+    }
+    work_available.notify_one();
+}
+
+/**
+ * @fn ThreadPool::parallel_for
+ *
+ * @param count: Number of iterations.
+ * @param body: Called once for every index in [0, count).
+ *
+ * @brief Runs the iterations of a loop across the pool and returns once all of them are done.
+ *        The calling thread takes part, and only waits on iterations other threads have already
+ *        started, so it is safe to call from inside one of the pool's own tasks.
+ *
+ */
+void ThreadPool::parallel_for (std::size_t count, const std::function <void(std::size_t)>& body)
+{
+    struct LoopState {
+        std::atomic <std::size_t> next_index;
+        std::size_t completed;
+        std::mutex done_mutex;
+        std::condition_variable done;
+    };
+
+    if (count == 0)
+        return;
+
+    std::shared_ptr <LoopState> state (new LoopState());
+    state->next_index = 0;
+    state->completed = 0;
+
+    // Helpers hold their own reference to the state, which may outlive this call
+    auto run_iterations = [state, count, &body] {
+        std::size_t finished = 0;
+        for (std::size_t i = state->next_index++; i < count; i = state->next_index++)
+        {
+            body (i);
+            finished++;
+        }
+
+        if (finished > 0)
+        {
+            std::lock_guard <std::mutex> lock (state->done_mutex);
+            state->completed += finished;
+            if (state->completed == count)
+                state->done.notify_all();
+        }
+    };
+
+    std::size_t helpers = std::min <std::size_t> (workers.size(), count) - 1;
+    for (std::size_t h = 0; h < helpers; h++)
+        submit (run_iterations);
+
+    run_iterations();
+
+    std::unique_lock <std::mutex> lock (state->done_mutex);
+    state->done.wait (lock, [&] { return state->completed == count; });
+}
+
+/**
+ * @fn ThreadPool::wait_idle
+ *
+ * @brief Blocks until every submitted task has finished running.
+ *
+ * @pre Must not be called from one of the pool's own workers.
+ *
+ */
+void ThreadPool::wait_idle ()
+{
+    std::unique_lock <std::mutex> lock (state_mutex);
+    all_idle.wait (lock, [this] { return unfinished_tasks == 0; });
+}
+
+/**
+ * @fn ThreadPool::worker_loop
+ *
+ * @param index: Index of the queue owned by this worker.
+ *
+ * @brief Runs tasks until the pool is destroyed, sleeping whenever no queue has work.
+ *
+ */
+void ThreadPool::worker_loop (unsigned int index)
+{
+    current_pool = this;
+    current_worker = index;
+
+    std::function <void()> task;
+    while (true)
+    {
+        if (take_task (index, task))
+        {
+            task();
+            task = nullptr;
+
+            std::lock_guard <std::mutex> lock (state_mutex);
+            if (--unfinished_tasks == 0)
+                all_idle.notify_all();
+            continue;
+        }
+
+        std::unique_lock <std::mutex> lock (state_mutex);
+        work_available.wait (lock, [this] { return stopping || (queued_tasks > 0); });
+        if (stopping && (queued_tasks == 0))
+            return;
+    }
+}
+
+/**
+ * @fn ThreadPool::take_task
+ *
+ * @param index: Index of the queue owned by the calling worker.
+ * @param task: Receives the task that was taken.
+ * @return true if a task was found, false if every queue was empty.
+ *
+ * @brief Takes the newest task from the worker's own queue, or steals the oldest task from
+ *        another worker's queue when its own is empty.
+ *
+ */
+bool ThreadPool::take_task (unsigned int index, std::function <void()>& task)
+{
+    unsigned int queue_count = queues.size();
+    bool found = false;
+
+    for (unsigned int i = 0; (i < queue_count) && !found; i++)
+    {
+        WorkerQueue& queue = *queues[(index + i) % queue_count];
+        std::lock_guard <std::mutex> lock (queue.queue_mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0)
+        {
+            task = std::move (queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move (queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        found = true;
+    }
+
+    if (found)
+    {
+        std::lock_guard <std::mutex> lock (state_mutex);
+        queued_tasks--;
+    }
+
+    return found;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file TrainingText.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains the English sample text the built-in n-gram tables are trained on. The text is
+ *        a mix of narrative, descriptive and expository prose so that no single register
+ *        dominates the statistics.
+ *
+ * @see TrainingText.hpp
+ *
+ */
+
+
+#include "TrainingText.hpp"
+
+const char ENGLISH_TRAINING_TEXT[] =
+    "It was late in the autumn when the letter finally arrived at the house on the hill. The "
+    "old man who lived there had been waiting for it since the end of the summer, and every "
+    "morning he walked down the long road to the village to ask whether anything had come for "
+    "him. The woman who kept the post office always shook her head and told him that she "
+    "would send word the moment it appeared, but he came anyway, because the walk gave him "
+    "something to do and because he did not believe that anyone would remember him if he "
+    "stopped asking. When the envelope was at last placed in his hands he did not open it at "
+    "once. He carried it home in the inside pocket of his coat, close to his chest, and set "
+    "it on the kitchen table while he made a pot of tea. Only when the tea was poured and the "
+    "fire had been built up against the cold did he sit down, put on his glasses and break "
+    "the seal. The letter was from his daughter, who had gone to work in the city many years "
+    "before and who wrote only rarely. She said that she was well, that the children were "
+    "growing quickly and that she hoped to visit in the spring if the roads were open and the "
+    "weather was kind. She asked about his health and about the garden, and whether the apple "
+    "trees had given much fruit this year. He read the letter three times before he folded it "
+    "and put it back into the envelope. Then he sat for a long while looking out of the "
+    "window at the fields, which were brown and empty now that the harvest had been brought "
+    "in. He thought about the years when his wife had been alive and the house had been full "
+    "of noise, and about how quiet it had become since then. He was not unhappy, exactly, but "
+    "he had grown used to the silence in a way that sometimes frightened him. The history of "
+    "written communication is in many ways the history of trust. For most of human history, a "
+    "message that had to travel any distance was carried by a person, and the safety of its "
+    "contents depended entirely on the honesty of the messenger. Kings and generals who "
+    "needed to send orders across hostile territory therefore looked for ways to make their "
+    "words unreadable to anyone who might intercept them. The simplest of these methods "
+    "replaced each letter of the message with another letter a fixed number of places further "
+    "along the alphabet. Julius Caesar is said to have used a shift of three in his private "
+    "correspondence, and the technique still carries his name. A cipher of this kind offers "
+    "very little real protection. Because there are only twenty five possible shifts, an "
+    "attacker can simply try each of them in turn and read off the one that produces sensible "
+    "text. Even without trying every key, the frequencies of the letters give the game away: "
+    "in ordinary English the letter E appears far more often than any other, followed by T, "
+    "A, O, I and N, and the most common letter in a long ciphertext is very likely to stand "
+    "for one of these. Over the centuries scholars in many countries noticed this weakness "
+    "and wrote about methods for exploiting it. The answer that was eventually found was to "
+    "use more than one alphabet. In a polyalphabetic cipher the shift applied to each letter "
+    "changes according to a keyword, so that the same plaintext letter may be written in "
+    "several different ways depending on its position in the message. For a long time this "
+    "method was considered unbreakable, and it was known in France as the indecipherable "
+    "cipher. Its weakness, which was described in the nineteenth century, is that the keyword "
+    "repeats. If the length of the keyword can be discovered, the message can be divided into "
+    "columns, each of which was written with a single shift and can be attacked separately. "
+    "Science depends on the willingness of people to test their ideas against the world and "
+    "to change their minds when the evidence requires it. This sounds simple, but it is one "
+    "of the hardest things that anyone can be asked to do. We become attached to our beliefs, "
+    "especially when we have worked hard to reach them or when other people know that we hold "
+    "them. Admitting that we were wrong feels like a kind of defeat, and it is tempting to "
+    "look for reasons to ignore the facts that do not fit. The great strength of the "
+    "scientific method is that it does not rely on any single person being free of this "
+    "temptation. Instead it places ideas in public, where others can check them, repeat the "
+    "experiments and point out the mistakes. Good engineering follows a similar path. A "
+    "program that works on the first day is rarely the program that is still running ten "
+    "years later. Between those two points it is measured, questioned and rewritten many "
+    "times, usually by people who were not there when it began. The best systems are those "
+    "that make this work easy: they are written in small pieces with clear purposes, they "
+    "record what they are doing, and they fail loudly when something goes wrong instead of "
+    "quietly producing the wrong answer. Speed matters, but it matters much less than being "
+    "able to understand why the machine behaves as it does. The river rose steadily through "
+    "the night. By the time the sun came up the water had covered the lower meadow and was "
+    "lapping at the edge of the road, and the farmers who lived along the valley had begun to "
+    "move their animals to higher ground. Nobody could remember a flood like it. The oldest "
+    "people in the village said that their grandparents had spoken of a great storm long ago, "
+    "when the bridge had been carried away and the church had been used as a shelter for a "
+    "whole week, but no one living had seen anything of the sort. In the afternoon the rain "
+    "stopped and a pale light broke through the clouds. People came out of their houses to "
+    "look at the damage. Fences had been torn down and the road was thick with mud, but the "
+    "water had not reached the houses, and no one had been hurt. Neighbours who had not "
+    "spoken for years found themselves working side by side, carrying sandbags and clearing "
+    "branches, and when the work was done they stood together on the bridge and watched the "
+    "brown water rush beneath them. Someone brought bread and cheese, someone else brought "
+    "beer, and for a few hours the village felt like a single family. Children learn to read "
+    "in many different ways, but almost all of them begin by listening. Long before they can "
+    "recognise a single letter they have heard thousands of stories and learned how a "
+    "sentence sounds, where the questions come and how a tale moves from its beginning to its "
+    "end. Teachers who understand this spend a great deal of time reading aloud, even to "
+    "pupils who can already read for themselves, because hearing good language spoken well is "
+    "one of the surest ways to learn it. The habit of reading for pleasure, once formed, "
+    "tends to last for life, and those who have it are seldom lonely for long. The market "
+    "opened early on Saturday mornings. By seven o'clock the square was crowded with stalls "
+    "selling vegetables, fish, flowers, bread and cheap clothing, and the air was full of the "
+    "shouts of traders and the smell of frying onions. Visitors from the city came to buy "
+    "fresh food and to wander among the crowds, while the local people moved quickly from one "
+    "stall to the next with their baskets, knowing exactly what they wanted and what it ought "
+    "to cost. By noon most of the best produce had gone, and by two the square was empty "
+    "again except for the pigeons. There is an old saying that a journey of a thousand miles "
+    "begins with a single step. It is often quoted to encourage people who feel overwhelmed "
+    "by a large task, and it is good advice as far as it goes. What the saying does not "
+    "mention is that the second step is usually harder than the first, and the hundredth "
+    "harder still. Beginning is exciting; continuing is work. The people who finish great "
+    "projects are rarely those with the most talent or the best ideas. They are the ones who "
+    "keep going on the dull days, when nothing seems to be happening and the goal is still "
+    "far away. ";
+
+const std::size_t ENGLISH_TRAINING_TEXT_LENGTH = sizeof (ENGLISH_TRAINING_TEXT) - 1;
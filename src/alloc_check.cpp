@@ -0,0 +1,126 @@
+/**
+ * @file alloc_check.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Checks that a reused DecryptEngine cracks messages without touching the heap. One
+ *        Caesar and one Vigenere engine share a thread pool, as the engines of batch mode, serve
+ *        mode and the C library do. They are warmed up on a message of the largest size, then
+ *        crack a fixed, seeded corpus of messages up to that size; any message that allocates is
+ *        listed and the exit status is 1.
+ *
+ *        Usage: alloc_check
+ *
+ */
+
+#include "CorpusGenerator.hpp"
+#include "decrypt.hpp"
+#include "ThreadPool.hpp"
+
+#include <iostream>
+#include <string>
+
+
+// Message sizes of the corpus, largest first; the engines are warmed up on the first
+const std::size_t ALLOC_CHECK_SIZES[] = { 100000, 10000, 1000, 100 };
+
+// Messages cracked per size and mode
+const unsigned int ALLOC_CHECK_MESSAGES = 25;
+
+// Seed of the corpus, so every run checks the same messages
+const std::uint64_t ALLOC_CHECK_SEED = 1;
+
+// Threads of the shared pool; more than one, so work handed to it would run on other threads
+const unsigned int ALLOC_CHECK_THREADS = 4;
+
+
+/**
+ * @fn crack_caesar
+ *
+ * @param engine: The reused Caesar engine.
+ * @param generator: Source of the message.
+ * @param size: Length of the message in bytes.
+ * @param text: Storage for the message, reused between calls.
+ * @return Heap allocations made cracking the message.
+ *
+ */
+std::uint64_t crack_caesar (DecryptEngine& engine, CorpusGenerator& generator, std::size_t size,
+                            std::string& text)
+{
+    generator.gen_plaintext (text, size);
+    CorpusGenerator::encrypt_caesar (text, generator.gen_caesar_key());
+    engine.set_ciphertext (text);
+    engine.process_caesar();
+    engine.decrypt_caesar_cipher (engine.most_likely_key());
+    return engine.get_message_allocations();
+}
+
+/**
+ * @fn crack_vigenere
+ *
+ * @param engine: The reused Vigenere engine.
+ * @param generator: Source of the message and its key.
+ * @param size: Length of the message in bytes.
+ * @param text: Storage for the message, reused between calls.
+ * @return Heap allocations made cracking the message.
+ *
+ */
+std::uint64_t crack_vigenere (DecryptEngine& engine, CorpusGenerator& generator,
+                              std::size_t size, std::string& text)
+{
+    generator.gen_plaintext (text, size);
+    CorpusGenerator::encrypt_vigenere (text, generator.gen_vigenere_key());
+    engine.set_ciphertext (text);
+    engine.process_vigenere();
+    return engine.get_message_allocations();
+}
+
+
+int main (int argc, char** argv)
+{
+    if (argc > 1)
+    {
+        std::cerr << "Usage: alloc_check\n";
+        return 1;
+    }
+
+    CorpusGenerator generator (ALLOC_CHECK_SEED);
+    ThreadPool pool (ALLOC_CHECK_THREADS);
+    DecryptEngine caesar, vigenere;
+    caesar.set_thread_pool (&pool);
+    vigenere.set_thread_pool (&pool);
+    caesar.enable_instrumentation (true);
+    vigenere.enable_instrumentation (true);
+
+    // The text is generated into storage grown by the warm-up, so only the engines can allocate
+    std::string text;
+    crack_caesar (caesar, generator, ALLOC_CHECK_SIZES[0], text);
+    crack_vigenere (vigenere, generator, ALLOC_CHECK_SIZES[0], text);
+
+    unsigned int messages = 0, failures = 0;
+    for (std::size_t size : ALLOC_CHECK_SIZES)
+    {
+        for (unsigned int m = 0; m < ALLOC_CHECK_MESSAGES; m++, messages += 2)
+        {
+            std::uint64_t caesar_allocations = crack_caesar (caesar, generator, size, text);
+            std::uint64_t vigenere_allocations = crack_vigenere (vigenere, generator, size, text);
+            if (caesar_allocations != 0)
+            {
+                std::cerr << "Caesar message of " << size << " bytes made " << caesar_allocations
+                          << " allocations\n";
+                failures++;
+            }
+            if (vigenere_allocations != 0)
+            {
+                std::cerr << "Vigenere message of " << size << " bytes, key "
+                          << vigenere.get_calculated_key() << ", made " << vigenere_allocations
+                          << " allocations\n";
+                failures++;
+            }
+        }
+    }
+
+    std::cout << "Messages: " << messages << ", " << failures << " allocated\n";
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file bench.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Benchmark suite for StringAnalysis and DecryptEngine. Times each stage of the cracking
+ *        pipeline on its own over seeded synthetic corpora, reports key recovery accuracy next
+ *        to the timings, and saves or compares against a baseline file.
+ *
+ *        Usage: bench [--max-size BYTES] [--seed N] [--save FILE] [--compare FILE]
+ *
+ */
+
+#include "CorpusGenerator.hpp"
+#include "DecryptKernels.hpp"
+#include "KeyEnumerator.hpp"
+#include "LetterBuffer.hpp"
+#include "PrefixHistogramIndex.hpp"
+#include "SubstitutionSolver.hpp"
+#include "decrypt.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// Printed with a nonzero exit when the options cannot be parsed
+const char BENCH_USAGE[] = "Usage: bench [--max-size BYTES] [--seed N] [--save FILE] "
+                           "[--compare FILE]\n";
+
+// Input sizes benchmarked, smallest first; sizes above --max-size are skipped
+const std::size_t BENCH_SIZES[] = { 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+                                    1000000000 };
+const std::size_t DEFAULT_MAX_BENCH_SIZE = 10000000;
+
+// Each stage is repeated until it has run for at least this long
+const double MIN_STAGE_SECONDS = 0.05;
+
+// Largest input for which full cracks are run to measure accuracy
+const std::size_t MAX_ACCURACY_SIZE = 10000000;
+
+// Number of keys listed by the enumerate row
+const unsigned int BENCH_ENUMERATED_KEYS = 1000;
+
+
+/**
+ * @struct BenchResult
+ *
+ * @brief The timing of one stage on one input size.
+ *
+ */
+struct BenchResult {
+    std::string stage;
+    std::size_t size;
+    double ns_per_op;
+};
+
+
+/**
+ * @fn time_stage
+ *
+ * @param stage: Function running the stage once.
+ * @return Average wall time of one run in nanoseconds.
+ *
+ * @brief Repeats a stage until MIN_STAGE_SECONDS have passed and averages the runs.
+ *
+ */
+template <typename Stage>
+double time_stage (Stage stage)
+{
+    std::size_t runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+
+    do
+    {
+        stage();
+        runs++;
+        auto now = std::chrono::steady_clock::now();
+        elapsed = std::chrono::duration <double> (now - start).count();
+    } while (elapsed < MIN_STAGE_SECONDS);
+
+    return (elapsed * 1e9) / (double)runs;
+}
+
+/**
+ * @fn count_trials
+ *
+ * @param size: Input size being measured.
+ * @return Number of full cracks run to measure accuracy at this size.
+ *
+ */
+unsigned int count_trials (std::size_t size)
+{
+    if (size <= 10000)
+        return 50;
+    if (size <= 1000000)
+        return 10;
+    return 2;
+}
+
+/**
+ * @fn load_baseline
+ *
+ * @param path: Baseline file written by an earlier --save.
+ * @return Map from "<stage> <size>" to the saved measurement; empty if the file is missing.
+ *
+ */
+std::map <std::string, double> load_baseline (const std::string& path)
+{
+    std::map <std::string, double> baseline;
+    std::ifstream in (path);
+    std::string stage;
+    std::size_t size = 0;
+    double value = 0.0;
+
+    while (in >> stage >> size >> value)
+        baseline[stage + ' ' + std::to_string (size)] = value;
+
+    return baseline;
+}
+
+/**
+ * @fn print_row
+ *
+ * @brief Prints one line of the results table, with the change from the baseline if known.
+ *
+ */
+void print_row (const std::string& stage, std::size_t size, double value, const char* unit,
+                bool per_byte, const std::map <std::string, double>& baseline)
+{
+    std::cout << std::left << std::setw (12) << stage << std::right << std::setw (12) << size;
+
+    if (per_byte)
+    {
+        double ns_per_byte = value / (double)size;
+        std::cout << std::setw (12) << std::fixed << std::setprecision (3) << ns_per_byte
+                  << " ns/B" << std::setw (12) << std::setprecision (1)
+                  << ((double)size / value) * 1e3 << " MB/s";
+    }
+    else
+        std::cout << std::setw (12) << std::fixed << std::setprecision (1) << value << ' '
+                  << unit << std::setw (17) << ' ';
+
+    auto saved = baseline.find (stage + ' ' + std::to_string (size));
+    if ((saved != baseline.end()) && (saved->second > 0.0))
+    {
+        // Lower is better for timings, higher is better for accuracy
+        double change = ((value - saved->second) / saved->second) * 100.0;
+        std::cout << std::setw (10) << std::showpos << std::setprecision (1) << change << '%'
+                  << std::noshowpos;
+    }
+    std::cout << '\n';
+}
+
+
+int main (int argc, char** argv)
+{
+    std::size_t max_size = DEFAULT_MAX_BENCH_SIZE;
+    std::uint64_t seed = 1;
+    std::string save_path, compare_path;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        bool known = (option == "--max-size") || (option == "--seed") || (option == "--save") ||
+                     (option == "--compare");
+        if (!known || (i + 1 >= argc))
+        {
+            if (!known)
+                std::cerr << "Unknown option " << option << '\n';
+            else
+                std::cerr << "Missing value for " << option << '\n';
+            std::cerr << BENCH_USAGE;
+            return 1;
+        }
+
+        if (option == "--max-size")
+            max_size = std::strtoull (argv[i + 1], nullptr, 10);
+        else if (option == "--seed")
+            seed = std::strtoull (argv[i + 1], nullptr, 10);
+        else if (option == "--save")
+            save_path = argv[i + 1];
+        else
+            compare_path = argv[i + 1];
+    }
+
+    std::map <std::string, double> baseline;
+    if (!compare_path.empty())
+    {
+        baseline = load_baseline (compare_path);
+        if (baseline.empty())
+            std::cout << "No baseline found at " << compare_path << "\n";
+    }
+
+    std::cout << "Decrypt kernels: " << get_decrypt_kernel_name() << "\n\n";
+    std::cout << std::left << std::setw (12) << "stage" << std::right << std::setw (12) << "bytes"
+              << std::setw (17) << "cost" << std::setw (17) << "throughput" << std::setw (11)
+              << "vs base" << '\n';
+
+    std::vector <BenchResult> results;
+    CorpusGenerator generator (seed);
+    std::string text, letters;
+
+    for (std::size_t size : BENCH_SIZES)
+    {
+        if (size > max_size)
+            break;
+
+        /*
+         * Stage timings run on a letters-only Vigenere ciphertext of the given size; only the
+         * normalization runs on the plaintext, spaces included
+         */
+        generator.gen_plaintext (text, size * 2);
+        letters.clear();
+        for (char c : text)
+        {
+            if (c != ' ')
+                letters += c;
+        }
+        letters.resize (std::min (size, letters.size()));
+        std::string key = generator.gen_vigenere_key();
+        CorpusGenerator::encrypt_vigenere (letters, key);
+        std::size_t n = letters.size();
+
+        Histogram histogram;
+        LetterBuffer normalized, spaced;
+        normalized.normalize (letters);
+        const std::uint8_t* indices = normalized.get_letters();
+        StringAnalysis analysis (letters);
+        KeyLengthSearch key_search;
+        ColumnHistograms columns;
+        PrefixHistogramIndex prefix_index;
+        double correlations[26];
+        std::string plaintext (n, ' ');
+        analysis.gen_char_instance_profile();
+
+        std::vector <BenchResult> stages = {
+            { "normalize", n, time_stage ([&] {
+                spaced.normalize (text.data(), n);
+            }) },
+            { "histogram", n, time_stage ([&] {
+                histogram.clear();
+                histogram.count (letters.data(), n);
+            }) },
+            { "ic", n, time_stage ([&] {
+                analysis.gen_char_frequency_profile();
+                analysis.calculate_IC();
+            }) },
+            { "correlation", n, time_stage ([&] {
+                DecryptEngine::calc_column_correlations (histogram.get_letter_counts().data(),
+                                                         histogram.get_total(), correlations);
+            }) },
+            { "keylength", n, time_stage ([&] {
+                key_search.search (indices, n);
+            }) },
+            { "cache-hash", n, time_stage ([&] {
+                ResultCache::hash (indices, n, CACHE_SEED_VIGENERE);
+            }) },
+            { "split", n, time_stage ([&] {
+                columns.reset (key.size());
+                columns.count (indices, n);
+            }) },
+            { "prefix-index", n, time_stage ([&] {
+                prefix_index.build (letters.data(), n, key.size());
+            }) },
+            { "decrypt", n, time_stage ([&] {
+                decrypt_vigenere_span (letters.data(), &plaintext[0], n, key.data(), key.size(),
+                                       0);
+            }) },
+            { "caesar-mixed", n, time_stage ([&] {
+                MixedLatinAlphabet::decrypt (letters.data(), &plaintext[0], n, key.size());
+            }) },
+            { "caesar-bytes", n, time_stage ([&] {
+                ByteAlphabet::decrypt (letters.data(), &plaintext[0], n, key.size());
+            }) }
+        };
+
+        for (const BenchResult& r : stages)
+        {
+            print_row (r.stage, r.size, r.ns_per_op, "ns", true, baseline);
+            results.push_back (r);
+        }
+
+        // Listing the best keys only reads the column correlations, so it is timed per list
+        std::vector <double> column_scores (key.size() * LETTER_BINS);
+        columns.reset (key.size());
+        columns.count (indices, n);
+        for (unsigned int c = 0; c < key.size(); c++)
+            DecryptEngine::calc_column_correlations (columns.get_column (c),
+                                                     columns.get_column_total (c),
+                                                     &column_scores[c * LETTER_BINS]);
+        KeyEnumerator enumerator;
+        BenchResult enumeration = { "enumerate", size, time_stage ([&] {
+            enumerator.enumerate (column_scores.data(), key.size(), BENCH_ENUMERATED_KEYS);
+        }) / 1e6 };
+        print_row (enumeration.stage, size, enumeration.ns_per_op, "ms", false, baseline);
+        results.push_back (enumeration);
+
+        // A substitution crack is timed per message, on the plaintext under a reversed alphabet
+        std::string substituted (text, 0, std::min (size, text.size()));
+        for (char& c : substituted)
+        {
+            if ((c >= 'A') && (c <= 'Z'))
+                c = (char)('Z' - (c - 'A'));
+        }
+        SubstitutionSolver solver;
+        BenchResult substitution = { "substitution", size, time_stage ([&] {
+            solver.solve (substituted);
+        }) / 1e6 };
+        print_row (substitution.stage, size, substitution.ns_per_op, "ms", false, baseline);
+        results.push_back (substitution);
+
+        if (size > MAX_ACCURACY_SIZE)
+            continue;
+
+        /*
+         * Accuracy: percentage of random keys recovered exactly by the full crack. The same two
+         * engines crack every trial, as in batch mode. Allocations are averaged over the second
+         * half of the trials, once the engines have warmed up; only a message longer than any
+         * before it should make one
+         */
+        unsigned int trials = count_trials (size), caesar_hits = 0, vigenere_hits = 0;
+        std::uint64_t steady_allocations = 0, steady_trials = 0;
+        DecryptEngine caesar, vigenere;
+        for (unsigned int t = 0; t < trials; t++)
+        {
+            generator.gen_plaintext (text, size);
+            char caesar_key = generator.gen_caesar_key();
+            CorpusGenerator::encrypt_caesar (text, caesar_key);
+            caesar.set_ciphertext (text);
+            caesar.process_caesar();
+            caesar.decrypt_caesar_cipher (caesar.most_likely_key());
+            caesar_hits += (caesar.most_likely_key() == caesar_key);
+            std::uint64_t caesar_allocations = caesar.get_message_allocations();
+
+            generator.gen_plaintext (text, size);
+            std::string vigenere_key = generator.gen_vigenere_key();
+            CorpusGenerator::encrypt_vigenere (text, vigenere_key);
+            vigenere.set_ciphertext (text);
+            vigenere.process_vigenere();
+            vigenere_hits += (vigenere.get_calculated_key() == vigenere_key);
+
+            if (t >= trials / 2)
+            {
+                steady_allocations += caesar_allocations + vigenere.get_message_allocations();
+                steady_trials += 2;
+            }
+        }
+
+        BenchResult caesar_accuracy = { "acc-caesar", size, 100.0 * caesar_hits / trials };
+        BenchResult vigenere_accuracy = { "acc-vigenere", size, 100.0 * vigenere_hits / trials };
+        print_row (caesar_accuracy.stage, size, caesar_accuracy.ns_per_op, "%", false, baseline);
+        print_row (vigenere_accuracy.stage, size, vigenere_accuracy.ns_per_op, "%", false,
+                   baseline);
+        results.push_back (caesar_accuracy);
+        results.push_back (vigenere_accuracy);
+
+        BenchResult allocations = { "allocs", size,
+                                    (double)steady_allocations / (double)steady_trials };
+        print_row (allocations.stage, size, allocations.ns_per_op, "/msg", false, baseline);
+        results.push_back (allocations);
+        std::cout << '\n';
+    }
+
+    if (!save_path.empty())
+    {
+        std::ofstream out (save_path);
+        for (const BenchResult& r : results)
+            out << r.stage << ' ' << r.size << ' ' << std::setprecision (10) << r.ns_per_op
+                << '\n';
+        std::cout << "Baseline saved to " << save_path << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file build_model.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Offline tool that builds a language model file from sample texts in that language. The
+ *        files it writes are memory-mapped by LanguageModel and ModelLibrary.
+ *
+ *        Usage: build_model <name> <output> [corpus ...]
+ *
+ *        With no corpus files the built-in English sample text is used.
+ *
+ */
+
+#include "LanguageModel.hpp"
+#include "MappedFile.hpp"
+#include "TrainingText.hpp"
+
+#include <iostream>
+#include <string>
+
+
+int main (int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: build_model <name> <output> [corpus ...]\n";
+        return 1;
+    }
+
+    std::string name = argv[1], output = argv[2];
+    std::string text;
+    if (argc == 3)
+        text.assign (ENGLISH_TRAINING_TEXT, ENGLISH_TRAINING_TEXT_LENGTH);
+
+    // Corpora are joined with a line break; anything other than a letter is skipped when training
+    for (int i = 3; i < argc; i++)
+    {
+        MappedFile corpus;
+        if (!corpus.open (argv[i]))
+        {
+            std::cerr << "Unable to open " << argv[i] << '\n';
+            return 1;
+        }
+        text.append (corpus.get_data(), corpus.get_size());
+        text += '\n';
+    }
+
+    if (!LanguageModel::build (output, name, text.data(), text.size()))
+    {
+        std::cerr << "Unable to build " << output << " for " << name << '\n';
+        return 1;
+    }
+
+    LanguageModel model;
+    if (!model.open (output))
+    {
+        std::cerr << "Unable to read back " << output << '\n';
+        return 1;
+    }
+
+    std::cout << model.get_name() << ": " << model.get_training_letters() << " letters, IC "
+              << model.get_expected_IC() << " -> " << output << '\n';
+    return 0;
+}
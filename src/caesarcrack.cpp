@@ -0,0 +1,387 @@
+/**
+ * @file caesarcrack.cpp
+ *
+ * @author Drew Wheeler
+ * @date 2026-10-17
+ *
+ * @brief Contains function definitions for the C interface of libcaesarcrack. No exception
+ *        crosses it: every entry point turns one into a status code.
+ *
+ * @see caesarcrack.h
+ *
+ */
+
+
+#include "caesarcrack.h"
+
+#include "Alphabet.hpp"
+#include "decrypt.hpp"
+#include "LetterBuffer.hpp"
+#include "StringAnalysis.hpp"
+#include "SubstitutionSolver.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * The layouts hosts are compiled against. A change that trips one of these breaks every host
+ * built with an older header, so it must come with a new CC_API_VERSION
+ */
+static_assert (sizeof (cc_message) == 72, "cc_message layout changed");
+static_assert (offsetof (cc_message, ciphertext_length) == 8, "cc_message layout changed");
+static_assert (offsetof (cc_message, plaintext) == 16, "cc_message layout changed");
+static_assert (offsetof (cc_message, plaintext_capacity) == 24, "cc_message layout changed");
+static_assert (offsetof (cc_message, key) == 32, "cc_message layout changed");
+static_assert (offsetof (cc_message, key_capacity) == 40, "cc_message layout changed");
+static_assert (offsetof (cc_message, plaintext_length) == 48, "cc_message layout changed");
+static_assert (offsetof (cc_message, key_length) == 56, "cc_message layout changed");
+static_assert (offsetof (cc_message, status) == 64, "cc_message layout changed");
+static_assert (sizeof (cc_analysis) == 224, "cc_analysis layout changed");
+static_assert (offsetof (cc_analysis, letters) == 208, "cc_analysis layout changed");
+static_assert (offsetof (cc_analysis, ic) == 216, "cc_analysis layout changed");
+
+/**
+ * @struct CrackSlot
+ *
+ * @brief What one thread needs to crack messages: an engine for the Caesar and Vigenere modes,
+ *        and a solver and the letters of its message for the substitution mode.
+ *
+ */
+struct CrackSlot {
+    DecryptEngine engine;
+    SubstitutionSolver solver;
+    LetterBuffer letters;
+};
+
+/**
+ * @struct cc_engine
+ *
+ * @brief The handle behind the opaque C type: its mode and flags, the pool every slot shares and
+ *        one slot per range of a batch, created as batches first need them.
+ *
+ */
+struct cc_engine {
+    cc_engine (int m, unsigned int f, unsigned int threads) : mode (m), flags (f), pool (threads)
+        {}
+
+    int mode;
+    unsigned int flags;
+    ThreadPool pool;
+    std::vector <std::unique_ptr <CrackSlot>> slots;
+};
+
+/**
+ * @fn add_slots
+ *
+ * @param engine: Handle to be given the slots.
+ * @param count: Number of slots needed.
+ *
+ * @brief Creates the slots a call needs that the handle does not have yet. Slots use the
+ *        handle's pool for their own parallel work, which is safe from inside its tasks.
+ *
+ */
+static void add_slots (cc_engine& engine, std::size_t count)
+{
+    while (engine.slots.size() < count)
+    {
+        std::unique_ptr <CrackSlot> slot (new CrackSlot());
+        slot->engine.set_thread_pool (&engine.pool);
+        slot->solver.set_thread_pool (&engine.pool);
+        engine.slots.push_back (std::move (slot));
+    }
+}
+
+/**
+ * @fn write_key
+ *
+ * @param message: Message whose key buffer receives the key.
+ * @param key: The key found.
+ * @param size: Number of letters in key.
+ * @return true if the key fit; it is followed by a NUL when there is room for one.
+ *
+ */
+static bool write_key (cc_message& message, const char* key, std::size_t size)
+{
+    message.key_length = size;
+    if (message.key_capacity < size)
+        return false;
+
+    if (size > 0)
+        std::memcpy (message.key, key, size);
+    if (message.key_capacity > size)
+        message.key[size] = '\0';
+    return true;
+}
+
+/**
+ * @fn crack_message
+ *
+ * @param engine: Handle whose mode and flags apply.
+ * @param slot: Slot the message is cracked with, used by this thread alone.
+ * @param message: Message to be cracked.
+ * @return The status of the message.
+ *
+ * @brief Cracks one message. The plaintext is decrypted straight into the caller's buffer: the
+ *        Caesar ciphertext is counted and decrypted where it is, and the other modes read it
+ *        once into their letter indices. The buffers are checked before anything is written to
+ *        them, and the caller's ciphertext is only read before its plaintext is written, so the
+ *        two may be the same memory.
+ *
+ */
+static int crack_message (cc_engine& engine, CrackSlot& slot, cc_message& message)
+{
+    message.plaintext_length = 0;
+    message.key_length = 0;
+    if (((message.ciphertext == nullptr) && (message.ciphertext_length > 0)) ||
+        ((message.plaintext == nullptr) && (message.plaintext_capacity > 0)) ||
+        ((message.key == nullptr) && (message.key_capacity > 0)))
+        return CC_ERROR_ARGUMENT;
+
+    const char* ciphertext = message.ciphertext;
+    std::size_t length = (std::size_t)message.ciphertext_length;
+    bool keep_layout = (engine.flags & CC_KEEP_LAYOUT) != 0;
+    if (((engine.mode == CC_MODE_CAESAR) || keep_layout) && (message.plaintext_capacity < length))
+    {
+        message.plaintext_length = length;
+        return CC_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    try
+    {
+        if (engine.mode == CC_MODE_CAESAR)
+        {
+            slot.engine.process_caesar_buffer (ciphertext, length);
+            char key = slot.engine.most_likely_key();
+            if (!write_key (message, &key, 1))
+                return CC_ERROR_BUFFER_TOO_SMALL;
+
+            if (length > 0)
+                slot.engine.decrypt_caesar_buffer (ciphertext, length, message.plaintext);
+            message.plaintext_length = length;
+            return CC_OK;
+        }
+
+        if (engine.mode == CC_MODE_VIGENERE)
+        {
+            slot.engine.process_vigenere_buffer (ciphertext, length);
+            std::size_t needed = keep_layout ? slot.engine.get_text_size()
+                                             : slot.engine.get_letter_count();
+            const std::string& key = slot.engine.get_calculated_key();
+            if (!write_key (message, key.data(), key.size()))
+                return CC_ERROR_BUFFER_TOO_SMALL;
+            if (message.plaintext_capacity < needed)
+            {
+                message.plaintext_length = needed;
+                return CC_ERROR_BUFFER_TOO_SMALL;
+            }
+
+            if (needed > 0)
+                message.plaintext_length = slot.engine.decrypt_vigenere_buffer (message.plaintext,
+                                                                                keep_layout);
+            return CC_OK;
+        }
+
+        // The substitution mode decrypts into the end of the buffer and spreads the letters out
+        // from there, as DecryptEngine::decrypt_vigenere_buffer does
+        slot.letters.normalize (ciphertext, length);
+        std::size_t letter_count = slot.letters.get_letter_count();
+        std::size_t needed = keep_layout ? slot.letters.get_text_size() : letter_count;
+        slot.solver.solve_letters (slot.letters.get_letters(), letter_count);
+        std::string key = slot.solver.get_key();
+        if (!write_key (message, key.data(), key.size()))
+            return CC_ERROR_BUFFER_TOO_SMALL;
+        if (message.plaintext_capacity < needed)
+        {
+            message.plaintext_length = needed;
+            return CC_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        if (needed > 0)
+        {
+            char* letters = message.plaintext + (needed - letter_count);
+            slot.solver.decrypt_letters (slot.letters.get_letters(), letter_count, letters);
+            if (keep_layout)
+                slot.letters.restore (letters, message.plaintext);
+        }
+        message.plaintext_length = needed;
+        return CC_OK;
+    }
+    catch (...)
+    {
+        message.plaintext_length = 0;
+        return CC_ERROR_INTERNAL;
+    }
+}
+
+
+// === Interface Functions ========================================================================
+
+/**
+ * @fn cc_api_version
+ *
+ * @return The CC_API_VERSION the library was built with.
+ *
+ */
+int cc_api_version (void)
+{
+    return CC_API_VERSION;
+}
+
+/**
+ * @fn cc_message_size
+ *
+ * @return sizeof (cc_message) as the library was built, for hosts to check against their own.
+ *
+ */
+size_t cc_message_size (void)
+{
+    return sizeof (cc_message);
+}
+
+/**
+ * @fn cc_engine_create
+ *
+ * @param mode: One of the CC_MODE constants.
+ * @param flags: CC_KEEP_LAYOUT or 0.
+ * @param threads: Number of threads the engine cracks with; 0 for one per core.
+ * @return A new engine, or NULL for an unknown mode or flag or when it could not be created.
+ *
+ * @brief Creates an engine handle. Its threads and working memory last until it is destroyed,
+ *        so a host keeps one handle per thread that cracks rather than one per message.
+ *
+ */
+cc_engine* cc_engine_create (int mode, unsigned int flags, unsigned int threads)
+{
+    if ((mode < CC_MODE_CAESAR) || (mode > CC_MODE_SUBSTITUTION) ||
+        ((flags & ~CC_KEEP_LAYOUT) != 0))
+        return nullptr;
+
+    try
+    {
+        std::unique_ptr <cc_engine> engine (new cc_engine (mode, flags, threads));
+        add_slots (*engine, 1);
+        return engine.release();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+/**
+ * @fn cc_engine_destroy
+ *
+ * @param engine: Handle to be destroyed; NULL is ignored.
+ *
+ */
+void cc_engine_destroy (cc_engine* engine)
+{
+    delete engine;
+}
+
+/**
+ * @fn cc_crack
+ *
+ * @param engine: Handle to crack with.
+ * @param message: Message to be cracked.
+ * @return The status of the message, which is also stored in it.
+ *
+ * @brief Cracks one message, spreading the analysis of a long one across the engine's threads.
+ *
+ */
+int cc_crack (cc_engine* engine, cc_message* message)
+{
+    if ((engine == nullptr) || (message == nullptr))
+        return CC_ERROR_ARGUMENT;
+
+    message->status = crack_message (*engine, *engine->slots[0], *message);
+    return message->status;
+}
+
+/**
+ * @fn cc_crack_batch
+ *
+ * @param engine: Handle to crack with.
+ * @param messages: Messages to be cracked.
+ * @param count: Number of messages.
+ * @return Number of messages whose status is not CC_OK, or count if the batch could not start.
+ *
+ * @brief Cracks many messages in one call. The batch is split into one contiguous range per
+ *        thread, each cracked with its own slot, so the threads share no state but the pool.
+ *
+ */
+size_t cc_crack_batch (cc_engine* engine, cc_message* messages, size_t count)
+{
+    if ((engine == nullptr) || ((messages == nullptr) && (count > 0)))
+        return count;
+
+    std::size_t ranges = std::min <std::size_t> (count, engine->pool.get_thread_count());
+    try
+    {
+        add_slots (*engine, ranges);
+    }
+    catch (...)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            messages[i].status = CC_ERROR_INTERNAL;
+        return count;
+    }
+
+    engine->pool.parallel_for (ranges, [&] (std::size_t r) {
+        CrackSlot& slot = *engine->slots[r];
+        for (std::size_t i = count * r / ranges; i < count * (r + 1) / ranges; i++)
+            messages[i].status = crack_message (*engine, slot, messages[i]);
+    });
+
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < count; i++)
+        failed += (messages[i].status != CC_OK);
+    return failed;
+}
+
+/**
+ * @fn cc_analyze
+ *
+ * @param text: Text to be analyzed.
+ * @param length: Number of bytes in text.
+ * @param analysis: Receives its letter counts and index of coincidence.
+ * @return CC_OK, or CC_ERROR_ARGUMENT for a NULL pointer.
+ *
+ * @brief Counts the letters of a text where it is, folding lower case into upper case, and
+ *        finds the index of coincidence of the letters alone.
+ *
+ */
+int cc_analyze (const char* text, uint64_t length, cc_analysis* analysis)
+{
+    if ((analysis == nullptr) || ((text == nullptr) && (length > 0)))
+        return CC_ERROR_ARGUMENT;
+
+    try
+    {
+        BasicStringAnalysis <MixedLatinAlphabet> info;
+        info.accumulate (text, (std::size_t)length);
+        const std::uint64_t* counts = info.get_symbol_counts();
+
+        double coincidences = 0.0;
+        analysis->letters = 0;
+        for (unsigned int c = 0; c < LETTER_BINS; c++)
+        {
+            analysis->counts[c] = counts[c];
+            analysis->letters += counts[c];
+            coincidences += (double)counts[c] * ((double)counts[c] - 1.0);
+        }
+
+        double letters = (double)analysis->letters;
+        analysis->ic = (letters > 1.0) ? coincidences / (letters * (letters - 1.0)) : 0.0;
+        return CC_OK;
+    }
+    catch (...)
+    {
+        return CC_ERROR_INTERNAL;
+    }
+}
@@ -3,7 +3,7 @@
  * @author Drew Wheeler
  * @date 2023-02-12
  * 
- * @brief Contains function definitions for the DecryptEngine class.
+ * @brief Contains function definitions for the BasicDecryptEngine class template.
  * 
  * @see decrypt.hpp
  * 
@@ -11,66 +11,105 @@
 
 #include "decrypt.hpp"
 
+#include "DecryptKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 
 // === Deciphering Methods ========================================================================
 
 /**
- * @fn DecryptEngine::calc_correlation
+ * @fn BasicDecryptEngine::calc_correlation
  * 
- * @brief Calculates the correlation frequency for a given ciphertext.
+ * @brief Calculates the correlation frequency for a given ciphertext. Alphabets of the letters
+ *        A-Z are scored through the reference matrix of the active language; others against
+ *        their own reference frequencies.
  * 
  * @pre ciphertext_info has already processed the ciphertext stored.
  * @post Correlation frequency for the ciphertext is calculated and stored in correlation_frequency.
  * 
  */
-void DecryptEngine::calc_correlations()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::calc_correlations()
 {
-    // Implements: PHI(i) = SIGMA(0<=c<=25)(f(c)f'(e-i))
-    double char_ciphertext_freq = 0.0, char_alphabet_freq = 0.0, phi_summation = 0.0;
-    char ASCII_char_representation = ' ';
+    const Histogram& ct_histogram = ciphertext_info.get_histogram();
+    const std::uint64_t* symbol_counts = ciphertext_info.get_symbol_counts();
+    if constexpr (Alphabet::LATIN)
+        calc_column_correlations (symbol_counts, ct_histogram.get_total(), correlation_frequency,
+                                  active_reference());
+    else
+    {
+        double total = (double)ct_histogram.get_total();
+        correlate_shifts (Alphabet::FREQUENCIES, symbol_counts, (total > 0) ? 1.0 / total : 0.0,
+                          correlation_frequency);
+    }
+}
 
-    unsigned int i = 0, e = 0;
-    for (i = 0; i < 26; i++)
+/**
+ * @fn BasicDecryptEngine::calc_column_correlations
+ *
+ * @param letter_counts: Counts of the letters A-Z in some text.
+ * @param total: Length of that text, used to turn counts into frequencies.
+ * @param correlations: Array of 26 values receiving the correlation frequency of each shift.
+ * @param reference: Precomputed rotations of the plaintext letter frequencies; by default those
+ *                   of ALPHABET_FREQUENCIES.
+ * @return The shift with the highest correlation frequency.
+ *
+ * @brief Calculates the correlation frequency of every shift for a set of letter counts using
+ *        the precomputed rotations of a reference distribution. Shared by the whole-text
+ *        analysis and the per-column Vigenere solver, so it sits inside the Vigenere inner loop.
+ *
+ */
+template <class Alphabet>
+unsigned int BasicDecryptEngine <Alphabet>::calc_column_correlations (
+    const std::uint64_t* letter_counts, std::uint64_t total, double* correlations,
+    const RotatedReference& reference)
+{
+    // Implements: PHI(i) = SIGMA(0<=c<=25)(f(c)f'(e-i)) for every i as one matrix-vector product
+    double scores[SHIFT_LANES];
+    double scale = (total > 0) ? 1.0 / (double)total : 0.0;
+    score_shifts (reference, letter_counts, scale, scores);
+
+    unsigned int best = 0;
+    for (unsigned int i = 0; i < 26; i++)
     {
-        phi_summation = 0.0;
-        for (e = 0; e < 26; e++)
-        {
-            ASCII_char_representation = e + 'A';
-            char_ciphertext_freq = ciphertext_info.get_char_freq(ASCII_char_representation);
-            char_alphabet_freq = ALPHABET_FREQUENCIES[((26 + e) - i) % 26];
-            phi_summation += char_ciphertext_freq * char_alphabet_freq;
-        }
-        correlation_frequency[i] = phi_summation;
+        correlations[i] = scores[i];
+        if (scores[i] > scores[best])
+            best = i;
     }
+
+    return best;
 }
 
 /**
- * @fn DecryptEngine::decrypt_caesar_cipher
+ * @fn BasicDecryptEngine::decrypt_caesar_cipher
  * 
  * @brief Decrypts the data_string stored in ciphertext_info using the given character and the
- *        Caesar cipher algorithm.
+ *        Caesar cipher algorithm. Only symbols of the alphabet are shifted; all other bytes are
+ *        copied.
  * 
- * @param char key: The character (in ASCII) to be used as the decryption key.
+ * @param char key: The symbol to be used as the decryption key, e.g. 'D' for a shift of 3.
  * 
  * @pre ciphertext_info should be storing a string encrypted using the Caesar cipher.
  * @post The string in ciphertext_info is decrypted using the Caesar cipher and the key character
  *       and the result is stored in 
  * 
  */
-void DecryptEngine::decrypt_caesar_cipher (char key)
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::decrypt_caesar_cipher (char key)
 {
-    plaintext = ciphertext_info.get_string();
+    const std::string& ct = ciphertext_info.get_string();
+    StageTimer timer (active_stats(), STAGE_DECRYPT, ct.size());
 
-    unsigned int i = 0, str_len = plaintext.size();
-    for (i = 0; i < str_len; i++)
-    {
-        if (plaintext[i] != ' ')
-            plaintext[i] = ((((plaintext[i] - 'A') + 26) - (key - 'A')) % 26) + 'A';
-    }
+    // Resizing keeps the capacity of plaintext, so repeat calls do not allocate
+    plaintext.resize (ct.size());
+    Alphabet::decrypt (ct.data(), &plaintext[0], ct.size(), key_shift (key));
 }
 
 /**
- * @fn DecryptEngine::decrypt_caesar_cipher
+ * @fn BasicDecryptEngine::decrypt_caesar_cipher
  * 
  * @brief Decrypts a character encrypted with ciphertext 
  * 
@@ -82,13 +121,14 @@ void DecryptEngine::decrypt_caesar_cipher (char key)
  * @post The decrypted character for ct is acquired and returned.
  * 
  */
-char DecryptEngine::decrypt_caesar_cipher (char ct, char key)
+template <class Alphabet>
+char BasicDecryptEngine <Alphabet>::decrypt_caesar_cipher (char ct, char key)
 {
-    return ((((ct - 'A') + 26) - (key - 'A')) % 26) + 'A';
+    return Alphabet::decrypt_symbol (ct, key_shift (key));
 }
 
 /**
- * @fn DecryptEngine::calc_key_length
+ * @fn BasicDecryptEngine::calc_key_length
  * 
  * @brief Utilizes a formula to calculate an estimated key length for some ciphertext.
  * 
@@ -96,7 +136,8 @@ char DecryptEngine::decrypt_caesar_cipher (char ct, char key)
  * @post Member data key_length contains an estimated key length for the ciphertext.
  * 
  */
-void DecryptEngine::calc_key_length()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::calc_key_length()
 {
     double key_estimate = 0.0;
 
@@ -104,41 +145,41 @@ void DecryptEngine::calc_key_length()
      * For more information on the formula used here, see this link:
      * https://www.nku.edu/~christensen/1402%20Friedman%20test%202.pdf
      */
-    key_estimate = (0.027 * (double)(ciphertext_info.get_string_length())) / 
-                   (((double)(ciphertext_info.get_string_length()) - 1)*ciphertext_info.get_IC() + 0.065 - (0.038 * (double)(ciphertext_info.get_string_length())));
+    double ct_length = (double)ciphertext_info.get_analyzed_length();
+    key_estimate = (0.027 * ct_length) / 
+                   ((ct_length - 1)*ciphertext_info.get_IC() + 0.065 - (0.038 * ct_length));
 
-    key_length = std::round (key_estimate);
+    // Short or unusual texts can push the estimate out of range; fall back to a single column
+    if ((!(key_estimate >= 1.0)) || (key_estimate > (double)MAX_KEY_LENGTH))
+        key_length = 1;
+    else
+        key_length = std::round (key_estimate);
 }
 
 /**
- * @fn DecryptEngine::split_ciphertext
- * 
- * @brief Splits a ciphertext into a number of sub-strings based on the estimated length of the key.
- * 
- * @pre Member data key_length has a non-zero value in it.
- * @post Sub-strings of characters from the ciphertext are generated. 
- * 
+ * @fn BasicDecryptEngine::search_key_length
+ *
+ * @param letters: The letters of the ciphertext, from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ *
+ * @brief Ranks every key length up to the search limit by average column IC and takes the best
+ *        one. Replaces the single Friedman estimate made by calc_key_length.
+ *
+ * @post key_length holds the best ranked key length; the full ranking is available through
+ *       get_key_length_candidates.
+ *
  */
-void DecryptEngine::split_ciphertext()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::search_key_length (const std::uint8_t* letters,
+                                                       std::size_t len)
 {
-    unsigned int i = 0, ct_length = ciphertext_info.get_string_length();
-    std::string temp_ct = get_ciphertext();
-
-    // Initialize vectors needed for split operation
-    for (i = 0; i < key_length; i++)
-    {
-        split_alphabet.push_back("");
-    }
-
-    // Generate sub-strings
-    for (i = 0; i < ct_length; i++)
-    {
-        split_alphabet[i % key_length] += temp_ct[i];
-    }
+    StageTimer timer (active_stats(), STAGE_KEY_LENGTH, len);
+    key_search.search (letters, len);
+    key_length = key_search.get_best_period();
 }
 
 /**
- * @fn DecryptEngine::analyze_ciphertext
+ * @fn BasicDecryptEngine::analyze_ciphertext
  * 
  * @brief Creates an analysis of the ciphertext stored in ciphertext_info.
  * 
@@ -146,17 +187,20 @@ void DecryptEngine::split_ciphertext()
  * @post Cryptographic information relating to the ciphertext is generated and stored.
  * 
  */
-void DecryptEngine::analyze_ciphertext()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::analyze_ciphertext()
 {
-    //ciphertext_info.rm_data_string_char (' ');
+    StageTimer timer (active_stats(), STAGE_ANALYZE,
+                      std::max ((std::uint64_t)ciphertext_info.get_string_length(),
+                                ciphertext_info.get_analyzed_length()));
+
     // Calling calculate_IC should call the needed functions to analyze char instances and frequency
     ciphertext_info.calculate_IC();
     calc_correlations();
-    calc_key_length();
 }
 
 /**
- * @fn DecryptEngine::decrypt_vigenere_cipher
+ * @fn BasicDecryptEngine::decrypt_vigenere_cipher
  * 
  * @brief Calls methods to treat each individual sub-alphabet of the Vigenere cipher as its own
  *        Caesar cipher.
@@ -168,91 +212,1236 @@ void DecryptEngine::analyze_ciphertext()
  * @post ct is decrypted and stored in plaintext using key.
  * 
  */
-void DecryptEngine::decrypt_vigenere_cipher (std::string ct, std::string key)
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::decrypt_vigenere_cipher (const std::string& ct,
+                                                          const std::string& key)
 {
-    plaintext = "";
-
-    unsigned int ct_size = ct.size(), k_size = key.size();
-    for (unsigned int i = 0; i < ct_size; i++)
-    {
-        plaintext += decrypt_caesar_cipher (ct[i], key[i % k_size]);
-    }
+    StageTimer timer (active_stats(), STAGE_DECRYPT, ct.size());
+    plaintext.resize (ct.size());
+    decrypt_vigenere_span (ct.data(), &plaintext[0], ct.size(), key.data(), key.size(), 0);
 }
 
 /**
- * @fn DecryptEngine::process_caesar
+ * @fn BasicDecryptEngine::process_caesar
  * 
- * @brief A wrapper for the analyze_ciphertext method.
+ * @brief A wrapper for the analyze_ciphertext method. With a sample margin set, only as much of
+ *        the ciphertext is counted as it takes for the best shift to stand out. With a result
+ *        cache set, a ciphertext cracked before is not analyzed again.
  * 
  */
-void DecryptEngine::process_caesar()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_caesar()
 {
+    // A file's bytes are counted without being stored, so only in-memory texts are cached
+    cache_hit = false;
+    if ((result_cache != nullptr) && (ciphertext_info.get_string_length() > 0))
+    {
+        StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+        const std::string& ct = ciphertext_info.get_string();
+
+        // Only the symbols of the alphabet decide the key, so they alone address the text
+        cache_symbols.resize (ct.size());
+        std::size_t symbols = 0;
+        for (std::size_t i = 0; i < ct.size(); i++)
+        {
+            unsigned int bin = Alphabet::TABLE.bins[(unsigned char)ct[i]];
+            cache_symbols[symbols] = (std::uint8_t)bin;
+            symbols += (bin < Alphabet::SIZE);
+        }
+
+        if (find_cached (cache_symbols.data(), symbols, CACHE_SEED_CAESAR) &&
+            !cache_entry.key.empty())
+        {
+            highest_correlation = key_shift (cache_entry.key[0]);
+            correlation_frequency[highest_correlation] = cache_entry.score;
+            key_score = cache_entry.score;
+            sampled_length = 0;
+            return;
+        }
+    }
+
+    // Sampling counts a prefix up front; calculate_IC then keeps those counts instead of the text
+    if ((sample_margin > 0.0) && (ciphertext_info.get_analyzed_length() == 0))
+    {
+        const std::string& ct = ciphertext_info.get_string();
+        sample_caesar (ct.data(), ct.size());
+    }
+
     analyze_ciphertext();
-    highest_correlation = std::distance (correlation_frequency,
-                          std::max_element (correlation_frequency, correlation_frequency + 25));
+    select_highest_correlation();
+    sampled_length = ciphertext_info.get_analyzed_length();
+    key_score = correlation_frequency[highest_correlation];
+
+    if ((result_cache != nullptr) && (ciphertext_info.get_string_length() > 0))
+    {
+        char key = most_likely_key();
+        store_cached (&key, 1);
+    }
 }
 
 /**
- * @fn DecryptEngine::process_vigenere
+ * @fn BasicDecryptEngine::process_vigenere
  *
- * @brief Wrapper function for all Vigenere cipher-related functions.
+ * @brief Wrapper function for all Vigenere cipher-related functions. The ciphertext is first
+ *        normalized into its letters in one pass; every later stage works on those, so case,
+ *        spacing and punctuation neither need stripping nor use up key positions.
  * 
+ *        With a sample margin set, the key is searched for on a growing prefix of the letters;
+ *        decryption still covers all of them. With a result cache set, the normalized letters
+ *        are looked up first, so a ciphertext seen before, even with other case, spacing or
+ *        punctuation, goes straight to decryption.
+ *
  * @pre Ciphertext has been set in ciphertext_info
- * @post The Vigenere cipher is decoded to a close approximation using formulae.
+ * @post The Vigenere cipher is decoded to a close approximation using formulae. plaintext holds
+ *       the letters of the decryption; restore_plaintext_layout puts the rest back.
  *  
  */
-void DecryptEngine::process_vigenere()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_vigenere()
+{
+    const std::string& ct = ciphertext_info.get_string();
+    solve_vigenere (ct.data(), ct.size());
+
+    // Sized by bytes rather than letters, so only a longer message than any before allocates
+    std::size_t len = ciphertext_letters.get_letter_count();
+    StageTimer timer (active_stats(), STAGE_DECRYPT, len);
+    plaintext.reserve (ct.size());
+    plaintext.resize (len);
+    ciphertext_letters.write_letters (&plaintext[0]);
+    decrypt_vigenere_span (plaintext.data(), &plaintext[0], len, calculated_key.data(),
+                           calculated_key.size(), 0);
+}
+
+/**
+ * @fn BasicDecryptEngine::solve_vigenere
+ *
+ * @param data: The ciphertext.
+ * @param size: Number of bytes in data.
+ *
+ * @brief The analysis half of process_vigenere: normalizes the ciphertext into its letters and
+ *        finds the key, from the result cache when it has the letters.
+ *
+ * @post calculated_key holds the estimated key; nothing is decrypted.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::solve_vigenere (const char* data, std::size_t size)
+{
+    // Normalizing is part of the analysis, so it adds time but not calls or bytes to that stage
+    {
+        StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+        ciphertext_letters.normalize (data, size);
+        cache_hit = find_cached (ciphertext_letters.get_letters(),
+                                 ciphertext_letters.get_letter_count(), CACHE_SEED_VIGENERE);
+        if (!cache_hit)
+            ciphertext_info.gen_letter_instance_profile (ciphertext_letters.get_letters(),
+                                                         ciphertext_letters.get_letter_count());
+    }
+
+    const std::uint8_t* letters = ciphertext_letters.get_letters();
+    std::size_t len = ciphertext_letters.get_letter_count();
+
+    // A text without letters has no key; the key length search has no columns to build
+    if (len == 0)
+    {
+        calculated_key.clear();
+        key_length = 0;
+        sampled_length = 0;
+        return;
+    }
+
+    reserve_key_scratch();
+    if (cache_hit)
+    {
+        calculated_key = cache_entry.key;
+        key_length = cache_entry.key_length;
+        key_score = cache_entry.score;
+        sampled_length = 0;
+    }
+    else
+    {
+        analyze_ciphertext();
+        sampled_length = len;
+        if (sample_margin > 0.0)
+            sampled_length = sample_vigenere (letters, len);
+        else
+        {
+            search_key_length (letters, len);
+            solve_columns (letters, len);
+        }
+        refine_key (letters, sampled_length);
+
+        const std::vector <KeyLengthCandidate>& periods = key_search.get_candidates();
+        key_score = periods.empty() ? 0.0 : periods[0].score;
+        store_cached (calculated_key.data(), calculated_key.size());
+    }
+}
+
+/**
+ * @fn BasicDecryptEngine::restore_plaintext_layout
+ *
+ * @brief Rebuilds the plaintext in the layout of the ciphertext: each letter takes the case of
+ *        the ciphertext letter it came from, and spaces, punctuation and every other byte go
+ *        back where they were.
+ *
+ * @pre process_vigenere has been called.
+ * @post plaintext is as long as the ciphertext.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::restore_plaintext_layout ()
+{
+    if (plaintext.size() != ciphertext_letters.get_letter_count())
+        return;
+
+    StageTimer timer (active_stats(), STAGE_DECRYPT, ciphertext_letters.get_text_size());
+    layout_plaintext.resize (ciphertext_letters.get_text_size());
+    ciphertext_letters.restore (plaintext.data(), &layout_plaintext[0]);
+    plaintext.swap (layout_plaintext);
+}
+
+/**
+ * @fn BasicDecryptEngine::sample_caesar
+ *
+ * @param data: The ciphertext.
+ * @param size: Number of bytes in data.
+ * @return Number of bytes counted, from the start of data.
+ *
+ * @brief Counts prefixes of the ciphertext, SAMPLE_FIRST_BYTES long and doubling, into
+ *        ciphertext_info until the best shift leads the second best by sample_margin. Each step
+ *        costs only the new bytes and one pass over the shifts, so the key of a huge text is
+ *        found at about the cost of the first few kilobytes.
+ *
+ * @post correlation_frequency describes the counted prefix.
+ *
+ */
+template <class Alphabet>
+std::size_t BasicDecryptEngine <Alphabet>::sample_caesar (const char* data, std::size_t size)
+{
+    StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+    std::size_t counted = 0, target = SAMPLE_FIRST_BYTES;
+
+    while (counted < size)
+    {
+        std::size_t end = std::min (target, size);
+        ciphertext_info.accumulate (data + counted, end - counted);
+        counted = end;
+        target *= 2;
+
+        calc_correlations();
+        if (runner_up_margin (correlation_frequency, Alphabet::SIZE) >= sample_margin)
+            break;
+    }
+    return counted;
+}
+
+/**
+ * @fn BasicDecryptEngine::sample_vigenere
+ *
+ * @param letters: The letters of the ciphertext, from LetterBuffer::normalize.
+ * @param len: Number of letters.
+ * @return Number of letters the key was found from, from the start of letters.
+ *
+ * @brief Searches for the key length and solves the columns on prefixes of the letters,
+ *        SAMPLE_FIRST_BYTES long and doubling, until vigenere_settled. Every step reads the
+ *        prefix again, which at most doubles the letters read in all.
+ *
+ * @post calculated_key and column_counts describe the returned prefix.
+ *
+ */
+template <class Alphabet>
+std::size_t BasicDecryptEngine <Alphabet>::sample_vigenere (const std::uint8_t* letters,
+                                                            std::size_t len)
+{
+    std::size_t used = 0, target = SAMPLE_FIRST_BYTES;
+    do
+    {
+        used = std::min (target, len);
+        target *= 2;
+        search_key_length (letters, used);
+        solve_columns (letters, used);
+    } while ((used < len) && !vigenere_settled());
+    return used;
+}
+
+/**
+ * @fn BasicDecryptEngine::vigenere_settled
+ *
+ * @return true if the key found from the sample is clear enough to stop sampling.
+ *
+ * @brief The sample settles once the best key length scores at least SAMPLE_MIN_PERIOD_SCORE
+ *        and leads every period that is not one of its multiples by sample_margin, and the best
+ *        shift of every column leads that column's second best by sample_margin.
+ *
+ * @pre search_key_length and solve_columns have been called on the sample.
+ *
+ */
+template <class Alphabet>
+bool BasicDecryptEngine <Alphabet>::vigenere_settled () const
+{
+    const std::vector <KeyLengthCandidate>& periods = key_search.get_candidates();
+    if (periods.empty() || (periods[0].score < SAMPLE_MIN_PERIOD_SCORE) ||
+        (key_search.get_period_margin() < sample_margin))
+        return false;
+
+    for (unsigned int c = 0; c < key_length; c++)
+    {
+        if (runner_up_margin (&column_correlations[c * 26], 26) < sample_margin)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @fn BasicDecryptEngine::runner_up_margin
+ *
+ * @param correlations: Correlation frequency of each shift.
+ * @param count: Number of shifts.
+ * @return How far the best correlation is ahead of the second best, as a fraction of the best;
+ *         0.0 if the best is not positive.
+ *
+ */
+template <class Alphabet>
+double BasicDecryptEngine <Alphabet>::runner_up_margin (const double* correlations,
+                                                        unsigned int count)
+{
+    double best = 0.0, second = 0.0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (correlations[i] > best)
+        {
+            second = best;
+            best = correlations[i];
+        }
+        else if (correlations[i] > second)
+            second = correlations[i];
+    }
+    return (best > 0.0) ? (best - second) / best : 0.0;
+}
+
+/**
+ * @fn BasicDecryptEngine::cache_seed
+ *
+ * @param mode_seed: CACHE_SEED_CAESAR or CACHE_SEED_VIGENERE.
+ * @return The seed of the engine's cache keys: mode_seed with every setting that decides the key
+ *         folded in. The disk tier outlives the process, so a later run with, say, another
+ *         language model must not find the results of this one.
+ *
+ */
+template <class Alphabet>
+std::uint64_t BasicDecryptEngine <Alphabet>::cache_seed (std::uint64_t mode_seed) const
+{
+    std::uint64_t seed = ResultCache::hash (Alphabet::TABLE.bins.data(),
+                                            sizeof (Alphabet::TABLE.bins), mode_seed).low;
+
+    double margin = sample_margin;
+    std::uint64_t settings[2] = { key_search.get_max_period(), 0 };
+    std::memcpy (&settings[1], &margin, sizeof (margin));
+    seed = ResultCache::hash (settings, sizeof (settings), seed).low;
+
+    // A model is told apart by its header, which holds its name and training size, and its
+    // letter frequencies; hashing its n-gram tables would page all of them in
+    if (language_model != nullptr)
+    {
+        const ModelHeader& header = language_model->get_header();
+        seed = ResultCache::hash (&header, sizeof (header), seed).low;
+        seed = ResultCache::hash (language_model->get_frequencies(),
+                                  LETTER_BINS * sizeof (double), seed).low;
+    }
+    return seed;
+}
+
+/**
+ * @fn BasicDecryptEngine::find_cached
+ *
+ * @param data: The ciphertext as the cipher mode sees it: its symbol numbers for a Caesar
+ *              cipher, its letters for a Vigenere cipher.
+ * @param len: Number of bytes in data.
+ * @param seed: CACHE_SEED_CAESAR or CACHE_SEED_VIGENERE.
+ * @return true if the result cache holds a result for the ciphertext.
+ *
+ * @post cache_key addresses the ciphertext; on a hit, cache_entry holds its result.
+ *
+ */
+template <class Alphabet>
+bool BasicDecryptEngine <Alphabet>::find_cached (const void* data, std::size_t len,
+                                                 std::uint64_t seed)
+{
+    cache_hit = false;
+    if (result_cache == nullptr)
+        return false;
+
+    cache_key = ResultCache::hash (data, len, cache_seed (seed));
+    cache_hit = result_cache->lookup (cache_key, cache_entry);
+    return cache_hit;
+}
+
+/**
+ * @fn BasicDecryptEngine::store_cached
+ *
+ * @param key: The key found.
+ * @param size: Length of the key.
+ *
+ * @brief Stores the result of the current message, with key_score, under cache_key.
+ *
+ * @pre find_cached has been called for the current message and missed.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::store_cached (const char* key, std::size_t size)
+{
+    if (result_cache == nullptr)
+        return;
+
+    cache_entry.key.assign (key, size);
+    cache_entry.key_length = (unsigned int)size;
+    cache_entry.IC = ciphertext_info.get_IC();
+    cache_entry.score = key_score;
+    result_cache->insert (cache_key, cache_entry);
+}
+
+/**
+ * @fn BasicDecryptEngine::solve_columns
+ *
+ * @param letters: The letters of the ciphertext, or nullptr if column_counts has already been
+ *                 filled.
+ * @param len: Number of letters.
+ *
+ * @brief Fills every column histogram in a single strided pass over the ciphertext, then finds
+ *        the most likely Caesar shift of each column. Columns are solved on the thread pool when
+ *        one is set and the key and the text are long enough to be worth it. Scratch storage is
+ *        reused, so no allocations are made once it has grown to the key length.
+ *
+ * @pre key_length has been calculated.
+ * @post calculated_key holds one key letter per column.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::solve_columns (const std::uint8_t* letters, std::size_t len)
+{
+    if (letters != nullptr)
+    {
+        StageTimer timer (active_stats(), STAGE_SPLIT, len);
+        column_counts.reset (key_length);
+        column_counts.count (letters, len);
+    }
+
+    StageTimer timer (active_stats(), STAGE_COLUMNS, 0, key_length);
+    if (column_correlations.size() < key_length * 26)
+        column_correlations.resize (key_length * 26);
+    calculated_key.assign (key_length, 'A');
+
+    const RotatedReference& reference = active_reference();
+    auto solve_column = [this, &reference] (std::size_t c) {
+        calculated_key[c] = 'A' + calc_column_correlations (column_counts.get_column (c),
+                                                            column_counts.get_column_total (c),
+                                                            &column_correlations[c * 26],
+                                                            reference);
+    };
+
+    // Columns counted elsewhere, as in file mode, come from a text of unknown length
+    bool long_text = (letters == nullptr) || (len >= PARALLEL_MIN_LETTERS);
+    if ((thread_pool != nullptr) && (key_length >= PARALLEL_COLUMN_THRESHOLD) && long_text)
+        thread_pool->parallel_for (key_length, solve_column);
+    else
+    {
+        for (unsigned int c = 0; c < key_length; c++)
+            solve_column (c);
+    }
+}
+
+/**
+ * @fn BasicDecryptEngine::reserve_key_scratch
+ *
+ * @brief Sizes the key, the column histograms and the scratch space of solve_columns and
+ *        refine_key for the longest key length the search ranks, and loads the quadgram scorer.
+ *        Storage sized by the key length would otherwise grow on every message with a longer key
+ *        than any before, however long the engine had been reused; this way only a longer
+ *        message than any before allocates.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::reserve_key_scratch ()
+{
+    std::size_t period = key_search.get_max_period();
+    if (column_correlations.size() >= period * 26)
+        return;
+
+    std::size_t sample = period * REFINE_SAMPLE_COLUMN_LETTERS;
+    calculated_key.reserve (period);
+    column_counts.reserve (period);
+    column_correlations.resize (period * 26);
+    refine_cipher.reserve (sample);
+    refine_plain.reserve (sample);
+    refine_columns.reserve (sample);
+    refine_order.reserve (sample);
+    refine_offsets.reserve (period + 1);
+    refine_fill.reserve (period);
+    refine_candidates.reserve (period * REFINE_CANDIDATE_SHIFTS);
+    refine_dirty.reserve (period);
+    refine_windows.reserve (NGRAM_WINDOW * REFINE_SAMPLE_COLUMN_LETTERS);
+
+    // The built-in English scorer is trained on first use, which would land on some later message
+    active_scorer();
+}
+
+/**
+ * @fn BasicDecryptEngine::refine_key
+ *
+ * @param letters: The letters of the ciphertext calculated_key was solved from.
+ * @param len: Number of letters.
+ *
+ * @brief Improves a key found column by column by hill-climbing on quadgram fitness: each key
+ *        letter in turn is set to whichever of its most likely shifts makes the plaintext most
+ *        English, and passes repeat until the key stops changing. Only the quadgram windows
+ *        touching the column being changed are rescored, so a trial shift costs O(len / key
+ *        length). Skipped when every column is long enough for the correlation to be trusted.
+ *
+ * @pre solve_columns has been called on letters.
+ * @post calculated_key is at least as fit as before.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::refine_key (const std::uint8_t* letters, std::size_t len)
+{
+    unsigned int period = calculated_key.size();
+    if (period == 0)
+        return;
+
+    bool short_column = false;
+    for (unsigned int c = 0; (c < period) && !short_column; c++)
+        short_column = (column_counts.get_column_total (c) < REFINE_MAX_COLUMN_LETTERS);
+    if (!short_column)
+        return;
+
+    StageTimer timer (active_stats(), STAGE_REFINE, len);
+    const float* quadgrams = active_scorer().get_quadgrams();
+
+    // Sample the letters and the key position each one was enciphered with
+    std::size_t sample = std::min (len, (std::size_t)period * REFINE_SAMPLE_COLUMN_LETTERS);
+    refine_cipher.assign (letters, letters + sample);
+    refine_columns.resize (sample);
+    refine_windows.reserve (NGRAM_WINDOW * REFINE_SAMPLE_COLUMN_LETTERS);
+    refine_offsets.assign (period + 1, 0);
+    unsigned int column = 0;
+    for (std::size_t i = 0; i < sample; i++)
+    {
+        refine_columns[i] = column;
+        refine_offsets[column + 1]++;
+        if (++column == period)
+            column = 0;
+    }
+
+    unsigned int n = refine_cipher.size();
+    if (n < NGRAM_WINDOW)
+        return;
+
+    // Group the sampled letters by column, keeping text order within each column
+    for (unsigned int c = 0; c < period; c++)
+        refine_offsets[c + 1] += refine_offsets[c];
+    refine_fill.assign (refine_offsets.begin(), refine_offsets.end() - 1);
+    refine_order.resize (n);
+    refine_plain.resize (n);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        unsigned int c = refine_columns[i];
+        refine_order[refine_fill[c]++] = i;
+        refine_plain[i] = (refine_cipher[i] + LETTER_BINS - (calculated_key[c] - 'A'))
+                          % LETTER_BINS;
+    }
+
+    // Only the shifts a column's letter counts already favour are worth trying
+    refine_candidates.resize (period * REFINE_CANDIDATE_SHIFTS);
+    for (unsigned int c = 0; c < period; c++)
+    {
+        const double* correlations = &column_correlations[c * 26];
+        unsigned int order[26];
+        for (unsigned int i = 0; i < 26; i++)
+            order[i] = i;
+        std::partial_sort (order, order + REFINE_CANDIDATE_SHIFTS, order + 26,
+                           [correlations] (unsigned int a, unsigned int b) {
+            return (correlations[a] > correlations[b]) ||
+                   ((correlations[a] == correlations[b]) && (a < b));
+        });
+        std::copy (order, order + REFINE_CANDIDATE_SHIFTS,
+                   &refine_candidates[c * REFINE_CANDIDATE_SHIFTS]);
+    }
+
+    /*
+     * A window holding one letter of the column scores as quadgrams[base + letter * weight],
+     * with the other three letters folded into base once per visit; windows holding several
+     * letters of the column (keys shorter than a window) are packed in full instead
+     */
+    auto score_windows = [&] () {
+        float total = 0.0f;
+        for (const RefineWindow& w : refine_windows)
+        {
+            if (w.weight != 0)
+                total += quadgrams[w.base + refine_plain[w.index] * w.weight];
+            else
+                total += quadgrams[NgramScorer::pack_quadgram (&refine_plain[w.index])];
+        }
+        return total;
+    };
+
+    /*
+     * A column's best shift only depends on the columns that share windows with it, so after
+     * the first pass a column is revisited only when one of its neighbours has changed
+     */
+    refine_dirty.assign (period, 1);
+    for (unsigned int sweep = 0; sweep < REFINE_MAX_SWEEPS; sweep++)
+    {
+        bool changed = false;
+        for (unsigned int c = 0; c < period; c++)
+        {
+            const unsigned int* first = refine_order.data() + refine_offsets[c];
+            const unsigned int* last = refine_order.data() + refine_offsets[c + 1];
+            if ((!refine_dirty[c]) || (first == last))
+                continue;
+            refine_dirty[c] = 0;
+
+            // Windows holding at least one letter of this column, each listed once
+            refine_windows.clear();
+            unsigned int next_window = 0;
+            for (const unsigned int* i = first; i != last; i++)
+            {
+                unsigned int w = (*i >= NGRAM_WINDOW - 1) ? *i - (NGRAM_WINDOW - 1) : 0;
+                unsigned int end = std::min (*i, n - NGRAM_WINDOW);
+                for (w = std::max (w, next_window); w <= end; w++)
+                {
+                    if ((i + 1 != last) && (*(i + 1) < w + NGRAM_WINDOW))
+                        refine_windows.push_back (RefineWindow { 0, 0, w });
+                    else
+                    {
+                        unsigned int weight = 1;
+                        for (unsigned int p = *i - w; p < NGRAM_WINDOW - 1; p++)
+                            weight *= LETTER_BINS;
+                        unsigned int base = NgramScorer::pack_quadgram (&refine_plain[w])
+                                            - refine_plain[*i] * weight;
+                        refine_windows.push_back (RefineWindow { base, weight, *i });
+                    }
+                }
+                next_window = std::max (next_window, end + 1);
+            }
+
+            unsigned int current = calculated_key[c] - 'A', best = current;
+            float best_score = score_windows();
+            for (unsigned int k = 0; k < REFINE_CANDIDATE_SHIFTS; k++)
+            {
+                unsigned int shift = refine_candidates[c * REFINE_CANDIDATE_SHIFTS + k];
+                if (shift == current)
+                    continue;
+                for (const unsigned int* i = first; i != last; i++)
+                    refine_plain[*i] = (refine_cipher[*i] + LETTER_BINS - shift) % LETTER_BINS;
+
+                float trial_score = score_windows();
+                if (trial_score > best_score)
+                {
+                    best_score = trial_score;
+                    best = shift;
+                }
+            }
+
+            for (const unsigned int* i = first; i != last; i++)
+                refine_plain[*i] = (refine_cipher[*i] + LETTER_BINS - best) % LETTER_BINS;
+            if (best != current)
+            {
+                calculated_key[c] = 'A' + best;
+                changed = true;
+                for (unsigned int d = 1; d < NGRAM_WINDOW; d++)
+                {
+                    refine_dirty[(c + d) % period] = 1;
+                    refine_dirty[(c + period - d % period) % period] = 1;
+                }
+            }
+        }
+
+        if (!changed)
+            break;
+    }
+}
+
+/**
+ * @fn BasicDecryptEngine::enumerate_keys
+ *
+ * @param count: Number of keys wanted.
+ * @param rescore: Number of the best keys to rescore by the quadgram fitness of their
+ *                 decryption; 0 to keep the list in correlation order.
+ *
+ * @brief Lists the count most likely keys by the sum of their columns' correlations, as
+ *        fallbacks for when calculated_key is wrong. Only the correlations are searched, so
+ *        thousands of keys take milliseconds. Rescoring decrypts the letters the engine holds:
+ *        the whole ciphertext after process_vigenere, the first chunk of the file after
+ *        process_vigenere_file.
+ *
+ * @pre solve_columns has been called, e.g. through process_vigenere.
+ * @post get_key_candidates holds the keys, best first; calculated_key is unchanged.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::enumerate_keys (unsigned int count, unsigned int rescore)
+{
+    std::size_t len = ciphertext_letters.get_letter_count();
+    StageTimer timer (active_stats(), STAGE_REFINE, (std::uint64_t)rescore * len);
+    key_enumerator.enumerate (column_correlations.data(), key_length, count);
+    key_enumerator.rescore (ciphertext_letters.get_letters(), len, active_scorer(), rescore);
+}
+
+/**
+ * @fn BasicDecryptEngine::append_ciphertext
+ *
+ * @param buf: Next chunk of a ciphertext that arrives over time, e.g. a tailed log.
+ * @param len: Number of bytes in buf.
+ *
+ * @brief Adds a chunk to the stored ciphertext and updates the IC, correlations and most likely
+ *        Caesar key from the running counts, so the work done is O(len) and never a rescan of
+ *        the text seen so far. clear_ciphertext starts a new text.
+ *
+ * @post get_IC and most_likely_key describe the whole ciphertext appended so far.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::append_ciphertext (const char* buf, std::size_t len)
+{
+    stats.set_message_size (stats.get_message_size() + len);
+    StageTimer timer (active_stats(), STAGE_ANALYZE, len);
+    ciphertext_info.append (buf, len);
+    calc_correlations();
+    select_highest_correlation();
+}
+
+/**
+ * @fn BasicDecryptEngine::detect_caesar_language
+ *
+ * @param scorer: The candidate plaintext languages.
+ *
+ * @brief Scores every shift of the ciphertext histogram against every candidate language at
+ *        once and keeps the most likely (language, key) pair, instead of running process_caesar
+ *        once per language. The ranking of every language is kept in get_language_scores.
+ *
+ * @pre analyze_ciphertext has been called, e.g. through process_caesar.
+ * @post most_likely_key is the key of the most likely language.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::detect_caesar_language (const MultiModelScorer& scorer)
+{
+    StageTimer timer (active_stats(), STAGE_COLUMNS, 0);
+    scorer.rank (ciphertext_info.get_histogram().get_letter_counts().data(), language_scores,
+                 language_matrix);
+    if (!language_scores.empty())
+        highest_correlation = language_scores[0].key[0] - 'A';
+}
+
+/**
+ * @fn BasicDecryptEngine::detect_vigenere_language
+ *
+ * @param scorer: The candidate plaintext languages.
+ *
+ * @brief Scores every shift of every column against every candidate language at once. Each
+ *        language gets its best key and the likelihood of the text decrypted with it, and the
+ *        most likely language's key replaces calculated_key. The work grows with the key length
+ *        and the number of languages, not with the length of the text.
+ *
+ * @pre solve_columns has been called.
+ * @post calculated_key is the key of the most likely language; the ranking of every language is
+ *       kept in get_language_scores.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::detect_vigenere_language (const MultiModelScorer& scorer)
+{
+    StageTimer timer (active_stats(), STAGE_COLUMNS, 0, key_length);
+    std::size_t models = scorer.get_model_count();
+    language_matrix.resize (models * SHIFT_LANES);
+    language_scores.resize (models);
+    for (std::size_t m = 0; m < models; m++)
+    {
+        language_scores[m].model = (unsigned int)m;
+        language_scores[m].key.assign (key_length, 'A');
+        language_scores[m].score = 0.0;
+    }
+
+    std::uint64_t letters = 0;
+    for (unsigned int c = 0; c < key_length; c++)
+    {
+        scorer.score (column_counts.get_column (c), language_matrix.data());
+        letters += column_counts.get_column_total (c);
+
+        for (std::size_t m = 0; m < models; m++)
+        {
+            const double* row = &language_matrix[m * SHIFT_LANES];
+            unsigned int best = (unsigned int)(std::max_element (row, row + 26) - row);
+            language_scores[m].key[c] = 'A' + best;
+            language_scores[m].score += row[best];
+        }
+    }
+
+    for (LanguageScore& result : language_scores)
+        result.score /= (letters > 0) ? (double)letters : 1.0;
+    MultiModelScorer::sort_scores (language_scores);
+
+    if (!language_scores.empty())
+        calculated_key = language_scores[0].key;
+}
+
+
+// === Buffer Methods =============================================================================
+
+/**
+ * @fn BasicDecryptEngine::process_caesar_buffer
+ *
+ * @param data: The ciphertext, owned by the caller.
+ * @param size: Number of bytes in data.
+ *
+ * @brief Finds the most likely Caesar key of a ciphertext the engine only borrows, e.g. through
+ *        the C API. Its bytes are counted where they are, as process_caesar_file counts a mapped
+ *        file, so nothing is copied; sampling applies as it does there.
+ *
+ * @post highest_correlation holds the most likely key; data is not retained.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_caesar_buffer (const char* data, std::size_t size)
+{
+    reset();
+    stats.set_message_size (size);
+    if (sample_margin > 0.0)
+        sample_caesar (data, size);
+    else
+    {
+        StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+        ciphertext_info.accumulate (data, size);
+    }
+    process_caesar();
+}
+
+/**
+ * @fn BasicDecryptEngine::decrypt_caesar_buffer
+ *
+ * @param data: The ciphertext.
+ * @param size: Number of bytes in data.
+ * @param out: Receives size bytes of plaintext; may be data itself.
+ *
+ * @pre process_caesar_buffer, or any other Caesar analysis, has been called.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::decrypt_caesar_buffer (const char* data, std::size_t size,
+                                                           char* out) const
+{
+    Alphabet::decrypt (data, out, size, highest_correlation);
+}
+
+/**
+ * @fn BasicDecryptEngine::process_vigenere_buffer
+ *
+ * @param data: The ciphertext, owned by the caller.
+ * @param size: Number of bytes in data.
+ *
+ * @brief Finds the Vigenere key of a ciphertext the engine only borrows. The ciphertext is read
+ *        once, straight into its letter indices; it is never copied as text.
+ *
+ * @post calculated_key holds the estimated key; decrypt_vigenere_buffer writes the plaintext.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_vigenere_buffer (const char* data, std::size_t size)
+{
+    reset();
+    stats.set_message_size (size);
+    solve_vigenere (data, size);
+}
+
+/**
+ * @fn BasicDecryptEngine::decrypt_vigenere_buffer
+ *
+ * @param out: Receives get_letter_count upper case letters, or with keep_layout, get_text_size
+ *             bytes in the layout of the ciphertext.
+ * @param keep_layout: Write the case, spacing and punctuation of the ciphertext as well.
+ * @return Number of bytes written.
+ *
+ * @brief Decrypts the letters of the last buffer straight into the caller's memory. With
+ *        keep_layout the letters are decrypted into the end of out and spread out from there;
+ *        LetterBuffer::restore writes front to back and never gets ahead of the letters it has
+ *        still to read, so no scratch copy is needed.
+ *
+ * @pre process_vigenere_buffer has been called.
+ *
+ */
+template <class Alphabet>
+std::size_t BasicDecryptEngine <Alphabet>::decrypt_vigenere_buffer (char* out,
+                                                                    bool keep_layout) const
+{
+    std::size_t letter_count = ciphertext_letters.get_letter_count();
+    std::size_t text_size = ciphertext_letters.get_text_size();
+    char* letters = keep_layout ? out + (text_size - letter_count) : out;
+
+    ciphertext_letters.write_letters (letters);
+    if (!calculated_key.empty())
+        decrypt_vigenere_span (letters, letters, letter_count, calculated_key.data(),
+                               calculated_key.size(), 0);
+    if (!keep_layout)
+        return letter_count;
+
+    ciphertext_letters.restore (letters, out);
+    return text_size;
+}
+
+
+// === File Input Methods =========================================================================
+
+/**
+ * @fn BasicDecryptEngine::open_ciphertext_file
+ *
+ * @param path: Path of the file holding the ciphertext.
+ * @return true if the file could be opened, false otherwise.
+ *
+ * @brief Memory-maps a ciphertext file so it can be analyzed and decrypted in fixed-size chunks
+ *        without ever being held as a std::string.
+ *
+ */
+template <class Alphabet>
+bool BasicDecryptEngine <Alphabet>::open_ciphertext_file (const std::string& path)
+{
+    ciphertext_info = BasicStringAnalysis <Alphabet>();
+    calculated_key = "";
+    key_length = 0;
+    if (!ciphertext_file.open (path))
+        return false;
+
+    stats.set_message_size (ciphertext_file.get_size());
+    return true;
+}
+
+/**
+ * @fn BasicDecryptEngine::process_caesar_file
+ *
+ * @brief Counts the mapped ciphertext chunk by chunk and finds the most likely Caesar key. With
+ *        a sample margin set, counting stops as soon as the key is clear, so the time to the
+ *        key of a huge file does not grow with its size.
+ *
+ * @pre open_ciphertext_file has succeeded.
+ * @post highest_correlation holds the most likely key; the file is not otherwise retained.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_caesar_file ()
+{
+    const char* data = ciphertext_file.get_data();
+    std::size_t file_size = ciphertext_file.get_size();
+
+    if (sample_margin > 0.0)
+        ciphertext_file.release (0, sample_caesar (data, file_size));
+
+    // Counting is part of the analysis, so it adds time but not calls or bytes to that stage
+    else
+    {
+        StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+        for (std::size_t offset = 0; offset < file_size; offset += FILE_CHUNK_SIZE)
+        {
+            std::size_t len = std::min (FILE_CHUNK_SIZE, file_size - offset);
+            ciphertext_info.accumulate (data + offset, len);
+            ciphertext_file.release (offset, len);
+        }
+    }
+
+    process_caesar();
+}
+
+/**
+ * @fn BasicDecryptEngine::process_vigenere_file
+ *
+ * @brief Recovers a Vigenere key from the mapped ciphertext using two chunked passes: one to
+ *        rank the key lengths and one to build the per-column counts. Each chunk is normalized
+ *        into its letters, upper or lower case, and everything else in the file is skipped. With a
+ *        sample margin set, sample_vigenere_file is tried first, and the passes only run if the
+ *        key is still unclear after SAMPLE_MAX_LETTERS letters.
+ *
+ * @pre open_ciphertext_file has succeeded.
+ * @post calculated_key holds the estimated key.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::process_vigenere_file ()
 {
-    ciphertext_info.rm_data_string_char (' ');
+    const char* data = ciphertext_file.get_data();
+    std::size_t file_size = ciphertext_file.get_size();
+    std::size_t offset = 0, len = 0;
+
+    if ((sample_margin > 0.0) && sample_vigenere_file())
+        return;
+
+    // First pass: letter counts of the whole file give the IC and the key length ranking
+    {
+        StageTimer timer (active_stats(), STAGE_KEY_LENGTH, file_size);
+        key_search.reset();
+        for (offset = 0; offset < file_size; offset += FILE_CHUNK_SIZE)
+        {
+            len = std::min (FILE_CHUNK_SIZE, file_size - offset);
+            ciphertext_letters.normalize (data + offset, len);
+            ciphertext_info.accumulate_letters (ciphertext_letters.get_letters(),
+                                                ciphertext_letters.get_letter_count());
+            key_search.count (ciphertext_letters.get_letters(),
+                              ciphertext_letters.get_letter_count());
+            ciphertext_file.release (offset, len);
+        }
+    }
+
     analyze_ciphertext();
-    split_ciphertext();
+    key_search.rank();
+    key_length = key_search.get_best_period();
+    sampled_length = ciphertext_info.get_analyzed_length();
 
-    // TODO: Don't do this... Re-instantiating a class every loop iteration is stupid, but currently
-    //       there is no member method that changes the needed aspects for changing the ciphertext.
-    unsigned int i = 0;
-    for (i = 0; i < key_length; i++)
+    // Second pass: count each column of the ciphertext separately
     {
-        DecryptEngine temp_dc (split_alphabet[i]);
-        temp_dc.process_caesar();
-        calculated_key += temp_dc.most_likely_key();
+        StageTimer timer (active_stats(), STAGE_SPLIT, file_size);
+        column_counts.reset (key_length);
+        for (offset = 0; offset < file_size; offset += FILE_CHUNK_SIZE)
+        {
+            len = std::min (FILE_CHUNK_SIZE, file_size - offset);
+            ciphertext_letters.normalize (data + offset, len);
+            column_counts.count (ciphertext_letters.get_letters(),
+                                 ciphertext_letters.get_letter_count());
+            ciphertext_file.release (offset, len);
+        }
     }
 
-    decrypt_vigenere_cipher (ciphertext_info.get_string(), calculated_key);
+    // Leave the first chunk normalized, so enumerated keys can be rescored against it
+    if (file_size > FILE_CHUNK_SIZE)
+        ciphertext_letters.normalize (data, FILE_CHUNK_SIZE);
+
+    solve_columns (nullptr, 0);
 }
 
+/**
+ * @fn BasicDecryptEngine::sample_vigenere_file
+ *
+ * @return true if the key was found from a sample, false if the file has to be read in full.
+ *
+ * @brief Normalizes the mapped ciphertext into sample_letters until it holds SAMPLE_FIRST_BYTES
+ *        letters, then twice as many each step, and searches for the key on every sample as
+ *        sample_vigenere does. Stops when vigenere_settled or the file is used up; gives up
+ *        once the sample would pass SAMPLE_MAX_LETTERS.
+ *
+ * @pre open_ciphertext_file has succeeded.
+ * @post On success, as after the two passes of process_vigenere_file, with the IC taken from
+ *       the sample.
+ *
+ */
+template <class Alphabet>
+bool BasicDecryptEngine <Alphabet>::sample_vigenere_file ()
+{
+    const char* data = ciphertext_file.get_data();
+    std::size_t file_size = ciphertext_file.get_size();
+    std::size_t offset = 0, target = SAMPLE_FIRST_BYTES;
+    bool settled = false;
+
+    sample_letters.clear();
+    while (!settled && (offset < file_size))
+    {
+        if (target > SAMPLE_MAX_LETTERS)
+        {
+            std::vector <std::uint8_t>().swap (sample_letters);
+            return false;
+        }
+
+        // A byte holds at most one letter, so no read overshoots the target
+        {
+            StageTimer timer (active_stats(), STAGE_ANALYZE, 0, 0);
+            while ((sample_letters.size() < target) && (offset < file_size))
+            {
+                std::size_t len = std::min ({ FILE_CHUNK_SIZE, file_size - offset,
+                                              target - sample_letters.size() });
+                ciphertext_letters.normalize (data + offset, len);
+                const std::uint8_t* letters = ciphertext_letters.get_letters();
+                sample_letters.insert (sample_letters.end(), letters,
+                                       letters + ciphertext_letters.get_letter_count());
+                ciphertext_file.release (offset, len);
+                offset += len;
+            }
+        }
+        target *= 2;
+
+        search_key_length (sample_letters.data(), sample_letters.size());
+        solve_columns (sample_letters.data(), sample_letters.size());
+        settled = vigenere_settled();
+    }
+
+    ciphertext_info.accumulate_letters (sample_letters.data(), sample_letters.size());
+    analyze_ciphertext();
+    sampled_length = sample_letters.size();
+
+    // Leave the first chunk normalized, so enumerated keys can be rescored against it
+    ciphertext_letters.normalize (data, std::min (FILE_CHUNK_SIZE, file_size));
+    return true;
+}
+
+/**
+ * @fn BasicDecryptEngine::stream_caesar_plaintext
+ *
+ * @param out: Stream the plaintext is written to.
+ *
+ * @brief Decrypts the mapped ciphertext one chunk at a time using the most likely Caesar key.
+ *        Bytes outside the alphabet are written unchanged.
+ *
+ * @pre process_caesar_file has been called.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::stream_caesar_plaintext (std::ostream& out)
+{
+    const char* data = ciphertext_file.get_data();
+    std::size_t file_size = ciphertext_file.get_size();
+    std::vector <char> chunk (FILE_CHUNK_SIZE);
+    StageTimer timer (active_stats(), STAGE_DECRYPT, file_size);
+
+    for (std::size_t offset = 0; offset < file_size; offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = std::min (FILE_CHUNK_SIZE, file_size - offset);
+        Alphabet::decrypt (data + offset, chunk.data(), len, highest_correlation);
+        out.write (chunk.data(), len);
+        ciphertext_file.release (offset, len);
+    }
+}
+
+/**
+ * @fn BasicDecryptEngine::stream_vigenere_plaintext
+ *
+ * @param out: Stream the plaintext is written to.
+ * @param keep_layout: Write the plaintext in the layout of the ciphertext, as
+ *                     restore_plaintext_layout does, instead of only its letters.
+ *
+ * @brief Decrypts the letters of the mapped ciphertext one chunk at a time using calculated_key.
+ *        As with process_vigenere, only the letters are written out unless keep_layout is set.
+ *
+ * @pre process_vigenere_file has been called.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::stream_vigenere_plaintext (std::ostream& out,
+                                                               bool keep_layout)
+{
+    const char* data = ciphertext_file.get_data();
+    std::size_t file_size = ciphertext_file.get_size();
+    std::vector <char> letters (FILE_CHUNK_SIZE);
+    std::vector <char> layout (keep_layout ? FILE_CHUNK_SIZE : 0);
+    unsigned int k_size = calculated_key.size(), key_index = 0;
+
+    if (k_size == 0)
+        return;
+
+    StageTimer timer (active_stats(), STAGE_DECRYPT, file_size);
+
+    for (std::size_t offset = 0; offset < file_size; offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = std::min (FILE_CHUNK_SIZE, file_size - offset);
+        ciphertext_letters.normalize (data + offset, len);
+        std::size_t letter_count = ciphertext_letters.get_letter_count();
+        ciphertext_letters.write_letters (letters.data());
+
+        // The key position carries over from one chunk to the next
+        decrypt_vigenere_span (letters.data(), letters.data(), letter_count,
+                               calculated_key.data(), k_size, key_index);
+        key_index = (unsigned int)((key_index + letter_count) % k_size);
+
+        if (keep_layout)
+        {
+            ciphertext_letters.restore (letters.data(), layout.data());
+            out.write (layout.data(), len);
+        }
+        else
+            out.write (letters.data(), letter_count);
+        ciphertext_file.release (offset, len);
+    }
+}
+
+/**
+ * @fn BasicDecryptEngine::select_highest_correlation
+ *
+ * @brief Picks the shift with the highest correlation frequency as the most likely key.
+ *
+ * @pre calc_correlations has been called.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::select_highest_correlation()
+{
+    highest_correlation = std::distance (correlation_frequency,
+                          std::max_element (correlation_frequency,
+                                            correlation_frequency + Alphabet::SIZE));
+}
+
+/**
+ * @fn BasicDecryptEngine::rank_shifts
+ *
+ * @param correlations: Correlation frequency of each of the Alphabet::SIZE shifts.
+ * @param order: Array of Alphabet::SIZE receiving the shifts, from highest to lowest
+ *               correlation frequency.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::rank_shifts (const double* correlations, unsigned int* order)
+{
+    for (unsigned int i = 0; i < Alphabet::SIZE; i++)
+        order[i] = i;
+
+    std::stable_sort (order, order + Alphabet::SIZE,
+                      [correlations] (unsigned int a, unsigned int b) {
+        return correlations[a] > correlations[b];
+    });
+}
 
 // === Output Functions ===========================================================================
 
 /**
- * @fn DecryptEngine::print_correlations
+ * @fn BasicDecryptEngine::print_correlations
  * 
  * @brief Prints the character of the alphabet followed by it's correlation frequency
  */
-void DecryptEngine::print_correlations()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::print_correlations()
 {
-    for (unsigned int i = 0; i < 26; i++)
+    for (unsigned int i = 0; i < Alphabet::SIZE; i++)
     {
-        std::cout << (char)(i + 'A') << ": " << correlation_frequency[i] << '\n';
+        std::cout << (char)Alphabet::TABLE.symbols[i] << ": " << correlation_frequency[i] << '\n';
     }
 }
 
 /**
- * @fn DecryptEngine::print_deciphered_caesars
+ * @fn BasicDecryptEngine::print_deciphered_caesars
  * 
+ * @param top_k: Number of shifts to print. With all of them, they are printed in alphabet order;
+ *               with fewer, only the best top_k are decrypted and printed, best first.
+ *
  * @brief Prints all possible deciphered Caesar ciphers, along with their key and corresponding
  *        correlation frequency.
  * 
+ * @pre process_caesar has been called.
+ *
  */
-void DecryptEngine::print_deciphered_caesars()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::print_deciphered_caesars (unsigned int top_k)
 {
     std::cout << std::fixed;
     std::cout.precision(4);
 
-    unsigned int i = 0;
-    for (i = 0; i < 26; i++)
+    unsigned int order[Alphabet::SIZE];
+    if (top_k >= Alphabet::SIZE)
     {
-        decrypt_caesar_cipher((char)(i + 'A'));
-        std::cout << (char)(i + 'A') << ", "  << correlation_frequency[i] << ": " << plaintext;
+        top_k = Alphabet::SIZE;
+        for (unsigned int i = 0; i < Alphabet::SIZE; i++)
+            order[i] = i;
+    }
+    else
+        rank_shifts (correlation_frequency, order);
+
+    for (unsigned int r = 0; r < top_k; r++)
+    {
+        unsigned int i = order[r];
+        char key = (char)Alphabet::TABLE.symbols[i];
+        decrypt_caesar_cipher (key);
+        std::cout << key << ", "  << correlation_frequency[i] << ": " << plaintext;
         if (i == highest_correlation)
             std::cout << '*';
         std::cout << std::endl;
@@ -260,29 +1449,109 @@ void DecryptEngine::print_deciphered_caesars()
 }
 
 /**
- * @fn DecryptEngine::print_decrypted_high_corr
+ * @fn BasicDecryptEngine::print_decrypted_high_corr
  * 
  * @brief Prints the plaintext generated by the highest correlation value in the alphabet.
  * 
  */
-void DecryptEngine::print_decrypted_high_corr()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::print_decrypted_high_corr()
 {
     std::cout << std::fixed;
     std::cout.precision(4);
 
-    decrypt_caesar_cipher((char)(highest_correlation + 'A'));
-    std::cout << "Key: " << (char)(highest_correlation + 'A') << "(" << highest_correlation << ")\n";
+    decrypt_caesar_cipher (most_likely_key());
+    std::cout << "Key: " << most_likely_key() << "(" << highest_correlation << ")\n";
     std::cout << plaintext << '\n' << std::endl;
 }
 
 /**
- * @fn DecryptEngine::print_vigenere_info
+ * @fn BasicDecryptEngine::print_vigenere_info
  * 
  * @brief Prints information regarding the decoded Vigenere cipher to terminal. 
  * 
  */
-void DecryptEngine::print_vigenere_info()
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::print_vigenere_info()
 {
     std::cout << "Key: " << calculated_key << '\n';
     std::cout << plaintext << '\n' << std::endl;
 }
+
+
+// === Mutators ===================================================================================
+
+/**
+ * @fn BasicDecryptEngine::reset
+ *
+ * @brief Forgets the current message so the engine can crack another. Buffers are emptied
+ *        rather than freed, so an engine reused for many messages stops allocating once it has
+ *        grown to the longest of them. The thread pool, language model, maximum key length and
+ *        instrumentation settings are kept.
+ *
+ * @post get_message_allocations counts from zero.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::reset ()
+{
+    ciphertext_info.reset();
+    ciphertext_letters.clear();
+    for (unsigned int i = 0; i < Alphabet::SIZE; i++)
+        correlation_frequency[i] = 0.0;
+    highest_correlation = 0;
+    plaintext.clear();
+    key_length = 0;
+    sampled_length = 0;
+    cache_hit = false;
+    key_score = 0.0;
+    calculated_key.clear();
+    language_scores.clear();
+    stats.set_message_size (0);
+    message_allocation_mark = get_thread_allocations();
+}
+
+/**
+ * @fn BasicDecryptEngine::set_language_model
+ *
+ * @param model: Model of the plaintext language, or nullptr for the built-in English tables.
+ *
+ * @brief Scores shifts, key lengths and refined keys against another language. The model's
+ *        tables are used in place, so it must stay open while the engine uses it.
+ *
+ */
+template <class Alphabet>
+void BasicDecryptEngine <Alphabet>::set_language_model (const LanguageModel* model)
+{
+    language_model = model;
+    key_search.set_expected_IC ((model != nullptr) ? model->get_expected_IC() : ENGLISH_IC);
+}
+
+
+// === Instantiations =============================================================================
+
+template class BasicDecryptEngine <UpperLatinAlphabet>;
+
+// Other alphabets get the Caesar half of the engine; the Vigenere half works on A-Z only
+#define INSTANTIATE_CAESAR_ENGINE(Alphabet)                                                       \
+    template void BasicDecryptEngine <Alphabet>::calc_correlations ();                            \
+    template void BasicDecryptEngine <Alphabet>::decrypt_caesar_cipher (char);                    \
+    template char BasicDecryptEngine <Alphabet>::decrypt_caesar_cipher (char, char);              \
+    template void BasicDecryptEngine <Alphabet>::calc_key_length ();                              \
+    template void BasicDecryptEngine <Alphabet>::analyze_ciphertext ();                           \
+    template void BasicDecryptEngine <Alphabet>::process_caesar ();                               \
+    template void BasicDecryptEngine <Alphabet>::append_ciphertext (const char*, std::size_t);    \
+    template bool BasicDecryptEngine <Alphabet>::open_ciphertext_file (const std::string&);       \
+    template void BasicDecryptEngine <Alphabet>::process_caesar_file ();                          \
+    template void BasicDecryptEngine <Alphabet>::process_caesar_buffer (const char*,              \
+                                                                        std::size_t);             \
+    template void BasicDecryptEngine <Alphabet>::decrypt_caesar_buffer (const char*, std::size_t, \
+                                                                        char*) const;             \
+    template void BasicDecryptEngine <Alphabet>::stream_caesar_plaintext (std::ostream&);         \
+    template void BasicDecryptEngine <Alphabet>::print_correlations ();                           \
+    template void BasicDecryptEngine <Alphabet>::print_deciphered_caesars (unsigned int);         \
+    template void BasicDecryptEngine <Alphabet>::print_decrypted_high_corr ();                    \
+    template void BasicDecryptEngine <Alphabet>::reset ();                                        \
+    template void BasicDecryptEngine <Alphabet>::set_language_model (const LanguageModel*);
+
+FOR_EACH_EXTRA_ALPHABET (INSTANTIATE_CAESAR_ENGINE)
@@ -1,9 +1,1059 @@
+#include "BatchCracker.hpp"
+#include "Coordinator.hpp"
+#include "CrackProtocol.hpp"
+#include "CrackServer.hpp"
 #include "decrypt.hpp"
+#include "KeySegmenter.hpp"
+#include "ModelLibrary.hpp"
+#include "MultiModelScorer.hpp"
+#include "PrefixHistogramIndex.hpp"
 #include "StringAnalysis.hpp"
+#include "SubstitutionSolver.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+// Server woken by SIGINT and SIGTERM while serve mode is running
+static CrackServer* running_server = nullptr;
+
+// Printed with a nonzero exit when the options of a mode cannot be parsed
+const char BATCH_USAGE[] = "Usage: decrypt batch <caesar|vigenere|substitution> <corpus> "
+                           "[--cache <entries>] [--cache-file <path>] [--stats]\n";
+const char SERVE_USAGE[] = "Usage: decrypt serve <socket|-> [--model <path>] "
+                           "[--cache <entries>] [--cache-file <path>] [--stats]\n";
+const char COORDINATE_USAGE[] = "Usage: decrypt coordinate <caesar|vigenere|substitution> "
+                                "<corpus|-|file> [--workers <count>] [--file] "
+                                "[--cache-file <path>]\n";
+const char SEGMENT_USAGE[] = "Usage: decrypt segment <file> [--period <length>] "
+                             "[--window <letters per column>]\n";
+const char FILE_USAGE[] = "Usage: decrypt <caesar|vigenere|substitution> <file> [--stats] "
+                          "[--model <path>] [--models <directory>] "
+                          "[--alphabet <upper|mixed|bytes|printable>] [--keep-layout] "
+                          "[--top <count>] [--sample <margin>]\n";
+
+/*
+ * Largest values accepted for the numeric options; anything larger is a mistake, and would
+ * only make the engines allocate without bound
+ */
+const std::uint64_t MAX_CACHE_ENTRIES = std::uint64_t (1) << 32;
+const std::uint64_t MAX_WORKERS = 1024;
+const std::uint64_t MAX_TOP_KEYS = 1000000;
+const std::uint64_t MAX_WINDOW_LETTERS = std::uint64_t (1) << 24;
+
+// Outcome of parsing an option that several modes share
+enum OptionStatus { OPTION_PARSED, OPTION_INVALID, OPTION_UNKNOWN };
+
+
+/**
+ * @struct FileOptions
+ *
+ * @brief Options given after the file in file mode.
+ *
+ */
+struct FileOptions {
+    bool print_stats = false;
+
+    // Path of a language model file; empty for the built-in English tables
+    std::string model_path;
+
+    // Directory of language models to detect the plaintext language from; empty to skip
+    std::string model_directory;
+
+    // Symbols the Caesar shift rotates: upper, mixed, bytes or printable
+    std::string alphabet = "upper";
+
+    // Write a Vigenere plaintext with the case, spacing and punctuation of the ciphertext
+    bool keep_layout = false;
+
+    // Number of runner-up Vigenere keys to list; 0 for none
+    unsigned int top_keys = 0;
+
+    // Confidence margin at which the key is taken from a prefix of the file; 0 reads it all
+    double sample_margin = 0.0;
+};
+
+
+/**
+ * @struct CacheOptions
+ *
+ * @brief Result cache options of batch and serve mode.
+ *
+ */
+struct CacheOptions {
+    // Results held in memory; 0 for no cache, or DEFAULT_CACHE_ENTRIES if a file is given
+    std::size_t entries = 0;
+
+    // Path of the disk tier; empty to keep results in memory only
+    std::string path;
+};
+
+
+/**
+ * @fn option_value
+ *
+ * @param argc: Number of arguments.
+ * @param argv: The arguments.
+ * @param i: Index of an option that takes a value; moved past the value.
+ * @return The value, or nullptr, after printing the problem to stderr, if there is none.
+ *
+ */
+static const char* option_value (int argc, char** argv, int& i)
+{
+    if (i + 1 >= argc)
+    {
+        std::cerr << "Missing value for " << argv[i] << '\n';
+        return nullptr;
+    }
+    return argv[++i];
+}
+
+/**
+ * @fn parse_count_option
+ *
+ * @param argc: Number of arguments.
+ * @param argv: The arguments.
+ * @param i: Index of the option; moved past its value.
+ * @param min: Smallest value accepted.
+ * @param max: Largest value accepted.
+ * @param value: Receives the value.
+ * @return true if the option's value is a decimal number from min to max and nothing else;
+ *         otherwise the problem is printed to stderr.
+ *
+ */
+static bool parse_count_option (int argc, char** argv, int& i, std::uint64_t min,
+                                std::uint64_t max, std::uint64_t& value)
+{
+    const char* option = argv[i];
+    const char* text = option_value (argc, argv, i);
+    if (text == nullptr)
+        return false;
+
+    // strtoull would take leading spaces and signs, so the first character must be a digit
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long number = std::isdigit ((unsigned char)text[0])
+                                ? std::strtoull (text, &end, 10) : 0;
+    if ((end == nullptr) || (*end != '\0') || (errno == ERANGE) || (number < min) ||
+        (number > max))
+    {
+        std::cerr << "Invalid value " << text << " for " << option << "; expected " << min
+                  << " to " << max << '\n';
+        return false;
+    }
+
+    value = number;
+    return true;
+}
+
+/**
+ * @fn parse_fraction_option
+ *
+ * @param argc: Number of arguments.
+ * @param argv: The arguments.
+ * @param i: Index of the option; moved past its value.
+ * @param value: Receives the value.
+ * @return true if the option's value is a number from 0 to 1 and nothing else; otherwise the
+ *         problem is printed to stderr.
+ *
+ */
+static bool parse_fraction_option (int argc, char** argv, int& i, double& value)
+{
+    const char* option = argv[i];
+    const char* text = option_value (argc, argv, i);
+    if (text == nullptr)
+        return false;
+
+    // Written so that NaN fails the range check too
+    char* end = nullptr;
+    double number = std::strtod (text, &end);
+    if ((end == text) || (*end != '\0') || !((number >= 0.0) && (number <= 1.0)))
+    {
+        std::cerr << "Invalid value " << text << " for " << option << "; expected 0 to 1\n";
+        return false;
+    }
+
+    value = number;
+    return true;
+}
+
+/**
+ * @fn parse_cache_option
+ *
+ * @param argc: Number of arguments.
+ * @param argv: The arguments.
+ * @param i: Index of the option; moved past its value when it is a cache option.
+ * @param options: Receives the option.
+ * @return OPTION_PARSED if argv[i] was a cache option with a valid value, OPTION_INVALID if it
+ *         was one without (the problem is printed to stderr), OPTION_UNKNOWN otherwise.
+ *
+ */
+static OptionStatus parse_cache_option (int argc, char** argv, int& i, CacheOptions& options)
+{
+    std::string option (argv[i]);
+    if (option == "--cache")
+    {
+        std::uint64_t entries = 0;
+        if (!parse_count_option (argc, argv, i, 0, MAX_CACHE_ENTRIES, entries))
+            return OPTION_INVALID;
+        options.entries = (std::size_t)entries;
+    }
+    else if (option == "--cache-file")
+    {
+        const char* path = option_value (argc, argv, i);
+        if (path == nullptr)
+            return OPTION_INVALID;
+        options.path = path;
+    }
+    else
+        return OPTION_UNKNOWN;
+    return OPTION_PARSED;
+}
+
+/**
+ * @fn open_cache
+ *
+ * @param options: The cache options given.
+ * @param cache: Receives the cache, or stays empty when none was asked for.
+ * @return false if the disk tier could not be opened.
+ *
+ */
+static bool open_cache (const CacheOptions& options, std::unique_ptr <ResultCache>& cache)
+{
+    if ((options.entries == 0) && options.path.empty())
+        return true;
+
+    cache.reset (new ResultCache ((options.entries > 0) ? options.entries
+                                                        : DEFAULT_CACHE_ENTRIES));
+    if (!options.path.empty() && !cache->open_disk (options.path))
+    {
+        std::cerr << "Unable to open cache " << options.path << '\n';
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @fn print_cache_counters
+ *
+ * @param cache: The cache used, or nullptr.
+ *
+ */
+static void print_cache_counters (const ResultCache* cache)
+{
+    if (cache != nullptr)
+        std::cerr << "Cache: " << cache->get_hits() << " hits (" << cache->get_disk_hits()
+                  << " from disk), " << cache->get_misses() << " misses, "
+                  << cache->get_evictions() << " evictions\n";
+}
+
+/**
+ * @fn crack_file
+ *
+ * @param mode: Either "caesar" or "vigenere".
+ * @param path: Path of the file holding the ciphertext.
+ * @param options: Stats and language model options.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks a ciphertext file without loading it into memory; the key (and the detected
+ *        language, when candidate models are given) is printed to stderr and the plaintext is
+ *        streamed to stdout. Per-stage stats are printed to stderr as JSON when asked for.
+ *
+ */
+int crack_file (const std::string& mode, const std::string& path, const FileOptions& options)
+{
+    LanguageModel model;
+    if (!options.model_path.empty() && !model.open (options.model_path))
+    {
+        std::cerr << "Unable to load model " << options.model_path << '\n';
+        return 1;
+    }
+
+    ModelLibrary library;
+    MultiModelScorer languages;
+    if (!options.model_directory.empty())
+    {
+        if (library.load_directory (options.model_directory) == 0)
+        {
+            std::cerr << "No models found in " << options.model_directory << '\n';
+            return 1;
+        }
+        languages.add_library (library);
+    }
+
+    DecryptEngine engine;
+    engine.enable_instrumentation (options.print_stats);
+    engine.set_sample_margin (options.sample_margin);
+    if (model.is_open())
+        engine.set_language_model (&model);
+    if (!engine.open_ciphertext_file (path))
+    {
+        std::cerr << "Unable to open " << path << '\n';
+        return 1;
+    }
+
+    if (mode == "caesar")
+    {
+        engine.process_caesar_file();
+        if (languages.get_model_count() > 0)
+            engine.detect_caesar_language (languages);
+    }
+    else if (mode == "vigenere")
+    {
+        engine.process_vigenere_file();
+        if (languages.get_model_count() > 0)
+            engine.detect_vigenere_language (languages);
+    }
+    else
+    {
+        std::cerr << "Unknown mode " << mode << '\n';
+        return 1;
+    }
+
+    if (options.sample_margin > 0.0)
+        std::cerr << "Sampled: " << engine.get_sampled_length() << '\n';
+    if (!engine.get_language_scores().empty())
+        std::cerr << "Language: " << languages.get_name (engine.get_language_scores()[0].model)
+                  << '\n';
+
+    if (mode == "caesar")
+    {
+        std::cerr << "Key: " << engine.most_likely_key() << '\n';
+        engine.stream_caesar_plaintext (std::cout);
+    }
+    else
+    {
+        std::cerr << "Key: " << engine.get_calculated_key() << '\n';
+        if (options.top_keys > 0)
+        {
+            engine.enumerate_keys (options.top_keys, ENUMERATE_RESCORED_KEYS);
+            for (const KeyCandidate& candidate : engine.get_key_candidates())
+                std::cerr << "Candidate: " << candidate.key << '\t' << candidate.score << '\t'
+                          << candidate.fitness << '\n';
+        }
+        engine.stream_vigenere_plaintext (std::cout, options.keep_layout);
+        if (!options.keep_layout)
+            std::cout << '\n';
+    }
+
+    std::cout.flush();
+    if (options.print_stats)
+        std::cerr << engine.get_stats_json() << '\n';
+    return 0;
+}
+
+/**
+ * @fn crack_substitution_file
+ *
+ * @param path: Path of the file holding the ciphertext.
+ * @param options: Language model and layout options.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks a general substitution ciphertext file on all cores. The key is solved from
+ *        the first SUBSTITUTION_SAMPLE_LETTERS letters of the file, then the whole file is
+ *        streamed through it a chunk at a time, so memory stays bounded however large the file.
+ *        The key is printed to stderr as the cipher letters of plain A-Z.
+ *
+ */
+int crack_substitution_file (const std::string& path, const FileOptions& options)
+{
+    LanguageModel model;
+    if (!options.model_path.empty() && !model.open (options.model_path))
+    {
+        std::cerr << "Unable to load model " << options.model_path << '\n';
+        return 1;
+    }
+
+    MappedFile file;
+    if (!file.open (path))
+    {
+        std::cerr << "Unable to open " << path << '\n';
+        return 1;
+    }
+
+    LetterBuffer chunk;
+    std::vector <std::uint8_t> sample;
+    for (std::size_t offset = 0;
+         (offset < file.get_size()) && (sample.size() < SUBSTITUTION_SAMPLE_LETTERS);
+         offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = std::min (FILE_CHUNK_SIZE, file.get_size() - offset);
+        chunk.normalize (file.get_data() + offset, len);
+        std::size_t taken = std::min (chunk.get_letter_count(),
+                                      SUBSTITUTION_SAMPLE_LETTERS - sample.size());
+        sample.insert (sample.end(), chunk.get_letters(), chunk.get_letters() + taken);
+        file.release (offset, len);
+    }
+
+    ThreadPool pool;
+    SubstitutionSolver solver;
+    solver.set_thread_pool (&pool);
+    if (model.is_open())
+        solver.set_language_model (&model);
+    solver.solve_letters (sample.data(), sample.size());
+    std::cerr << "Key: " << solver.get_key() << '\n';
+
+    std::string plain, restored;
+    for (std::size_t offset = 0; offset < file.get_size(); offset += FILE_CHUNK_SIZE)
+    {
+        std::size_t len = std::min (FILE_CHUNK_SIZE, file.get_size() - offset);
+        chunk.normalize (file.get_data() + offset, len);
+        plain.resize (chunk.get_letter_count());
+        solver.decrypt_letters (chunk.get_letters(), chunk.get_letter_count(), &plain[0]);
+        if (options.keep_layout)
+        {
+            restored.resize (len);
+            chunk.restore (plain.data(), &restored[0]);
+            std::cout << restored;
+        }
+        else
+            std::cout << plain;
+        file.release (offset, len);
+    }
+    if (!options.keep_layout)
+        std::cout << '\n';
+
+    std::cout.flush();
+    return 0;
+}
+
+/**
+ * @fn crack_alphabet_file
+ *
+ * @param path: Path of the file holding the ciphertext.
+ * @param options: Stats option; language models are not used.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks a Caesar ciphertext file whose shift rotates the symbols of Alphabet rather than
+ *        the letters A-Z. The key is printed to stderr as its symbol, when printable, and its
+ *        shift; the plaintext is streamed to stdout.
+ *
+ */
+template <class Alphabet>
+int crack_alphabet_file (const std::string& path, const FileOptions& options)
+{
+    BasicDecryptEngine <Alphabet> engine;
+    engine.enable_instrumentation (options.print_stats);
+    engine.set_sample_margin (options.sample_margin);
+    if (!engine.open_ciphertext_file (path))
+    {
+        std::cerr << "Unable to open " << path << '\n';
+        return 1;
+    }
+
+    engine.process_caesar_file();
+
+    char key = engine.most_likely_key();
+    std::cerr << "Key: ";
+    if (std::isgraph ((unsigned char)key))
+        std::cerr << key;
+    std::cerr << "(" << engine.most_likely_shift() << ")\n";
+    engine.stream_caesar_plaintext (std::cout);
+
+    std::cout.flush();
+    if (options.print_stats)
+        std::cerr << engine.get_stats_json() << '\n';
+    return 0;
+}
+
+/**
+ * @fn segment_file
+ *
+ * @param path: Path of the file holding the capture.
+ * @param period: Length of its keys; 1 for Caesar. Every segment is cracked at this period.
+ * @param column_letters: Letters per column in a window the key is read from; 0 for the default.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks a capture whose key changes partway through. The file is indexed in one pass,
+ *        split where its key changes and every segment cracked on its own; each segment's byte
+ *        range and key are printed to stderr and the whole plaintext streamed to stdout.
+ *
+ */
+int segment_file (const std::string& path, unsigned int period, std::size_t column_letters)
+{
+    MappedFile file;
+    if (!file.open (path, false))
+    {
+        std::cerr << "Unable to open " << path << '\n';
+        return 1;
+    }
+
+    PrefixHistogramIndex index;
+    if (!index.build (file.get_data(), file.get_size(), period))
+    {
+        std::cerr << "Periods above " << PREFIX_INDEX_MAX_PERIOD << " cannot be indexed\n";
+        return 1;
+    }
+
+    KeySegmenter segmenter;
+    if (column_letters > 0)
+        segmenter.set_column_letters (column_letters);
+    segmenter.find_segments (index);
+
+    for (const KeySegment& segment : segmenter.get_segments())
+        std::cerr << "Segment: " << segment.begin << '-' << segment.end << " Key: "
+                  << segment.key << '\n';
+
+    std::ios::sync_with_stdio (false);
+    segmenter.decrypt (std::cout);
+    std::cout.flush();
+    return 0;
+}
+
+/**
+ * @fn crack_batch
+ *
+ * @param mode: "caesar", "vigenere" or "substitution".
+ * @param path: Path of a corpus with one ciphertext per line, or "-" for stdin.
+ * @param cache_options: Result cache to crack repeated lines from.
+ * @param print_stats: Print the stage stats of every engine, merged, to stderr at the end.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks every line of a corpus on all cores; results are written to stdout in input
+ *        order as "<key>\t<plaintext>". The cache counters are printed to stderr when a cache
+ *        is used.
+ *
+ */
+int crack_batch (const std::string& mode, const std::string& path,
+                 const CacheOptions& cache_options, bool print_stats)
+{
+    CipherMode cipher_mode = CAESAR_MODE;
+    if (mode == "vigenere")
+        cipher_mode = VIGENERE_MODE;
+    else if (mode == "substitution")
+        cipher_mode = SUBSTITUTION_MODE;
+    else if (mode != "caesar")
+    {
+        std::cerr << "Unknown mode " << mode << '\n';
+        return 1;
+    }
+
+    std::ifstream corpus;
+    if (path != "-")
+    {
+        corpus.open (path);
+        if (!corpus)
+        {
+            std::cerr << "Unable to open " << path << '\n';
+            return 1;
+        }
+    }
+
+    std::unique_ptr <ResultCache> cache;
+    if (!open_cache (cache_options, cache))
+        return 1;
+
+    std::ios::sync_with_stdio (false);
+    BatchCracker cracker (cipher_mode);
+    cracker.set_result_cache (cache.get());
+    cracker.enable_stats (print_stats);
+    cracker.run ((path == "-") ? std::cin : corpus, std::cout);
+    std::cout.flush();
+
+    print_cache_counters (cache.get());
+    if (print_stats)
+        std::cerr << cracker.get_stats().to_json() << '\n';
+    return 0;
+}
+
+/**
+ * @fn run_coordinator
+ *
+ * @param mode: "caesar", "vigenere" or "substitution".
+ * @param path: Path of a corpus with one ciphertext per line, "-" for stdin, or with whole_file
+ *              set, of one huge Vigenere ciphertext.
+ * @param workers: Number of worker processes; 0 for one per core.
+ * @param whole_file: Crack the file as one ciphertext rather than as a corpus.
+ * @param cache_path: Path of a disk result cache shared by the workers; empty for none.
+ * @return The exit code for the program.
+ *
+ * @brief Cracks a corpus, or one huge Vigenere file, in forked worker processes. Corpus results
+ *        are written to stdout in input order, as in batch mode; a file's key is printed to
+ *        stderr and its plaintext streamed to stdout. Worker restarts and lines given up on are
+ *        reported on stderr.
+ *
+ */
+int run_coordinator (const std::string& mode, const std::string& path, unsigned int workers,
+                     bool whole_file, const std::string& cache_path)
+{
+    CipherMode cipher_mode = CAESAR_MODE;
+    if (mode == "vigenere")
+        cipher_mode = VIGENERE_MODE;
+    else if (mode == "substitution")
+        cipher_mode = SUBSTITUTION_MODE;
+    else if (mode != "caesar")
+    {
+        std::cerr << "Unknown mode " << mode << '\n';
+        return 1;
+    }
+
+    std::ios::sync_with_stdio (false);
+    Coordinator coordinator (cipher_mode, workers);
+    coordinator.set_cache_path (cache_path);
+
+    int status = 0;
+    if (whole_file)
+    {
+        if (cipher_mode != VIGENERE_MODE)
+        {
+            std::cerr << "Only Vigenere files can be split between workers\n";
+            return 1;
+        }
+        if (!coordinator.crack_file (path, std::cout))
+        {
+            std::cerr << "Unable to crack " << path << '\n';
+            return 1;
+        }
+        std::cout << '\n';
+        std::cerr << "Key: " << coordinator.get_key() << '\n';
+    }
+    else
+    {
+        std::ifstream corpus;
+        if (path != "-")
+        {
+            corpus.open (path);
+            if (!corpus)
+            {
+                std::cerr << "Unable to open " << path << '\n';
+                return 1;
+            }
+        }
+        if (!coordinator.run ((path == "-") ? std::cin : corpus, std::cout))
+        {
+            std::cerr << "No workers could be started\n";
+            status = 1;
+        }
+    }
+    std::cout.flush();
+
+    if ((coordinator.get_restarts() > 0) || (coordinator.get_failed_lines() > 0))
+        std::cerr << "Workers: " << coordinator.get_worker_count() << ", "
+                  << coordinator.get_restarts() << " restarts, "
+                  << coordinator.get_failed_lines() << " lines failed\n";
+    return status;
+}
+
+/**
+ * @fn stop_server
+ *
+ * @param signal: The signal received.
+ *
+ * @brief Signal handler that lets a running server finish its open connections and exit.
+ *
+ */
+static void stop_server (int signal)
+{
+    (void)signal;
+    if (running_server != nullptr)
+        running_server->stop();
+}
+
+/**
+ * @fn run_server
+ *
+ * @param path: Path of the Unix domain socket to listen on, or "-" to serve stdin and stdout.
+ * @param model_path: Path of a language model file; empty for the built-in English tables.
+ * @param cache_options: Result cache shared by every request.
+ * @param print_stats: Print the stage stats of every engine, merged, to stderr on exit.
+ * @return The exit code for the program.
+ *
+ * @brief Serves cracking requests (see CrackProtocol.hpp) until SIGINT or SIGTERM, or until
+ *        stdin closes when serving a pipe. The model, the pool and every pool thread's engine
+ *        stay loaded between requests.
+ *
+ */
+int run_server (const std::string& path, const std::string& model_path,
+                const CacheOptions& cache_options, bool print_stats)
+{
+    LanguageModel model;
+    if (!model_path.empty() && !model.open (model_path))
+    {
+        std::cerr << "Unable to load model " << model_path << '\n';
+        return 1;
+    }
+
+    std::unique_ptr <ResultCache> cache;
+    if (!open_cache (cache_options, cache))
+        return 1;
+
+    CrackServer server;
+    if (model.is_open())
+        server.set_language_model (&model);
+    server.set_result_cache (cache.get());
+    server.enable_stats (print_stats);
+    std::signal (SIGPIPE, SIG_IGN);
+
+    if (path == "-")
+    {
+        server.serve (STDIN_FILENO, STDOUT_FILENO);
+        print_cache_counters (cache.get());
+        if (print_stats)
+            std::cerr << server.get_stats().to_json() << '\n';
+        return 0;
+    }
+
+    if (!server.listen (path))
+    {
+        std::cerr << "Unable to listen on " << path << '\n';
+        return 1;
+    }
+
+    running_server = &server;
+    std::signal (SIGINT, stop_server);
+    std::signal (SIGTERM, stop_server);
+    std::cerr << "Listening on " << path << '\n';
+    server.run();
+    running_server = nullptr;
+
+    std::cerr << "Served " << server.get_requests_served() << " requests\n";
+    print_cache_counters (cache.get());
+    if (print_stats)
+        std::cerr << server.get_stats().to_json() << '\n';
+    return 0;
+}
+
+/**
+ * @fn run_client
+ *
+ * @param path: Path of the Unix domain socket a server is listening on.
+ * @param mode: Either "caesar" or "vigenere".
+ * @param corpus_path: Path of a corpus with one ciphertext per line, or "-" for stdin.
+ * @return The exit code for the program.
+ *
+ * @brief Sends every line of a corpus to a server without waiting for answers, and writes the
+ *        results to stdout in input order, in the same format as batch mode.
+ *
+ */
+int run_client (const std::string& path, const std::string& mode, const std::string& corpus_path)
+{
+    std::uint8_t kind = (mode == "vigenere") ? FRAME_VIGENERE : FRAME_CAESAR;
+    if ((mode != "caesar") && (mode != "vigenere"))
+    {
+        std::cerr << "Unknown mode " << mode << '\n';
+        return 1;
+    }
+
+    std::ifstream corpus;
+    if (corpus_path != "-")
+    {
+        corpus.open (corpus_path);
+        if (!corpus)
+        {
+            std::cerr << "Unable to open " << corpus_path << '\n';
+            return 1;
+        }
+    }
+    std::istream& in = (corpus_path == "-") ? std::cin : corpus;
+
+    sockaddr_un address;
+    std::memset (&address, 0, sizeof (address));
+    address.sun_family = AF_UNIX;
+    int fd = ::socket (AF_UNIX, SOCK_STREAM, 0);
+    if ((path.size() >= sizeof (address.sun_path)) || (fd < 0))
+    {
+        std::cerr << "Unable to connect to " << path << '\n';
+        return 1;
+    }
+    std::memcpy (address.sun_path, path.c_str(), path.size());
+    if (::connect (fd, (const sockaddr*)&address, sizeof (address)) != 0)
+    {
+        std::cerr << "Unable to connect to " << path << '\n';
+        ::close (fd);
+        return 1;
+    }
+
+    // Sender: one request per line, numbered in input order
+    std::uint32_t sent = 0;
+    std::thread sender ([&] {
+        std::string line, frame;
+        while (std::getline (in, line))
+        {
+            if (!line.empty() && (line.back() == '\r'))
+                line.pop_back();
+
+            frame.resize (FRAME_HEADER_SIZE);
+            encode_frame_header ({ (std::uint32_t)line.size(), sent, kind },
+                                 (unsigned char*)&frame[0]);
+            frame += line;
+            if (!write_full (fd, frame.data(), frame.size()))
+                break;
+            sent++;
+        }
+        ::shutdown (fd, SHUT_WR);
+    });
+
+    // Receiver: responses arrive as they finish, so early ones wait for those before them
+    std::ios::sync_with_stdio (false);
+    std::map <std::uint32_t, std::string> finished;
+    std::uint32_t next_id = 0;
+    unsigned char header_bytes[FRAME_HEADER_SIZE];
+    int status = 0;
+    while (read_full (fd, header_bytes, FRAME_HEADER_SIZE))
+    {
+        FrameHeader header = decode_frame_header (header_bytes);
+        std::string payload (header.length, '\0');
+        if ((header.length > 0) && !read_full (fd, &payload[0], header.length))
+            break;
+
+        if (header.kind != FRAME_OK)
+        {
+            std::cerr << "Request " << header.id << " failed: " << payload << '\n';
+            payload.clear();
+            status = 1;
+        }
+
+        finished[header.id] = std::move (payload);
+        while (!finished.empty() && (finished.begin()->first == next_id))
+        {
+            std::cout << finished.begin()->second << '\n';
+            finished.erase (finished.begin());
+            next_id++;
+        }
+    }
+
+    sender.join();
+    ::close (fd);
+    std::cout.flush();
+
+    if (next_id != sent)
+    {
+        std::cerr << "Connection closed with " << (sent - next_id) << " requests unanswered\n";
+        return 1;
+    }
+    return status;
+}
 
 
 int main(int argc, char** argv)
 {
+    /*
+     * decrypt batch <caesar|vigenere|substitution> <corpus> [--cache <entries>]
+     *         [--cache-file <path>] [--stats]
+     */
+    if ((argc >= 4) && (std::string (argv[1]) == "batch"))
+    {
+        CacheOptions cache_options;
+        bool print_stats = false;
+        for (int i = 4; i < argc; i++)
+        {
+            OptionStatus status = OPTION_PARSED;
+            if (std::string (argv[i]) == "--stats")
+                print_stats = true;
+            else
+                status = parse_cache_option (argc, argv, i, cache_options);
+
+            if (status != OPTION_PARSED)
+            {
+                if (status == OPTION_UNKNOWN)
+                    std::cerr << "Unknown option " << argv[i] << '\n';
+                std::cerr << BATCH_USAGE;
+                return 1;
+            }
+        }
+        return crack_batch (argv[2], argv[3], cache_options, print_stats);
+    }
+
+    /*
+     * decrypt serve <socket|-> [--model <path>] [--cache <entries>] [--cache-file <path>]
+     *         [--stats]
+     */
+    if ((argc >= 3) && (std::string (argv[1]) == "serve"))
+    {
+        CacheOptions cache_options;
+        std::string model_path;
+        bool print_stats = false;
+        for (int i = 3; i < argc; i++)
+        {
+            OptionStatus status = OPTION_PARSED;
+            if (std::string (argv[i]) == "--model")
+            {
+                const char* path = option_value (argc, argv, i);
+                if (path == nullptr)
+                    status = OPTION_INVALID;
+                else
+                    model_path = path;
+            }
+            else if (std::string (argv[i]) == "--stats")
+                print_stats = true;
+            else
+                status = parse_cache_option (argc, argv, i, cache_options);
+
+            if (status != OPTION_PARSED)
+            {
+                if (status == OPTION_UNKNOWN)
+                    std::cerr << "Unknown option " << argv[i] << '\n';
+                std::cerr << SERVE_USAGE;
+                return 1;
+            }
+        }
+        return run_server (argv[2], model_path, cache_options, print_stats);
+    }
+
+    /*
+     * decrypt coordinate <caesar|vigenere|substitution> <corpus|-|file> [--workers <count>]
+     *         [--file] [--cache-file <path>]
+     */
+    if ((argc >= 4) && (std::string (argv[1]) == "coordinate"))
+    {
+        unsigned int workers = 0;
+        bool whole_file = false;
+        std::string cache_path;
+        for (int i = 4; i < argc; i++)
+        {
+            std::string option (argv[i]);
+            bool valid = true;
+            if (option == "--workers")
+            {
+                std::uint64_t count = 0;
+                valid = parse_count_option (argc, argv, i, 0, MAX_WORKERS, count);
+                workers = (unsigned int)count;
+            }
+            else if (option == "--file")
+                whole_file = true;
+            else if (option == "--cache-file")
+            {
+                const char* path = option_value (argc, argv, i);
+                valid = path != nullptr;
+                if (valid)
+                    cache_path = path;
+            }
+            else
+            {
+                std::cerr << "Unknown option " << option << '\n';
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                std::cerr << COORDINATE_USAGE;
+                return 1;
+            }
+        }
+        return run_coordinator (argv[2], argv[3], workers, whole_file, cache_path);
+    }
+
+    // decrypt segment <file> [--period <length>] [--window <letters per column>]
+    if ((argc >= 3) && (std::string (argv[1]) == "segment"))
+    {
+        unsigned int period = 1;
+        std::size_t column_letters = 0;
+        for (int i = 3; i < argc; i++)
+        {
+            std::string option (argv[i]);
+            std::uint64_t value = 0;
+            bool valid = true;
+            if (option == "--period")
+            {
+                valid = parse_count_option (argc, argv, i, 1, PREFIX_INDEX_MAX_PERIOD, value);
+                period = (unsigned int)value;
+            }
+            else if (option == "--window")
+            {
+                valid = parse_count_option (argc, argv, i, 1, MAX_WINDOW_LETTERS, value);
+                column_letters = (std::size_t)value;
+            }
+            else
+            {
+                std::cerr << "Unknown option " << option << '\n';
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                std::cerr << SEGMENT_USAGE;
+                return 1;
+            }
+        }
+        return segment_file (argv[2], period, column_letters);
+    }
+
+    // decrypt client <socket> <caesar|vigenere> <corpus|->
+    if ((argc == 5) && (std::string (argv[1]) == "client"))
+        return run_client (argv[2], argv[3], argv[4]);
+
+    /*
+     * decrypt <caesar|vigenere|substitution> <file> [--stats] [--model <path>]
+     *         [--models <directory>] [--alphabet <upper|mixed|bytes|printable>] [--keep-layout]
+     *         [--top <count>] [--sample <margin>]
+     */
+    if (argc >= 3)
+    {
+        FileOptions options;
+        for (int i = 3; i < argc; i++)
+        {
+            std::string option (argv[i]);
+            bool valid = true;
+            if (option == "--stats")
+                options.print_stats = true;
+            else if (option == "--keep-layout")
+                options.keep_layout = true;
+            else if (option == "--top")
+            {
+                std::uint64_t count = 0;
+                valid = parse_count_option (argc, argv, i, 0, MAX_TOP_KEYS, count);
+                options.top_keys = (unsigned int)count;
+            }
+            else if (option == "--sample")
+                valid = parse_fraction_option (argc, argv, i, options.sample_margin);
+            else if ((option == "--model") || (option == "--models") || (option == "--alphabet"))
+            {
+                std::string& target = (option == "--model") ? options.model_path
+                                      : (option == "--models") ? options.model_directory
+                                      : options.alphabet;
+                const char* text = option_value (argc, argv, i);
+                valid = text != nullptr;
+                if (valid)
+                    target = text;
+            }
+            else
+            {
+                std::cerr << "Unknown option " << option << '\n';
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                std::cerr << FILE_USAGE;
+                return 1;
+            }
+        }
+
+        if ((options.alphabet == "upper") && (std::string (argv[1]) == "substitution"))
+            return crack_substitution_file (argv[2], options);
+        if (options.alphabet == "upper")
+            return crack_file (argv[1], argv[2], options);
+        if ((std::string (argv[1]) != "caesar") || !options.model_path.empty() ||
+            !options.model_directory.empty())
+        {
+            std::cerr << "Other alphabets are only supported for Caesar ciphers without models\n";
+            return 1;
+        }
+        if (options.alphabet == "mixed")
+            return crack_alphabet_file <MixedLatinAlphabet> (argv[2], options);
+        if (options.alphabet == "bytes")
+            return crack_alphabet_file <ByteAlphabet> (argv[2], options);
+        if (options.alphabet == "printable")
+            return crack_alphabet_file <PrintableAlphabet> (argv[2], options);
+        std::cerr << "Unknown alphabet " << options.alphabet << '\n';
+        return 1;
+    }
+
     //Caesar: "IT STY XYZRGQJ TAJW XTRJYMNSL GJMNSI DTZ"
     DecryptEngine caesar ("IT STY XYZRGQJ TAJW XTRJYMNSL GJMNSI DTZ");
     caesar.process_caesar();
@@ -15,4 +1065,4 @@ int main(int argc, char** argv)
     vigenere.print_vigenere_info();
 
     return 0;
-}
\ No newline at end of file
+}